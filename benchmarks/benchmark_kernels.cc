@@ -0,0 +1,94 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// Micro-benchmarks of the solver kernels on iterate snapshots.
+//
+// Usage: benchmark_kernels [-r repetitions] snapshot.bin [snapshot.bin ...]
+//
+// The snapshots are saved by a solver with 'snapshot(directory, every)' or 'save_snapshot(path)'.
+// Each kernel is run in isolation on a freshly loaded snapshot, and the minimum, median and mean
+// times per call are reported in microseconds.
+
+// STL includes
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Pipal includes
+#include "Pipal.hh"
+
+using Pipal::Integer;
+using Pipal::Kernel;
+using Real = double;
+
+static std::vector<std::pair<Kernel, char const *>> const KERNELS{
+  {Kernel::NEWTON_MATRIX,        "evalNewtonMatrix"},
+  {Kernel::NEWTON_STEP,          "evalNewtonStep"},
+  {Kernel::MODELS,               "evalModels"},
+  {Kernel::FRACTION_TO_BOUNDARY, "fractionToBoundary"},
+  {Kernel::KKT_ERRORS,           "evalKKTErrors"},
+  {Kernel::SLACKS,               "evalSlacks"}
+};
+
+int main(int argc, char ** argv)
+{
+  // Parse command line
+  Integer repetitions{1000};
+  std::vector<std::string> paths;
+  for (int k{1}; k < argc; ++k) {
+    std::string const arg{argv[k]};
+    if (arg == "-r" && k+1 < argc) {repetitions = std::max(1, std::atoi(argv[++k]));}
+    else {paths.push_back(arg);}
+  }
+  if (paths.empty()) {
+    std::cerr << "Usage: " << argv[0] << " [-r repetitions] snapshot.bin [snapshot.bin ...]\n";
+    return EXIT_FAILURE;
+  }
+
+  // Run the kernels on each snapshot
+  std::vector<double> times(repetitions);
+  for (std::string const & path : paths) {
+    std::cout << path << '\n';
+    for (auto const & [kernel, name] : KERNELS) {
+      Pipal::Solver<Real> solver;
+      if (!solver.load_snapshot(path)) {
+        std::cerr << "Error: unable to load snapshot '" << path << "'\n";
+        return EXIT_FAILURE;
+      }
+
+      // Factorize the Newton matrix before the Newton step, and warm up caches
+      if (kernel != Kernel::NEWTON_MATRIX) {solver.run_kernel(Kernel::NEWTON_MATRIX);}
+      solver.run_kernel(kernel);
+
+      // Time the kernel
+      for (Integer r{0}; r < repetitions; ++r) {
+        std::chrono::steady_clock::time_point const t_start{std::chrono::steady_clock::now()};
+        solver.run_kernel(kernel);
+        std::chrono::duration<double, std::micro> const t_run{std::chrono::steady_clock::now() - t_start};
+        times[r] = t_run.count();
+      }
+      std::sort(times.begin(), times.end());
+      double mean{0.0};
+      for (double const t : times) {mean += t;}
+      mean /= repetitions;
+      std::cout
+        << "  " << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(3)
+        << "  min " << std::setw(12) << times.front()
+        << "  median " << std::setw(12) << times[repetitions/2]
+        << "  mean " << std::setw(12) << mean << " us\n";
+    }
+  }
+  return EXIT_SUCCESS;
+}
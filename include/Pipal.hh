@@ -16,11 +16,20 @@
 // Pipal includes
 #include "Pipal/Types.hxx"
 #include "Pipal/Output.hxx"
+#include "Pipal/Metrics.hxx"
+#include "Pipal/Parallel.hxx"
+#include "Pipal/Serialization.hxx"
+#include "Pipal/Cache.hxx"
+#include "Pipal/LDLT.hxx"
 #include "Pipal/Problem.hxx"
 #include "Pipal/Solver.hxx"
 #include "Pipal/Acceptance.hxx"
 #include "Pipal/Direction.hxx"
 #include "Pipal/Input.hxx"
 #include "Pipal/Iterate.hxx"
+#include "Pipal/Polish.hxx"
+#include "Pipal/Separation.hxx"
+#include "Pipal/Snapshot.hxx"
+#include "Pipal/Continuation.hxx"
 
 #endif // INCLUDE_PIPAL_HH
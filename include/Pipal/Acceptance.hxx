@@ -23,8 +23,8 @@ namespace Pipal {
    * the iterate is restored to the accepted trial point; otherwise the steplength is reduced until
    * the Armijo condition or the fraction-to-boundary constraint prevents further reductions.
    */
-  template <typename Real>
-  void Solver<Real>::backtracking()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::backtracking()
   {
     static constexpr Real EPS{std::numeric_limits<Real>::epsilon()};
 
@@ -96,8 +96,8 @@ namespace Pipal {
    * (initial primal fraction), \p a.p (primal steplength) and \p a.d (dual steplength).
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::fractionToBoundary()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::fractionToBoundary()
   {
     static constexpr Real INF{std::numeric_limits<Real>::infinity()};
 
@@ -161,8 +161,8 @@ namespace Pipal {
    * \tparam Real Floating-point type used by the algorithm.
    * \return 1 if a full step was accepted, 0 otherwise.
    */
-  template <typename Real>
-  Integer Solver<Real>::fullStepCheck()
+  template <typename Real, typename ProblemT>
+  Integer Solver<Real, ProblemT>::fullStepCheck()
   {
     // Create alias for easier access
     Parameter<Real>  & p{this->m_parameter};
@@ -249,8 +249,8 @@ namespace Pipal {
    * chosen step.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::lineSearch()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::lineSearch()
   {
     // Create alias for easier access
     Acceptance<Real> & a{this->m_acceptance};
@@ -280,8 +280,8 @@ namespace Pipal {
    * \tparam Real Floating-point type used by the algorithm.
    * \return 0 if SOC not accepted, 1 if first acceptance criterion met, 2 if SOC accepted.
    */
-  template <typename Real>
-  Integer Solver<Real>::secondOrderCorrection()
+  template <typename Real, typename ProblemT>
+  Integer Solver<Real, ProblemT>::secondOrderCorrection()
   {
     // Create alias for easier access
     Parameter<Real>  & p{this->m_parameter};
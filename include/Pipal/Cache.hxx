@@ -0,0 +1,287 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_CACHE_HXX
+#define INCLUDE_PIPAL_CACHE_HXX
+
+// STL
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Pipal
+{
+
+  /**
+   * \brief Solution of a problem instance, used as cached result and as warm start.
+   * \tparam Real The real number type.
+   */
+  template<typename Real>
+  struct WarmStart
+  {
+    Vector<Real> x;   /*!< Primal variables (original space). */
+    Vector<Real> l;   /*!< Constraint multipliers (original space). */
+    Array<Real>  lE;  /*!< Equality constraint multipliers (internal scaling). */
+    Array<Real>  lI;  /*!< Inequality constraint multipliers (internal scaling). */
+    Real         rho; /*!< Penalty parameter. */
+    Real         mu;  /*!< Interior-point parameter. */
+  }; // struct WarmStart
+
+  /**
+   * \brief Cache of the solutions of parametric problem instances.
+   *
+   * Each solution is stored with a key made of the problem parameters and bounds. Exact hits are
+   * found through a hash of the key, while near misses are answered by the nearest cached key in
+   * the Euclidean norm, found through a KD-tree. The tree is rebuilt lazily after insertions, and the
+   * oldest solutions are evicted once the capacity is reached. All the keys must have the same size,
+   * inserting a key of different size clears the cache. The cache is thread-safe, so that it can be
+   * shared by several solvers.
+   * \tparam Real The real number type.
+   */
+  template<typename Real>
+  class SolutionCache
+  {
+    /**
+     * \brief Cached solution with its key.
+     */
+    struct Entry
+    {
+      Vector<Real>    key;   /*!< Parameters and bounds. */
+      std::uint64_t   hash;  /*!< Hash of the key. */
+      WarmStart<Real> value; /*!< Cached solution. */
+    };
+
+    Integer                                         m_capacity;     /*!< Maximum number of entries. */
+    Real                                            m_radius;       /*!< Maximum distance for near misses. */
+    std::vector<Entry>                              m_entries;      /*!< Cached entries (ring buffer). */
+    Integer                                         m_next{0};      /*!< Next entry to be replaced. */
+    std::unordered_multimap<std::uint64_t, Integer> m_index;        /*!< Hash index of the entries. */
+    std::vector<Integer>                            m_tree;         /*!< KD-tree (entries permutation). */
+    std::vector<Integer>                            m_dim;          /*!< KD-tree split dimensions. */
+    bool                                            m_dirty{false}; /*!< KD-tree rebuild flag. */
+    mutable std::mutex                              m_mutex;        /*!< Cache mutex. */
+
+    /**
+     * \brief Build the KD-tree on a range of the entries permutation.
+     *
+     * The median of the range is the node, split along the dimension of largest spread.
+     * \param[in] lo First index of the range.
+     * \param[in] hi Past-the-last index of the range.
+     */
+    void build(Integer const lo, Integer const hi)
+    {
+      if (hi - lo <= 0) {return;}
+      Integer const n{static_cast<Integer>(this->m_entries.front().key.size())};
+      Integer dim{0};
+      Real spread{-1.0};
+      for (Integer d{0}; d < n; ++d) {
+        Real lo_d{std::numeric_limits<Real>::infinity()}, hi_d{-std::numeric_limits<Real>::infinity()};
+        for (Integer k{lo}; k < hi; ++k) {
+          Real const v{this->m_entries[this->m_tree[k]].key(d)};
+          lo_d = std::min(lo_d, v); hi_d = std::max(hi_d, v);
+        }
+        if (hi_d - lo_d > spread) {spread = hi_d - lo_d; dim = d;}
+      }
+      Integer const mid{(lo + hi)/2};
+      std::nth_element(this->m_tree.begin() + lo, this->m_tree.begin() + mid, this->m_tree.begin() + hi,
+        [this, dim] (Integer const a, Integer const b) {
+          return this->m_entries[a].key(dim) < this->m_entries[b].key(dim);
+        });
+      this->m_dim[mid] = dim;
+      this->build(lo, mid);
+      this->build(mid + 1, hi);
+    }
+
+    /**
+     * \brief Search the nearest entry in a range of the KD-tree.
+     * \param[in] key Query key.
+     * \param[in] lo First index of the range.
+     * \param[in] hi Past-the-last index of the range.
+     * \param[in,out] best Index of the nearest entry found so far.
+     * \param[in,out] best_dist Squared distance of the nearest entry found so far.
+     */
+    void search(Vector<Real> const & key, Integer const lo, Integer const hi, Integer & best,
+      Real & best_dist) const
+    {
+      if (hi - lo <= 0) {return;}
+      Integer const mid{(lo + hi)/2}, entry{this->m_tree[mid]}, dim{this->m_dim[mid]};
+      Real const dist{(this->m_entries[entry].key - key).squaredNorm()};
+      if (dist < best_dist) {best_dist = dist; best = entry;}
+      Real const diff{key(dim) - this->m_entries[entry].key(dim)};
+      if (diff < 0.0) {
+        this->search(key, lo, mid, best, best_dist);
+        if (diff*diff < best_dist) {this->search(key, mid + 1, hi, best, best_dist);}
+      } else {
+        this->search(key, mid + 1, hi, best, best_dist);
+        if (diff*diff < best_dist) {this->search(key, lo, mid, best, best_dist);}
+      }
+    }
+
+  public:
+    /**
+     * \brief SolutionCache constructor.
+     * \param[in] t_capacity Maximum number of cached solutions.
+     * \param[in] t_radius Maximum distance between keys for a near miss (unbounded by default).
+     */
+    explicit SolutionCache(Integer const t_capacity = 256,
+      Real const t_radius = std::numeric_limits<Real>::infinity())
+      : m_capacity(t_capacity), m_radius(t_radius)
+    {
+      PIPAL_ASSERT(t_capacity > 0,
+        "Pipal::SolutionCache::SolutionCache(...): capacity must be positive");
+      PIPAL_ASSERT(t_radius >= 0.0,
+        "Pipal::SolutionCache::SolutionCache(...): radius must be non-negative");
+    }
+
+    /**
+     * \brief Build a cache key from the problem parameters and bounds.
+     *
+     * Infinite bounds are mapped to large finite values, so that distances between keys are finite.
+     * \param[in] parameters Problem parameters.
+     * \param[in] bounds Bounds on the primal variables and on the constraints.
+     * \return The cache key.
+     */
+    static Vector<Real> key(Vector<Real> const & parameters, std::initializer_list<Vector<Real> const *> bounds)
+    {
+      Eigen::Index size{parameters.size()};
+      for (Vector<Real> const * b : bounds) {size += b->size();}
+      Vector<Real> out(size);
+      out.head(parameters.size()) = parameters;
+      Eigen::Index offset{parameters.size()};
+      for (Vector<Real> const * b : bounds) {out.segment(offset, b->size()) = *b; offset += b->size();}
+      Real const big{std::sqrt(std::numeric_limits<Real>::max())/Real(4.0)};
+      return out.cwiseMax(-big).cwiseMin(big);
+    }
+
+    /**
+     * \brief Get the number of cached solutions.
+     * \return The number of cached solutions.
+     */
+    Integer size() const
+    {
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+      return static_cast<Integer>(this->m_entries.size());
+    }
+
+    /**
+     * \brief Remove all the cached solutions.
+     */
+    void clear()
+    {
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+      this->m_entries.clear();
+      this->m_index.clear();
+      this->m_tree.clear();
+      this->m_dim.clear();
+      this->m_next = 0;
+      this->m_dirty = false;
+    }
+
+    /**
+     * \brief Find the solution cached with the same key.
+     * \param[in] key Query key.
+     * \param[out] out Cached solution.
+     * \return True if the key is cached, false otherwise.
+     */
+    bool find(Vector<Real> const & key, WarmStart<Real> & out) const
+    {
+      Fnv1a hash;
+      hash.update(key);
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+      auto const range{this->m_index.equal_range(hash.value())};
+      for (auto it{range.first}; it != range.second; ++it) {
+        Entry const & entry{this->m_entries[it->second]};
+        if (entry.key.size() == key.size() && entry.key == key) {out = entry.value; return true;}
+      }
+      return false;
+    }
+
+    /**
+     * \brief Find the solution cached with the nearest key.
+     * \param[in] key Query key.
+     * \param[out] out Cached solution.
+     * \param[out] distance Distance between the query key and the cached one.
+     * \return True if a solution within the radius is found, false otherwise.
+     */
+    bool nearest(Vector<Real> const & key, WarmStart<Real> & out, Real & distance)
+    {
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+      if (this->m_entries.empty() || this->m_entries.front().key.size() != key.size()) {return false;}
+
+      // Rebuild KD-tree if needed
+      Integer const n{static_cast<Integer>(this->m_entries.size())};
+      if (this->m_dirty) {
+        this->m_tree.resize(n);
+        this->m_dim.assign(n, 0);
+        for (Integer k{0}; k < n; ++k) {this->m_tree[k] = k;}
+        this->build(0, n);
+        this->m_dirty = false;
+      }
+
+      // Search nearest key
+      Integer best{-1};
+      Real best_dist{std::numeric_limits<Real>::infinity()};
+      this->search(key, 0, n, best, best_dist);
+      distance = std::sqrt(best_dist);
+      if (best < 0 || distance > this->m_radius) {return false;}
+      out = this->m_entries[best].value;
+      return true;
+    }
+
+    /**
+     * \brief Insert a solution in the cache (the oldest one is evicted if the cache is full).
+     * \param[in] key Key of the solution.
+     * \param[in] value Solution.
+     */
+    void insert(Vector<Real> const & key, WarmStart<Real> const & value)
+    {
+      Fnv1a hash;
+      hash.update(key);
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+
+      // Clear the cache if the key size changes
+      if (!this->m_entries.empty() && this->m_entries.front().key.size() != key.size()) {
+        this->m_entries.clear();
+        this->m_index.clear();
+        this->m_next = 0;
+      }
+
+      // Replace the solution of an identical key
+      auto const range{this->m_index.equal_range(hash.value())};
+      for (auto it{range.first}; it != range.second; ++it) {
+        if (this->m_entries[it->second].key == key) {this->m_entries[it->second].value = value; return;}
+      }
+
+      // Append or replace the oldest entry
+      Integer slot{static_cast<Integer>(this->m_entries.size())};
+      if (slot < this->m_capacity) {
+        this->m_entries.push_back(Entry{key, hash.value(), value});
+      } else {
+        slot = this->m_next;
+        this->m_next = (this->m_next + 1) % this->m_capacity;
+        Entry & entry{this->m_entries[slot]};
+        auto const old{this->m_index.equal_range(entry.hash)};
+        for (auto it{old.first}; it != old.second; ++it) {
+          if (it->second == slot) {this->m_index.erase(it); break;}
+        }
+        entry = Entry{key, hash.value(), value};
+      }
+      this->m_index.emplace(hash.value(), slot);
+      this->m_dirty = true;
+    }
+
+  }; // class SolutionCache
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_CACHE_HXX
@@ -0,0 +1,286 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_CONTINUATION_HXX
+#define INCLUDE_PIPAL_CONTINUATION_HXX
+
+namespace Pipal
+{
+
+  /**
+   * \brief Evaluate the tangent of the solution path with respect to a problem perturbation.
+   *
+   * The Newton matrix is factorized at the last iterate, and the Newton right-hand side is evaluated
+   * at the same point before and after the perturbation of the problem functions. The derivative of
+   * the primal-dual point is the solution of \f$ K \dot{\mathbf{z}} = -(\mathbf{b}_h - \mathbf{b}_0)/h
+   * \f$, i.e., the first-order change of the solution for a unit change of the perturbed parameter.
+   * Changes of the bounds are not accounted for. The problem is left perturbed.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] perturb Function perturbing the problem by \p h (it returns false on failure).
+   * \param[in] h Size of the perturbation (non-zero).
+   * \param[out] dz Tangent of the primal variables (original space) and of the multipliers (internal
+   * scaling).
+   * \return True if the tangent was evaluated successfully, false otherwise.
+   */
+  template <typename Real, typename ProblemT>
+  bool Solver<Real, ProblemT>::tangent(std::function<bool()> const & perturb, Real const h, WarmStart<Real> & dz)
+  {
+    #define CMD "Pipal::Solver::tangent(...): "
+
+    // Create alias for easier access
+    Input<Real>   & i{this->m_input};
+    Iterate<Real> & z{this->m_iterate};
+
+    PIPAL_ASSERT(h != 0.0, CMD "perturbation size must be non-zero");
+    if (this->m_cache_hit || i.nV == 0 || z.x.size() != i.nV) {return false;}
+
+    // Factorize the Newton matrix and evaluate the residual at the last iterate
+    if (!this->m_bfgs) {
+      this->evalHessian();
+      if (z.err > 0) {return false;}
+    }
+    this->evalNewtonMatrix();
+    if (z.ldlt.info() != Eigen::Success) {return false;}
+    this->evalNewtonRhs();
+    Vector<Real> const b0(z.b);
+
+    // Evaluate the residual of the perturbed problem at the same point
+    if (!perturb()) {return false;}
+    this->evalFunctions();
+    if (z.err > 0) {return false;}
+    this->evalGradients();
+    if (z.err > 0) {return false;}
+    this->evalNewtonRhs();
+
+    // Solve for the tangent of the primal-dual point
+    Vector<Real> dir;
+    this->evalNewtonSolve((b0 - z.b)/h, dir);
+
+    // Map the primal tangent to the original space (the map is affine)
+    Vector<Real> const x(z.x);
+    Vector<Real> x0, x1;
+    this->evalXOriginal(x0);
+    z.x += dir.head(i.nV);
+    this->evalXOriginal(x1);
+    z.x = x;
+    dz.x   = x1 - x0;
+    dz.l.resize(0);
+    dz.lE  = dir.segment(i.nV+2*i.nE+2*i.nI, i.nE).array();
+    dz.lI  = dir.segment(i.nV+3*i.nE+2*i.nI, i.nI).array();
+    dz.rho = 0.0;
+    dz.mu  = 0.0;
+    return dz.x.allFinite() && dz.lE.allFinite() && dz.lI.allFinite();
+
+    #undef CMD
+  }
+
+  /**
+   * \brief Continuation driver for families of problems along a parameter path.
+   *
+   * The driver moves a scalar problem parameter from \f$ t_0 \f$ to \f$ t_1 \f$. Each step is warm
+   * started from the previous solution, moved along the tangent of the solution path (see
+   * Solver::tangent) if the predictor is enabled. The step size grows when a step takes fewer solver
+   * iterations than the target and shrinks when it takes more, while failed steps are halved and
+   * retried from the last solution.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \tparam ProblemT Problem type of the solver.
+   */
+  template <typename Real, typename ProblemT = Problem<Real>>
+  class Continuation
+  {
+  public:
+    using Update   = std::function<bool(Real)>;                        /*!< Problem parameter setter. */
+    using Callback = std::function<void(Real, Vector<Real> const &)>; /*!< Solution callback. */
+
+  private:
+    Solver<Real, ProblemT> & m_solver;    /*!< Solver of the problem. */
+    Update  m_update;                      /*!< Problem parameter setter. */
+    Real    m_step{0.1};                   /*!< Initial step (fraction of the path). */
+    Real    m_step_min{1.0e-4};            /*!< Minimum step (fraction of the path). */
+    Real    m_step_max{0.5};               /*!< Maximum step (fraction of the path). */
+    Integer m_target{8};                   /*!< Target number of solver iterations per step. */
+    bool    m_predictor{true};             /*!< Tangent predictor flag. */
+    Integer m_steps{0};                    /*!< Number of accepted steps. */
+    Integer m_rejected{0};                 /*!< Number of rejected steps. */
+    Integer m_iterations{0};               /*!< Total number of solver iterations. */
+
+    /**
+     * \brief Evaluate the tangent of the solution path at the current parameter.
+     * \param[in] t Current parameter.
+     * \param[in] span Length of the path (signed).
+     * \param[out] dz Tangent of the solution path.
+     * \return True if the tangent was evaluated successfully, false otherwise.
+     */
+    bool evalTangent(Real const t, Real const span, WarmStart<Real> & dz)
+    {
+      Real const h{std::sqrt(std::numeric_limits<Real>::epsilon())*std::max(std::abs(t), std::abs(span))*
+        (span > 0.0 ? 1.0 : -1.0)};
+      return this->m_solver.tangent([this, t, h] () {return this->m_update(t + h);}, h, dz);
+    }
+
+  public:
+    /**
+     * \brief Continuation constructor.
+     * \param[in] t_solver Solver of the problem (its problem is updated through \p t_update).
+     * \param[in] t_update Function setting the problem parameter (it returns false on failure).
+     */
+    Continuation(Solver<Real, ProblemT> & t_solver, Update t_update)
+      : m_solver(t_solver), m_update(std::move(t_update))
+    {
+      PIPAL_ASSERT(this->m_update,
+        "Pipal::Continuation::Continuation(...): parameter setter must be set");
+    }
+
+    /**
+     * \brief Set the step sizes (as fractions of the path length).
+     * \param[in] t_init Initial step.
+     * \param[in] t_min Minimum step (the continuation fails below it).
+     * \param[in] t_max Maximum step.
+     */
+    void step(Real const t_init, Real const t_min, Real const t_max)
+    {
+      PIPAL_ASSERT(0.0 < t_min && t_min <= t_init && t_init <= t_max && t_max <= 1.0,
+        "Pipal::Continuation::step(...): steps must satisfy 0 < min <= init <= max <= 1");
+      this->m_step = t_init; this->m_step_min = t_min; this->m_step_max = t_max;
+    }
+
+    /**
+     * \brief Get the target number of solver iterations per step.
+     * \return The target number of solver iterations per step.
+     */
+    Integer target() const {return this->m_target;}
+
+    /**
+     * \brief Set the target number of solver iterations per step.
+     * \param[in] t_target The target number of solver iterations per step.
+     */
+    void target(Integer const t_target)
+    {
+      PIPAL_ASSERT(t_target > 0,
+        "Pipal::Continuation::target(...): input value must be positive");
+      this->m_target = t_target;
+    }
+
+    /**
+     * \brief Get the tangent predictor flag.
+     * \return The tangent predictor flag.
+     */
+    bool predictor() const {return this->m_predictor;}
+
+    /**
+     * \brief Enable or disable the tangent predictor (disabled, the previous solution is used as is).
+     * \param[in] t_predictor The tangent predictor flag.
+     */
+    void predictor(bool const t_predictor) {this->m_predictor = t_predictor;}
+
+    /**
+     * \brief Get the number of accepted steps of the last run.
+     * \return The number of accepted steps.
+     */
+    Integer steps() const {return this->m_steps;}
+
+    /**
+     * \brief Get the number of rejected steps of the last run.
+     * \return The number of rejected steps.
+     */
+    Integer rejected() const {return this->m_rejected;}
+
+    /**
+     * \brief Get the total number of solver iterations of the last run.
+     * \return The total number of solver iterations.
+     */
+    Integer iterations() const {return this->m_iterations;}
+
+    /**
+     * \brief Follow the solution path from \p t0 to \p t1.
+     * \param[in] t0 Initial parameter.
+     * \param[in] t1 Final parameter.
+     * \param[in] x_guess Initial guess of the problem at \p t0.
+     * \param[out] x_sol Solution at the last accepted parameter.
+     * \param[in] callback Function called on the solution of each accepted parameter (optional).
+     * \return True if the path was followed up to \p t1, false otherwise.
+     */
+    bool run(Real const t0, Real const t1, Vector<Real> const & x_guess, Vector<Real> & x_sol,
+      Callback const & callback = nullptr)
+    {
+      #define CMD "Pipal::Continuation::run(...): "
+
+      // Solve the initial problem
+      this->m_steps = this->m_rejected = this->m_iterations = 0;
+      PIPAL_ASSERT(this->m_update(t0), CMD "error in setting the problem parameter");
+      bool const ok{this->m_solver.optimize(x_guess, x_sol) && this->m_solver.converged()};
+      this->m_iterations += this->m_solver.counter().k;
+      if (!ok) {return false;}
+      if (callback) {callback(t0, x_sol);}
+
+      // Follow the path
+      Real const span{t1 - t0}, margin{std::sqrt(std::numeric_limits<Real>::epsilon())};
+      Real t{t0}, dt{this->m_step*span};
+      WarmStart<Real> last{this->m_solver.warm_start()}, dz;
+      bool tangent{this->m_predictor && t != t1 && this->evalTangent(t, span, dz)};
+      Vector<Real> x;
+      while (t != t1)
+      {
+        // Do not overshoot nor leave a tiny remainder
+        bool const reach{std::abs(dt) >= std::abs(t1 - t) ||
+          std::abs(t1 - t - dt) <= this->m_step_min*std::abs(span)};
+        if (reach) {dt = t1 - t;}
+
+        // Predict the solution
+        WarmStart<Real> guess(last);
+        if (tangent) {
+          guess.x  += dt*dz.x;
+          guess.lE  = (last.lE + dt*dz.lE).cwiseMax(margin - 1.0).cwiseMin(1.0 - margin);
+          guess.lI  = (last.lI + dt*dz.lI).cwiseMax(margin).cwiseMin(1.0 - margin);
+        }
+
+        // Correct the solution
+        Real const t_next{reach ? t1 : t + dt};
+        PIPAL_ASSERT(this->m_update(t_next), CMD "error in setting the problem parameter");
+        this->m_solver.warm_start(guess);
+        bool const solved{this->m_solver.optimize(guess.x, x) && this->m_solver.converged()};
+        Integer const k{this->m_solver.counter().k};
+        this->m_iterations += k;
+
+        // Reject the step
+        if (!solved) {
+          ++this->m_rejected;
+          dt /= 2.0;
+          if (std::abs(dt) < this->m_step_min*std::abs(span)) {
+            this->m_update(t);
+            return false;
+          }
+          continue;
+        }
+
+        // Accept the step
+        ++this->m_steps;
+        t = t_next;
+        x_sol = x;
+        if (callback) {callback(t, x_sol);}
+        last = this->m_solver.warm_start();
+        tangent = this->m_predictor && t != t1 && this->evalTangent(t, span, dz);
+
+        // Adapt the step to the number of iterations
+        Real const factor{std::min(Real(2.0), std::max(Real(0.5), Real(this->m_target)/std::max<Integer>(k, 1)))};
+        dt = std::min(std::abs(dt)*factor, this->m_step_max*std::abs(span))*(span > 0.0 ? 1.0 : -1.0);
+      }
+      return true;
+
+      #undef CMD
+    }
+
+  }; // class Continuation
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_CONTINUATION_HXX
@@ -0,0 +1,731 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_DAEMON_HXX
+#define INCLUDE_PIPAL_DAEMON_HXX
+
+// STL
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <map>
+
+// POSIX
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Pipal
+{
+
+  static constexpr std::uint64_t DAEMON_MAGIC{0x4e4d444c41504950ull}; /*!< Daemon message tag ("PIPALDMN"). */
+  static constexpr std::size_t   DAEMON_NAME_SIZE{64};                 /*!< Size of the names in messages. */
+  static constexpr int           DAEMON_POLL_MS{100};                  /*!< Polling period for the stop flag. */
+
+  /**
+   * \brief Status of a request served by the solver daemon.
+   */
+  using DaemonStatus = enum class DaemonStatus : std::int32_t {
+    SUCCESS = 0, FAILURE = 1, BAD_REQUEST = -1, UNKNOWN_MODEL = -2, BAD_PAYLOAD = -3, SOLVER_ERROR = -4
+  };
+
+  /**
+   * \brief Solve request sent by a client to the solver daemon.
+   *
+   * The numerical data are exchanged through a POSIX shared-memory segment owned by the client,
+   * which holds, in order, the problem data (\f$ n_P \f$), the lower and upper bounds on the primal
+   * variables (\f$ n_V \f$ each), the lower and upper bounds on the constraints (\f$ n_C \f$ each),
+   * the primal variables (\f$ n_V \f$, initial guess on input and solution on output) and the
+   * constraint multipliers (\f$ n_C \f$, output only).
+   */
+  struct DaemonRequest
+  {
+    std::uint64_t magic{DAEMON_MAGIC};   /*!< Message tag. */
+    char          model[DAEMON_NAME_SIZE]{}; /*!< Name of the registered model. */
+    char          shm[DAEMON_NAME_SIZE]{};   /*!< Name of the shared-memory segment. */
+    std::uint64_t nP{0};                 /*!< Number of problem data. */
+    std::uint64_t nV{0};                 /*!< Number of primal variables. */
+    std::uint64_t nC{0};                 /*!< Number of constraints. */
+  };
+
+  /**
+   * \brief Reply sent by the solver daemon to a solve request.
+   */
+  struct DaemonReply
+  {
+    std::uint64_t magic{DAEMON_MAGIC};           /*!< Message tag. */
+    DaemonStatus  status{DaemonStatus::SUCCESS}; /*!< Request status. */
+    std::int32_t  iterations{0};                 /*!< Number of solver iterations. */
+    double        time{0.0};                     /*!< Solve wall time (in seconds). */
+  };
+
+  /**
+   * \brief Size of the shared-memory payload of a solve request.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] nP Number of problem data.
+   * \param[in] nV Number of primal variables.
+   * \param[in] nC Number of constraints.
+   * \param[out] size The payload size in bytes.
+   * \return True if the sizes are representable, false if a count exceeds the range of \c Integer
+   * or the payload size overflows.
+   */
+  template <typename Real>
+  static bool daemon_payload_size(std::uint64_t const nP, std::uint64_t const nV, std::uint64_t const nC,
+    std::size_t & size)
+  {
+    std::uint64_t const count_max{static_cast<std::uint64_t>(std::numeric_limits<Integer>::max())};
+    if (nP > count_max || nV > count_max || nC > count_max) {return false;}
+    std::uint64_t const count{nP + 3*nV + 3*nC};
+    if (count > std::numeric_limits<std::size_t>::max()/sizeof(Real)) {return false;}
+    size = static_cast<std::size_t>(count)*sizeof(Real);
+    return true;
+  }
+
+  /**
+   * \brief Send a whole buffer on a socket.
+   * \param[in] fd Socket file descriptor.
+   * \param[in] data Pointer to the data.
+   * \param[in] size Size of the data in bytes.
+   * \return True if the buffer was sent, false otherwise.
+   */
+  static bool daemon_send(int const fd, void const * data, std::size_t size)
+  {
+    char const * ptr{static_cast<char const *>(data)};
+    while (size > 0) {
+      ssize_t const n{::send(fd, ptr, size, MSG_NOSIGNAL)};
+      if (n < 0 && errno == EINTR) {continue;}
+      if (n <= 0) {return false;}
+      ptr += n; size -= static_cast<std::size_t>(n);
+    }
+    return true;
+  }
+
+  /**
+   * \brief Receive a whole buffer from a socket.
+   * \param[in] fd Socket file descriptor.
+   * \param[out] data Pointer to the data.
+   * \param[in] size Size of the data in bytes.
+   * \return True if the buffer was received, false otherwise (also on peer shutdown).
+   */
+  static bool daemon_recv(int const fd, void * data, std::size_t size)
+  {
+    char * ptr{static_cast<char *>(data)};
+    while (size > 0) {
+      ssize_t const n{::recv(fd, ptr, size, 0)};
+      if (n < 0 && errno == EINTR) {continue;}
+      if (n <= 0) {return false;}
+      ptr += n; size -= static_cast<std::size_t>(n);
+    }
+    return true;
+  }
+
+  /**
+   * \brief Read a whole buffer from a file at a given offset.
+   * \param[in] fd File descriptor.
+   * \param[out] data Pointer to the data.
+   * \param[in] size Size of the data in bytes.
+   * \param[in] offset Offset in the file in bytes.
+   * \return True if the buffer was read, false otherwise (also if the file is too short).
+   */
+  static bool daemon_pread(int const fd, void * data, std::size_t size, off_t offset)
+  {
+    char * ptr{static_cast<char *>(data)};
+    while (size > 0) {
+      ssize_t const n{::pread(fd, ptr, size, offset)};
+      if (n < 0 && errno == EINTR) {continue;}
+      if (n <= 0) {return false;}
+      ptr += n; size -= static_cast<std::size_t>(n); offset += n;
+    }
+    return true;
+  }
+
+  /**
+   * \brief Write a whole buffer to a file at a given offset.
+   * \param[in] fd File descriptor.
+   * \param[in] data Pointer to the data.
+   * \param[in] size Size of the data in bytes.
+   * \param[in] offset Offset in the file in bytes.
+   * \return True if the buffer was written, false otherwise.
+   */
+  static bool daemon_pwrite(int const fd, void const * data, std::size_t size, off_t offset)
+  {
+    char const * ptr{static_cast<char const *>(data)};
+    while (size > 0) {
+      ssize_t const n{::pwrite(fd, ptr, size, offset)};
+      if (n < 0 && errno == EINTR) {continue;}
+      if (n <= 0) {return false;}
+      ptr += n; size -= static_cast<std::size_t>(n); offset += n;
+    }
+    return true;
+  }
+
+  /**
+   * \brief Parametric optimization problem served by the solver daemon.
+   *
+   * The structure of the problem (number of variables and constraints, sparsity patterns) is fixed
+   * by the derived class, while the data and the bounds are set by each solve request. Derived
+   * classes implement the objective, constraints and derivatives in terms of data().
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real>
+  class DaemonProblem : public Problem<Real>
+  {
+    Vector<Real> m_data; /*!< Problem data. */
+    Vector<Real> m_bl;   /*!< Lower bounds on the primal variables. */
+    Vector<Real> m_bu;   /*!< Upper bounds on the primal variables. */
+    Vector<Real> m_cl;   /*!< Lower bounds on the constraints. */
+    Vector<Real> m_cu;   /*!< Upper bounds on the constraints. */
+
+  public:
+    using Problem<Real>::Problem;
+
+    /**
+     * \brief Get the problem data.
+     * \return The problem data.
+     */
+    Vector<Real> const & data() const {return this->m_data;}
+
+    /**
+     * \brief Set the problem data.
+     * \param[in] t_data The problem data.
+     * \return True if the data are valid, false otherwise.
+     */
+    bool data(Vector<Real> const & t_data) {this->m_data = t_data; return this->update();}
+
+    /**
+     * \brief Update the problem after a change of the data.
+     *
+     * Derived classes may override this method to validate the data or to precompute quantities
+     * depending on them.
+     * \return True if the data are valid, false otherwise.
+     */
+    virtual bool update() {return true;}
+
+    /**
+     * \brief Set the bounds on the primal variables and on the constraints.
+     * \param[in] t_bl Lower bounds on the primal variables.
+     * \param[in] t_bu Upper bounds on the primal variables.
+     * \param[in] t_cl Lower bounds on the constraints.
+     * \param[in] t_cu Upper bounds on the constraints.
+     */
+    void bounds(Vector<Real> const & t_bl, Vector<Real> const & t_bu, Vector<Real> const & t_cl,
+      Vector<Real> const & t_cu)
+    {
+      this->m_bl = t_bl; this->m_bu = t_bu; this->m_cl = t_cl; this->m_cu = t_cu;
+    }
+
+    /**
+     * \brief Get the number of problem data (fixed by the problem structure).
+     * \return The number of problem data.
+     */
+    virtual Integer data_size() const = 0;
+
+    /**
+     * \brief Get the number of primal variables (fixed by the problem structure).
+     * \return The number of primal variables.
+     */
+    virtual Integer primal_size() const = 0;
+
+    /**
+     * \brief Get the number of constraints (fixed by the problem structure).
+     * \return The number of constraints.
+     */
+    virtual Integer constraints_size() const = 0;
+
+    bool parameters(Vector<Real> & out) const override {out = this->m_data; return true;}
+    bool primal_lower_bounds(Vector<Real> & out) const override {out = this->m_bl; return true;}
+    bool primal_upper_bounds(Vector<Real> & out) const override {out = this->m_bu; return true;}
+    bool constraints_lower_bounds(Vector<Real> & out) const override {out = this->m_cl; return true;}
+    bool constraints_upper_bounds(Vector<Real> & out) const override {out = this->m_cu; return true;}
+
+  }; // class DaemonProblem
+
+  /**
+   * \brief Local solver daemon serving solve requests over a Unix domain socket.
+   *
+   * The daemon keeps a pool of solvers for each registered model. The solvers are constructed once
+   * and reused across requests, so that the problem classification buffers, the Newton matrix
+   * pattern and its symbolic analysis are kept between solves of the same model structure. Requests
+   * carry only fixed-size headers on the socket, while the numerical data are exchanged through a
+   * shared-memory segment owned by the client (see DaemonRequest). Each connection is served by a
+   * dedicated thread, and a request waits until a solver of its model is available.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real>
+  class Daemon
+  {
+  public:
+    using ProblemPtr = std::unique_ptr<DaemonProblem<Real>>;
+    using Factory    = std::function<ProblemPtr()>;
+    using Configure  = std::function<void(Solver<Real> &)>;
+
+  private:
+    /**
+     * \brief Pooled solver with its (owned) problem.
+     */
+    struct Slot
+    {
+      DaemonProblem<Real> *         problem{nullptr}; /*!< Problem owned by the solver. */
+      std::unique_ptr<Solver<Real>> solver;           /*!< Solver instance. */
+    };
+
+    /**
+     * \brief Registered model with its pool of solvers.
+     */
+    struct Model
+    {
+      std::vector<std::unique_ptr<Slot>> slots; /*!< Pooled solvers. */
+      std::vector<Slot *>                free;  /*!< Available solvers. */
+      Integer                            nP{0}; /*!< Number of problem data. */
+      Integer                            nV{0}; /*!< Number of primal variables. */
+      Integer                            nC{0}; /*!< Number of constraints. */
+      std::mutex                         mutex; /*!< Pool mutex. */
+      std::condition_variable            cv;    /*!< Solver availability condition. */
+    };
+
+    std::string                                   m_path;          /*!< Socket path. */
+    int                                           m_socket{-1};    /*!< Listening socket. */
+    std::map<std::string, std::unique_ptr<Model>> m_models;        /*!< Registered models. */
+    std::thread                                   m_listener;      /*!< Connections listener thread. */
+    std::atomic<bool>                             m_stop{true};    /*!< Stop flag. */
+    std::mutex                                    m_mutex;         /*!< Connections counter mutex. */
+    std::condition_variable                       m_cv;            /*!< Connections completion condition. */
+    Integer                                       m_connections{0}; /*!< Number of open connections. */
+
+    /**
+     * \brief Accept connections until the daemon is stopped.
+     */
+    void listen()
+    {
+      while (!this->m_stop) {
+        pollfd pfd{this->m_socket, POLLIN, 0};
+        if (::poll(&pfd, 1, DAEMON_POLL_MS) <= 0) {continue;}
+        int const fd{::accept(this->m_socket, nullptr, nullptr)};
+        if (fd < 0) {continue;}
+        {
+          std::lock_guard<std::mutex> lock(this->m_mutex);
+          ++this->m_connections;
+        }
+        std::thread(&Daemon::serve, this, fd).detach();
+      }
+    }
+
+    /**
+     * \brief Serve the requests of a connection until it is closed or the daemon is stopped.
+     * \param[in] fd Connection socket.
+     */
+    void serve(int const fd)
+    {
+      while (!this->m_stop) {
+        pollfd pfd{fd, POLLIN, 0};
+        int const ready{::poll(&pfd, 1, DAEMON_POLL_MS)};
+        if (ready == 0 || (ready < 0 && errno == EINTR)) {continue;}
+        DaemonRequest request;
+        if (ready < 0 || !daemon_recv(fd, &request, sizeof(request))) {break;}
+        DaemonReply const reply{this->handle(request)};
+        if (!daemon_send(fd, &reply, sizeof(reply))) {break;}
+      }
+      ::close(fd);
+      std::lock_guard<std::mutex> lock(this->m_mutex);
+      --this->m_connections;
+      this->m_cv.notify_all();
+    }
+
+    /**
+     * \brief Serve a solve request.
+     * \param[in] request Solve request.
+     * \return The reply to the request.
+     */
+    DaemonReply handle(DaemonRequest const & request)
+    {
+      DaemonReply reply;
+
+      // Check request header
+      if (request.magic != DAEMON_MAGIC || request.model[DAEMON_NAME_SIZE-1] != '\0' ||
+          request.shm[DAEMON_NAME_SIZE-1] != '\0') {
+        reply.status = DaemonStatus::BAD_REQUEST;
+        return reply;
+      }
+      auto const it{this->m_models.find(request.model)};
+      if (it == this->m_models.end()) {reply.status = DaemonStatus::UNKNOWN_MODEL; return reply;}
+      Model & model{*it->second};
+
+      // Check the sizes against the model structure before reading the payload
+      std::size_t size{0};
+      if (!daemon_payload_size<Real>(request.nP, request.nV, request.nC, size) ||
+          request.nP != static_cast<std::uint64_t>(model.nP) || request.nV != static_cast<std::uint64_t>(model.nV) ||
+          request.nC != static_cast<std::uint64_t>(model.nC)) {
+        reply.status = DaemonStatus::BAD_REQUEST;
+        return reply;
+      }
+
+      // Copy the inputs out of the shared-memory payload (the client may resize it at any time, so
+      // that it is never mapped by the daemon, and a short read is reported as a bad payload)
+      Integer const nP{model.nP}, nV{model.nV}, nC{model.nC};
+      std::size_t const nR{sizeof(Real)};
+      int const shm_fd{::shm_open(request.shm, O_RDWR, 0)};
+      if (shm_fd < 0) {reply.status = DaemonStatus::BAD_PAYLOAD; return reply;}
+      Vector<Real> input(nP+3*nV+2*nC);
+      if (size == 0 || !daemon_pread(shm_fd, input.data(), input.size()*nR, 0)) {
+        ::close(shm_fd);
+        reply.status = DaemonStatus::BAD_PAYLOAD;
+        return reply;
+      }
+
+      // Split the inputs
+      Real const * ptr{input.data()};
+      Eigen::Map<Vector<Real> const> data(ptr, nP);    ptr += nP;
+      Eigen::Map<Vector<Real> const> bl(ptr, nV);      ptr += nV;
+      Eigen::Map<Vector<Real> const> bu(ptr, nV);      ptr += nV;
+      Eigen::Map<Vector<Real> const> cl(ptr, nC);      ptr += nC;
+      Eigen::Map<Vector<Real> const> cu(ptr, nC);      ptr += nC;
+      Eigen::Map<Vector<Real> const> x_guess(ptr, nV);
+      Vector<Real> output(Vector<Real>::Zero(nV+nC));
+
+      // Acquire a solver
+      Slot * slot{nullptr};
+      {
+        std::unique_lock<std::mutex> lock(model.mutex);
+        model.cv.wait(lock, [&model] () {return !model.free.empty();});
+        slot = model.free.back();
+        model.free.pop_back();
+      }
+
+      // Solve the problem
+      std::chrono::steady_clock::time_point const t_start{std::chrono::steady_clock::now()};
+      PIPAL_TRY {
+        if (slot->problem->data(data)) {
+          slot->problem->bounds(bl, bu, cl, cu);
+          Vector<Real> x_sol, l_sol;
+          bool const success{slot->solver->optimize(x_guess, x_sol)};
+          slot->solver->getSolution(x_sol, l_sol);
+          Integer const nL{std::min(nC, static_cast<Integer>(l_sol.size()))};
+          output.head(nV) = x_sol;
+          output.segment(nV, nL) = l_sol.head(nL);
+          reply.status = success ? DaemonStatus::SUCCESS : DaemonStatus::FAILURE;
+          reply.iterations = static_cast<std::int32_t>(slot->solver->counter().k);
+        } else {
+          reply.status = DaemonStatus::BAD_PAYLOAD;
+        }
+      } PIPAL_CATCH_ALL {
+        reply.status = DaemonStatus::SOLVER_ERROR;
+      }
+      std::chrono::duration<double> const t_solve{std::chrono::steady_clock::now() - t_start};
+      reply.time = t_solve.count();
+
+      // Release the solver, and copy the outputs to the payload
+      {
+        std::lock_guard<std::mutex> lock(model.mutex);
+        model.free.push_back(slot);
+      }
+      model.cv.notify_one();
+      if (reply.status == DaemonStatus::SUCCESS || reply.status == DaemonStatus::FAILURE) {
+        if (!daemon_pwrite(shm_fd, output.data(), output.size()*nR, static_cast<off_t>((nP+2*nV+2*nC)*nR))) {
+          reply.status = DaemonStatus::BAD_PAYLOAD;
+        }
+      }
+      ::close(shm_fd);
+      return reply;
+    }
+
+  public:
+    /**
+     * \brief Daemon constructor.
+     * \param[in] t_path Path of the Unix domain socket.
+     */
+    explicit Daemon(std::string const & t_path) : m_path(t_path)
+    {
+      PIPAL_ASSERT(!t_path.empty() && t_path.size() < sizeof(sockaddr_un::sun_path),
+        "Pipal::Daemon::Daemon(...): invalid socket path '" << t_path << "'");
+    }
+
+    /**
+     * \brief Deleted copy constructor.
+     */
+    Daemon(Daemon const &) = delete;
+
+    /**
+     * \brief Deleted assignment operator.
+     */
+    Daemon & operator=(Daemon const &) = delete;
+
+    /**
+     * \brief Daemon destructor (stops the daemon if running).
+     */
+    ~Daemon() {this->stop();}
+
+    /**
+     * \brief Get the socket path.
+     * \return The socket path.
+     */
+    std::string const & path() const {return this->m_path;}
+
+    /**
+     * \brief Check if the daemon is running.
+     * \return True if the daemon is running, false otherwise.
+     */
+    bool running() const {return !this->m_stop;}
+
+    /**
+     * \brief Register a model with a pool of solvers.
+     *
+     * The problems created by the factory must share the same structure, only their data and bounds
+     * are set by the solve requests. Requests whose sizes differ from data_size(), primal_size() and
+     * constraints_size() are rejected before their payload is read.
+     * \param[in] name Name of the model.
+     * \param[in] factory Factory creating the problems of the model.
+     * \param[in] pool_size Number of solvers of the model (i.e., of concurrent solves).
+     * \param[in] configure Function setting the solver options (optional).
+     */
+    void add_model(std::string const & name, Factory const & factory, Integer const pool_size = 1,
+      Configure const & configure = nullptr)
+    {
+      #define CMD "Pipal::Daemon::add_model(...): "
+
+      PIPAL_ASSERT(this->m_stop, CMD "models must be registered before starting the daemon");
+      PIPAL_ASSERT(!name.empty() && name.size() < DAEMON_NAME_SIZE, CMD "invalid model name '" << name << "'");
+      PIPAL_ASSERT(this->m_models.count(name) == 0, CMD "model '" << name << "' already registered");
+      PIPAL_ASSERT(pool_size > 0, CMD "pool size must be positive");
+
+      std::unique_ptr<Model> model{std::make_unique<Model>()};
+      for (Integer k{0}; k < pool_size; ++k) {
+        std::unique_ptr<Slot> slot{std::make_unique<Slot>()};
+        ProblemPtr problem{factory()};
+        PIPAL_ASSERT(problem.get() != nullptr, CMD "factory returned a null problem");
+        if (k == 0) {
+          model->nP = problem->data_size();
+          model->nV = problem->primal_size();
+          model->nC = problem->constraints_size();
+        }
+        PIPAL_ASSERT(model->nP >= 0 && model->nV >= 0 && model->nC >= 0 && problem->data_size() == model->nP &&
+          problem->primal_size() == model->nV && problem->constraints_size() == model->nC,
+          CMD "problems of model '" << name << "' differ in structure");
+        slot->problem = problem.get();
+        slot->solver = std::make_unique<Solver<Real>>(std::unique_ptr<Problem<Real>>(problem.release()));
+        if (configure) {configure(*slot->solver);}
+        model->free.push_back(slot.get());
+        model->slots.push_back(std::move(slot));
+      }
+      this->m_models.emplace(name, std::move(model));
+
+      #undef CMD
+    }
+
+    /**
+     * \brief Bind the socket and start serving requests.
+     */
+    void start()
+    {
+      #define CMD "Pipal::Daemon::start(...): "
+
+      PIPAL_ASSERT(this->m_stop, CMD "daemon already running");
+
+      // Bind and listen on the socket
+      sockaddr_un address{};
+      address.sun_family = AF_UNIX;
+      std::strncpy(address.sun_path, this->m_path.c_str(), sizeof(address.sun_path)-1);
+      this->m_socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      PIPAL_ASSERT(this->m_socket >= 0, CMD "cannot create socket (" << std::strerror(errno) << ")");
+      ::unlink(this->m_path.c_str());
+      if (::bind(this->m_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+          ::listen(this->m_socket, SOMAXCONN) != 0) {
+        int const error{errno};
+        ::close(this->m_socket);
+        this->m_socket = -1;
+        PIPAL_ERROR(CMD "cannot listen on '" << this->m_path << "' (" << std::strerror(error) << ")");
+      }
+
+      // Start listener thread
+      this->m_stop = false;
+      this->m_listener = std::thread(&Daemon::listen, this);
+
+      #undef CMD
+    }
+
+    /**
+     * \brief Stop serving requests, wait for the open connections and remove the socket.
+     */
+    void stop()
+    {
+      if (this->m_stop.exchange(true)) {return;}
+      if (this->m_listener.joinable()) {this->m_listener.join();}
+      {
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        this->m_cv.wait(lock, [this] () {return this->m_connections == 0;});
+      }
+      ::close(this->m_socket);
+      ::unlink(this->m_path.c_str());
+      this->m_socket = -1;
+    }
+
+  }; // class Daemon
+
+  /**
+   * \brief Client of the local solver daemon.
+   *
+   * The client owns a connection to the daemon and a shared-memory segment for the payloads, which
+   * is grown as needed and removed on destruction. A client must not be shared between threads.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real>
+  class DaemonClient
+  {
+    int         m_socket{-1};       /*!< Connection socket. */
+    std::string m_shm;              /*!< Shared-memory segment name. */
+    int         m_shm_fd{-1};       /*!< Shared-memory segment file descriptor. */
+    void *      m_payload{nullptr}; /*!< Mapped payload. */
+    std::size_t m_size{0};          /*!< Mapped payload size. */
+
+    /**
+     * \brief Grow the shared-memory payload to the given size.
+     * \param[in] size Payload size in bytes.
+     */
+    void reserve(std::size_t const size)
+    {
+      #define CMD "Pipal::DaemonClient::reserve(...): "
+
+      if (size <= this->m_size) {return;}
+      if (this->m_payload != nullptr) {::munmap(this->m_payload, this->m_size); this->m_payload = nullptr;}
+      this->m_size = 0;
+      PIPAL_ASSERT(::ftruncate(this->m_shm_fd, static_cast<off_t>(size)) == 0,
+        CMD "cannot resize shared memory (" << std::strerror(errno) << ")");
+      void * payload{::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, this->m_shm_fd, 0)};
+      PIPAL_ASSERT(payload != MAP_FAILED, CMD "cannot map shared memory (" << std::strerror(errno) << ")");
+      this->m_payload = payload;
+      this->m_size = size;
+
+      #undef CMD
+    }
+
+  public:
+    /**
+     * \brief Client constructor (connects to the daemon).
+     * \param[in] path Path of the daemon Unix domain socket.
+     */
+    explicit DaemonClient(std::string const & path)
+    {
+      #define CMD "Pipal::DaemonClient::DaemonClient(...): "
+
+      PIPAL_ASSERT(!path.empty() && path.size() < sizeof(sockaddr_un::sun_path),
+        CMD "invalid socket path '" << path << "'");
+
+      // Connect to the daemon
+      sockaddr_un address{};
+      address.sun_family = AF_UNIX;
+      std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+      this->m_socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      PIPAL_ASSERT(this->m_socket >= 0, CMD "cannot create socket (" << std::strerror(errno) << ")");
+      if (::connect(this->m_socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        int const error{errno};
+        ::close(this->m_socket);
+        PIPAL_ERROR(CMD "cannot connect to '" << path << "' (" << std::strerror(error) << ")");
+      }
+
+      // Create shared-memory segment
+      static std::atomic<unsigned> counter{0};
+      this->m_shm = "/pipal_" + std::to_string(::getpid()) + "_" + std::to_string(counter++);
+      this->m_shm_fd = ::shm_open(this->m_shm.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+      if (this->m_shm_fd < 0) {
+        int const error{errno};
+        ::close(this->m_socket);
+        PIPAL_ERROR(CMD "cannot create shared memory '" << this->m_shm << "' (" << std::strerror(error) << ")");
+      }
+
+      #undef CMD
+    }
+
+    /**
+     * \brief Deleted copy constructor.
+     */
+    DaemonClient(DaemonClient const &) = delete;
+
+    /**
+     * \brief Deleted assignment operator.
+     */
+    DaemonClient & operator=(DaemonClient const &) = delete;
+
+    /**
+     * \brief Client destructor (closes the connection and removes the shared memory).
+     */
+    ~DaemonClient()
+    {
+      if (this->m_payload != nullptr) {::munmap(this->m_payload, this->m_size);}
+      ::close(this->m_shm_fd);
+      ::shm_unlink(this->m_shm.c_str());
+      ::close(this->m_socket);
+    }
+
+    /**
+     * \brief Solve a problem of a registered model.
+     * \param[in] model Name of the model.
+     * \param[in] data Problem data.
+     * \param[in] bl Lower bounds on the primal variables.
+     * \param[in] bu Upper bounds on the primal variables.
+     * \param[in] cl Lower bounds on the constraints.
+     * \param[in] cu Upper bounds on the constraints.
+     * \param[in] x_guess Initial guess for the primal variables (warm start).
+     * \param[out] x_sol Primal solution.
+     * \param[out] l_sol Constraint multipliers.
+     * \return The reply of the daemon.
+     */
+    DaemonReply solve(std::string const & model, Vector<Real> const & data, Vector<Real> const & bl,
+      Vector<Real> const & bu, Vector<Real> const & cl, Vector<Real> const & cu,
+      Vector<Real> const & x_guess, Vector<Real> & x_sol, Vector<Real> & l_sol)
+    {
+      #define CMD "Pipal::DaemonClient::solve(...): "
+
+      // Check input
+      Integer const nP{static_cast<Integer>(data.size())}, nV{static_cast<Integer>(x_guess.size())},
+        nC{static_cast<Integer>(cl.size())};
+      PIPAL_ASSERT(!model.empty() && model.size() < DAEMON_NAME_SIZE, CMD "invalid model name '" << model << "'");
+      PIPAL_ASSERT(bl.size() == nV && bu.size() == nV && cu.size() == nC,
+        CMD "inconsistent bounds sizes");
+
+      // Write payload
+      DaemonRequest request;
+      std::strncpy(request.model, model.c_str(), DAEMON_NAME_SIZE-1);
+      std::strncpy(request.shm, this->m_shm.c_str(), DAEMON_NAME_SIZE-1);
+      request.nP = nP; request.nV = nV; request.nC = nC;
+      std::size_t size{0};
+      PIPAL_ASSERT(daemon_payload_size<Real>(request.nP, request.nV, request.nC, size), CMD "payload too large");
+      this->reserve(size);
+      Real * ptr{static_cast<Real *>(this->m_payload)};
+      for (Vector<Real> const * v : {&data, &bl, &bu, &cl, &cu, &x_guess}) {
+        std::copy(v->data(), v->data() + v->size(), ptr);
+        ptr += v->size();
+      }
+
+      // Send request and wait for reply
+      DaemonReply reply;
+      PIPAL_ASSERT(daemon_send(this->m_socket, &request, sizeof(request)) &&
+        daemon_recv(this->m_socket, &reply, sizeof(reply)) && reply.magic == DAEMON_MAGIC,
+        CMD "connection to the daemon lost");
+
+      // Read solution (primal variables precede the multipliers, at the end of the payload)
+      if (reply.status == DaemonStatus::SUCCESS || reply.status == DaemonStatus::FAILURE) {
+        x_sol = Eigen::Map<Vector<Real>>(ptr - nV, nV);
+        l_sol = Eigen::Map<Vector<Real>>(ptr, nC);
+      }
+      return reply;
+
+      #undef CMD
+    }
+
+  }; // class DaemonClient
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_DAEMON_HXX
@@ -20,8 +20,8 @@ namespace Pipal {
    * \tparam Real Floating-point type used by the algorithm.
    * \param[in] d Direction object to reset.
    */
-  template<typename Real>
-  void Solver<Real>::resetDirection(Direction<Real> & d) const
+  template<typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::resetDirection(Direction<Real> & d) const
   {
     // Create alias for easier access
     Input<Real> const & i{this->m_input};
@@ -49,8 +49,8 @@ namespace Pipal {
    * \param[in] a2 Scalar multiplier for the second direction.
    * \param[in] a3 Scalar multiplier for the third direction.
    */
-  template<typename Real>
-  void Solver<Real>::evalLinearCombination(Direction<Real> const & d1, Direction<Real> const & d2,
+  template<typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalLinearCombination(Direction<Real> const & d1, Direction<Real> const & d2,
     Direction<Real> const & d3, Real const a1, Real const a2, Real const a3)
   {
     // Create alias for easier access
@@ -81,8 +81,8 @@ namespace Pipal {
    * \brief Evaluate model reductions and quality metric for a direction.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template<typename Real>
-  void Solver<Real>::evalModels()
+  template<typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalModels()
   {
     // Create alias for easier access
     Input<Real>     & i{this->m_input};
@@ -105,29 +105,34 @@ namespace Pipal {
     {
       // Evaluate reduction in linear model of merit function for zero penalty parameter
       d.ltred0 = 0;
+      Vector<Real> JEd, JId;
       if (i.nE > 0) {
+        this->evalJacobianProduct(z.JE, z.JEr, d.x, JEd);
         Array<Real> sqrt_term((z.cE.square() + z.mu*z.mu).sqrt());
         d.ltred0 -= 0.5*(((1.0 - z.mu/z.r1) * (-1.0 + z.cE/sqrt_term) + (1.0 - z.mu/z.r2) *
-          (1.0 + z.cE/sqrt_term)) * (z.JE * d.x).array()).sum();
+          (1.0 + z.cE/sqrt_term)) * JEd.array()).sum();
       }
       if (i.nI > 0) {
+        this->evalJacobianProduct(z.JI, z.JIr, d.x, JId);
         Array<Real> sqrt_term((z.cI.square() + 4.0*z.mu*z.mu).sqrt());
         d.ltred0 -= 0.5*((((-z.mu)/z.s1) * (-1.0 + z.cI/sqrt_term) + (1.0 - z.mu/z.s2) *
-          (1.0 + z.cI/sqrt_term)) * (z.JI * d.x).array()).sum();
+          (1.0 + z.cI/sqrt_term)) * JId.array()).sum();
       }
 
       // Evaluate reduction in linear model of merit function
       d.ltred = -z.rho*z.g.transpose()*d.x + d.ltred0;
 
       // Evaluate reduction in quadratic model of merit function
-      d.qtred = d.ltred - 0.5*d.x.transpose()*z.H*d.x;
+      Vector<Real> Hd;
+      this->evalTransposeProduct(z.H, d.x, Hd);
+      d.qtred = d.ltred - 0.5*d.x.dot(Hd);
       if (i.nE > 0) {
-        Array<Real> Jd(z.JE*d.x);
+        Array<Real> Jd(JEd.array());
         Array<Real> Dinv((z.r1/(1.0+z.lE) + z.r2/(1.0-z.lE)).matrix());
         d.qtred -= 0.5*Jd.matrix().transpose() * ((Jd/Dinv).matrix());
       }
       if (i.nI > 0) {
-        Array<Real> Jd(z.JI*d.x);
+        Array<Real> Jd(JId.array());
         Array<Real> Dinv((z.s1/(0.0+z.lI) + z.s2/(1.0-z.lI)).matrix());
         d.qtred -= 0.5*Jd.matrix().transpose() * ((Jd/Dinv).matrix());
       }
@@ -140,8 +145,9 @@ namespace Pipal {
       vec.head(i.nV) = z.rho*z.g;
 
       // Set gradient of Lagrangian for constraints
-      if (i.nE > 0) {vec.head(i.nV) += ((z.lE+d.lE).matrix().transpose()*z.JE).transpose().array();}
-      if (i.nI > 0) {vec.head(i.nV) += ((z.lI+d.lI).matrix().transpose()*z.JI).transpose().array();}
+      Vector<Real> Jl;
+      if (i.nE > 0) {this->evalTransposeProduct(z.JE, (z.lE+d.lE).matrix(), Jl); vec.head(i.nV) += Jl.array();}
+      if (i.nI > 0) {this->evalTransposeProduct(z.JI, (z.lI+d.lI).matrix(), Jl); vec.head(i.nV) += Jl.array();}
 
       // Set complementarity for constraint slacks
       if (i.nE > 0) {
@@ -162,8 +168,8 @@ namespace Pipal {
    * \brief Recover direction components from the Newton system solution.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template<typename Real>
-  void Solver<Real>::evalNewtonStep()
+  template<typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalNewtonStep()
   {
     // Create alias for easier access
     Input<Real>     const & i{this->m_input};
@@ -171,7 +177,8 @@ namespace Pipal {
     Direction<Real>       & d{this->m_direction};
 
     // Evaluate direction
-    Vector<Real> dir(z.ldlt.solve(-z.b));
+    Vector<Real> dir;
+    this->evalNewtonSolve(-z.b, dir);
 
     // Parse direction
     d.x = dir.head(i.nV);
@@ -197,8 +204,8 @@ namespace Pipal {
    * \brief Compute the search direction for the current iterate.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalStep()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalStep()
   {
     // Create alias for easier access
     Parameter<Real> & p{this->m_parameter};
@@ -240,46 +247,87 @@ namespace Pipal {
         [&p] (Real e) {return std::pow(p.mu_factor, e);})
         ).min(p.mu_max).max(p.mu_min));
 
-      // Initialize feasibility direction data
-      Vector<Real> lred0_0_mu(p.mu_trials);
-      lred0_0_mu.setZero();
-
-      // Loop through interior-point parameter values
-      for (Integer j{0}; j < p.mu_trials; ++j)
-      {
-        // Set penalty and interior-point parameters
-        this->setRho(0.0);
-        this->setMu(Mu(j));
-
-        // Evaluate direction
+      // Evaluate a trial step for the current penalty and interior-point parameters
+      auto evalTrial = [this, &z, &d, &d1, &d2, &d3, rho_curr, mu_curr] () {
         this->evalLinearCombination(d1, d2, d3,
           z.rho/rho_curr+z.mu/mu_curr-1.0, 1.0-z.mu/mu_curr, 1.0-z.rho/rho_curr);
-
-        // Cut length
-        d.x *= std::min(d.x_norm_/std::max(d.x_norm, 1.0), 1.0);
-
-        // Run fraction-to-boundary
+        if (z.rho == 0.0) {d.x *= std::min(d.x_norm_/std::max(d.x_norm, 1.0), 1.0);}
         this->fractionToBoundary();
-
-        // Cut length
         this->evalTrialStepCut();
-
-        // Evaluate models
         this->evalModels();
+        ++z.trials;
+      };
 
-        // Set feasibility direction data
+      // Evaluate feasibility direction data (only when needed if the trial grid is pruned)
+      Vector<Real> lred0_0_mu(p.mu_trials);
+      lred0_0_mu.setZero();
+      Mask lred0_done(Mask::Constant(p.mu_trials, false));
+      auto evalFeasibility = [this, &z, &d, &Mu, &lred0_0_mu, &lred0_done, &evalTrial] (Integer const j) {
+        if (lred0_done(j)) {return;}
+        Real const rho{z.rho}, mu{z.mu};
+        this->setRho(0.0);
+        this->setMu(Mu(j));
+        evalTrial();
         lred0_0_mu(j) = d.lred0;
+        lred0_done(j) = true;
+        this->setRho(rho);
+        this->setMu(mu);
+      };
+      z.trials = 0;
+      if (!this->m_pruning) {for (Integer j{0}; j < p.mu_trials; ++j) {evalFeasibility(j);}}
+
+      // Evaluate a trial step and its quality, infinite if the steering conditions are not met
+      auto evalQuality = [this, &p, &z, &d, &Mu, &lred0_0_mu, &evalTrial, &evalFeasibility] (Integer const j,
+        Real & ltred0, Real & qtred) {
+        if (z.v > p.opt_err_tol) {evalFeasibility(j);}
+        this->setMu(Mu(j));
+        evalTrial();
+        ltred0 = d.ltred0;
+        qtred  = d.qtred;
+
+        // Check updating conditions for infeasible points
+        if (z.v > p.opt_err_tol && (ltred0 < p.update_con_1*lred0_0_mu(j) ||
+          qtred < p.update_con_2*lred0_0_mu(j) || z.rho > z.kkt(0)*z.kkt(0))) {
+          return std::numeric_limits<Real>::infinity();
+        }
+
+        // Check updating conditions for feasible points
+        if (z.v <= p.opt_err_tol && qtred < 0.0) {return std::numeric_limits<Real>::infinity();}
+        return d.m;
+      };
+
+      // Set trial order, if the trial grid is pruned start from the last choice (or from the largest
+      // interior-point parameter) and prefer larger interior-point parameters on ties
+      Indices order(Indices::LinSpaced(p.mu_trials, 0, p.mu_trials - 1));
+      if (this->m_pruning) {
+        Integer const j0{z.trial_j >= 0 ? z.trial_j : p.mu_trials - 1};
+        std::sort(order.begin(), order.end(), [j0] (Integer const a, Integer const b) {
+          return std::abs(a - j0) < std::abs(b - j0) || (std::abs(a - j0) == std::abs(b - j0) && a > b);
+        });
       }
 
       // Initialize updating data
       Vector<Real> ltred0_rho_mu(p.mu_trials), qtred_rho_mu(p.mu_trials), m_rho_mu(p.mu_trials);
       ltred0_rho_mu.setZero(); qtred_rho_mu.setZero(); m_rho_mu.setZero();
 
-      // Initialize check
+      // Initialize check and choice
       bool check{false};
+      Integer k_choice{-1}, j_choice{-1};
+
+      // Try the last choice alone if it has been unchanged for a few iterations
+      if (this->m_pruning && z.trial_k >= 0 && z.trial_n >= p.prune_stable) {
+        this->setRho(std::max(p.rho_min, std::pow(p.rho_factor, z.trial_k)*rho_curr));
+        if (rho_curr > z.kkt(0)*z.kkt(0)) {this->setRhoLast(z.rho);}
+        Real ltred0, qtred;
+        if (evalQuality(z.trial_j, ltred0, qtred) < std::numeric_limits<Real>::infinity()) {
+          check = true; k_choice = z.trial_k; j_choice = z.trial_j;
+        } else {
+          this->setRhoLast(rho_curr);
+        }
+      }
 
       // Loop through penalty parameter values
-      for (Integer k{0}; k < p.rho_trials; ++k)
+      for (Integer k{0}; !check && k < p.rho_trials; ++k)
       {
         // Set penalty parameter
         this->setRho(std::max(p.rho_min, std::pow(p.rho_factor, k)*rho_curr) );
@@ -287,44 +335,13 @@ namespace Pipal {
         // Set last penalty parameter
         if (rho_curr > z.kkt(0)*z.kkt(0)) {this->setRhoLast(z.rho );}
 
-        // Loop through interior-point parameter values
-        for (Integer j{0}; j < p.mu_trials; ++j)
+        // Loop through interior-point parameter values (until the first acceptable one if pruned)
+        m_rho_mu.setConstant(std::numeric_limits<Real>::infinity());
+        for (Integer n{0}; n < p.mu_trials; ++n)
         {
-          // Set interior-point parameter
-          this->setMu(Mu(j));
-
-          // Evaluate direction
-          this->evalLinearCombination(
-            d1, d2, d3,
-            z.rho/rho_curr+z.mu/mu_curr-1.0,
-            1.0-z.mu/mu_curr,
-            1.0-z.rho/rho_curr
-          );
-
-          // Run fraction-to-boundary
-          this->fractionToBoundary();
-
-          // Cut steps
-          this->evalTrialStepCut();
-
-          // Evaluate models
-          this->evalModels();
-
-          // Set updating data
-          ltred0_rho_mu(j) = d.ltred0;
-          qtred_rho_mu(j)  = d.qtred;
-          m_rho_mu(j)      = d.m;
-
-          // Check updating conditions for infeasible points
-          if (z.v > p.opt_err_tol && (ltred0_rho_mu(j) < p.update_con_1*lred0_0_mu(j) ||
-            qtred_rho_mu(j) < p.update_con_2*lred0_0_mu(j) || z.rho > z.kkt(0)*z.kkt(0))) {
-            m_rho_mu(j) = std::numeric_limits<Real>::infinity();
-          }
-
-          // Check updating conditions for feasible points
-          if (z.v <= p.opt_err_tol && qtred_rho_mu(j) < 0.0) {
-            m_rho_mu(j) = std::numeric_limits<Real>::infinity();
-          }
+          Integer const j{order(n)};
+          m_rho_mu(j) = evalQuality(j, ltred0_rho_mu(j), qtred_rho_mu(j));
+          if (this->m_pruning && m_rho_mu(j) < std::numeric_limits<Real>::infinity()) {break;}
         }
 
         // Find minimum m for current rho
@@ -337,29 +354,33 @@ namespace Pipal {
           for (Integer j{0}; j < p.mu_trials; ++j)
           {
             // Check condition
-            if (m_rho_mu(j) <= p.update_con_3*m_min) {this->setMu(Mu(j));}
+            if (m_rho_mu(j) <= p.update_con_3*m_min) {this->setMu(Mu(j)); j_choice = j;}
           }
 
-          // Set condition check
+          // Set condition check and choice
           check = true;
-
-          // Break loop
-          break;
+          k_choice = k;
         }
       }
 
       // Check conditions
       if (check == false) {this->setRho(rho_curr); this->setMu(mu_curr);}
 
+      // Update trial statistics and last choice
+      this->m_counter.T += z.trials;
+      if (k_choice == z.trial_k && j_choice == z.trial_j) {++z.trial_n;}
+      else {z.trial_k = k_choice; z.trial_j = j_choice; z.trial_n = 0;}
+
       // Evaluate merit
       this->evalMerit();
     }
 
-    // Evaluate primal-dual right-hand side vector
-    this->evalNewtonRhs();
-
-    // Evaluate search direction
-    this->evalNewtonStep();
+    // Evaluate predictor-corrector direction, or primal-dual right-hand side and search direction
+    if (p.algorithm == Algorithm::ADAPTIVE || !this->m_predictor_corrector || !this->evalPredictorCorrector())
+    {
+      this->evalNewtonRhs();
+      this->evalNewtonStep();
+    }
 
     // Evaluate models
     this->evalModels();
@@ -368,13 +389,168 @@ namespace Pipal {
     d.x_norm_ = d.x_norm;
   }
 
+  /**
+   * \brief Compute the search direction with a Mehrotra predictor-corrector step.
+   *
+   * The affine-scaling predictor (\f$ \mu = 0 \f$) is solved with the current factorization of the
+   * Newton matrix. The interior-point parameter is then set to \f$ \sigma\mu_c \f$, where
+   * \f$ \mu_c \f$ is the average complementarity of the slacks and \f$ \sigma = (\mu_a/\mu_c)^3 \f$
+   * is the cube of its reduction along the predictor cut by the fraction-to-boundary rule. The
+   * corrector adds the second-order complementarity terms of the predictor to the right-hand side,
+   * and it is solved with the same factorization, as well as the centrality correctors (if enabled).
+   * \tparam Real Floating-point type used by the algorithm.
+   * \return True if the direction is evaluated, false if the problem has no constraints.
+   */
+  template <typename Real, typename ProblemT>
+  bool Solver<Real, ProblemT>::evalPredictorCorrector()
+  {
+    // Create alias for easier access
+    Parameter<Real>  & p{this->m_parameter};
+    Input<Real>      & i{this->m_input};
+    Iterate<Real>    & z{this->m_iterate};
+    Direction<Real>  & d{this->m_direction};
+    Acceptance<Real> & a{this->m_acceptance};
+
+    if (i.nE + i.nI == 0) {return false;}
+
+    // Evaluate average complementarity
+    Array<Real> w;
+    this->evalComplementarity(0.0, 0.0, w);
+    Real const mu_c{w.mean()};
+
+    // Evaluate affine-scaling predictor and its step lengths
+    this->setMu(0.0);
+    this->evalNewtonRhs();
+    this->evalNewtonStep();
+    this->fractionToBoundary();
+    this->evalComplementarity(a.p, a.d, w);
+    Real const mu_a{w.mean()};
+
+    // Set interior-point parameter from the predicted complementarity reduction
+    Real const sigma{mu_c > 0.0 ? std::pow(std::min(mu_a/mu_c, Real(1.0)), 3) : 0.0};
+    this->setMu(std::min(p.mu_max, std::max(p.mu_min, sigma*mu_c)));
+    this->evalMerit();
+
+    // Evaluate corrector with the second-order complementarity terms of the predictor
+    this->evalNewtonRhs();
+    if (i.nE > 0) {
+      z.b.segment(i.nV, i.nE)      += (d.r1*d.lE/z.r1).matrix();
+      z.b.segment(i.nV+i.nE, i.nE) -= (d.r2*d.lE/z.r2).matrix();
+    }
+    if (i.nI > 0) {
+      z.b.segment(i.nV+2*i.nE, i.nI)      += (d.s1*d.lI/z.s1).matrix();
+      z.b.segment(i.nV+2*i.nE+i.nI, i.nI) -= (d.s2*d.lI/z.s2).matrix();
+    }
+    std::chrono::steady_clock::time_point const t_start{std::chrono::steady_clock::now()};
+    this->evalNewtonStep();
+    std::chrono::duration<Real> const t_solve{std::chrono::steady_clock::now() - t_start};
+
+    // Evaluate centrality correctors
+    if (this->m_correctors > 0) {this->evalCentralityCorrectors(t_solve.count());}
+    return true;
+  }
+
+  /**
+   * \brief Evaluate the complementarity products after primal and dual steps along the direction.
+   *
+   * The products \f$ r_1(1+\lambda_E) \f$, \f$ r_2(1-\lambda_E) \f$, \f$ s_1\lambda_I \f$ and
+   * \f$ s_2(1-\lambda_I) \f$ are stacked in the order of the complementarity rows of the Newton
+   * system.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] ap Primal step length.
+   * \param[in] ad Dual step length.
+   * \param[out] w Complementarity products.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalComplementarity(Real const ap, Real const ad, Array<Real> & w) const
+  {
+    // Create alias for easier access
+    Input<Real>     const & i{this->m_input};
+    Iterate<Real>   const & z{this->m_iterate};
+    Direction<Real> const & d{this->m_direction};
+
+    w.resize(2*i.nE + 2*i.nI);
+    if (i.nE > 0) {
+      w.head(i.nE)          = (z.r1 + ap*d.r1)*(1.0 + z.lE + ad*d.lE);
+      w.segment(i.nE, i.nE) = (z.r2 + ap*d.r2)*(1.0 - z.lE - ad*d.lE);
+    }
+    if (i.nI > 0) {
+      w.segment(2*i.nE, i.nI)      = (z.s1 + ap*d.s1)*(z.lI + ad*d.lI);
+      w.segment(2*i.nE+i.nI, i.nI) = (z.s2 + ap*d.s2)*(1.0 - z.lI - ad*d.lI);
+    }
+  }
+
+  /**
+   * \brief Refine the search direction with Gondzio multiple centrality correctors.
+   *
+   * Each corrector targets the step length \f$ \tilde{\alpha} = \min(\alpha + \delta, 1) \f$,
+   * where \f$ \alpha \f$ is the shortest of the fraction-to-boundary primal and dual step lengths.
+   * The complementarity products at \f$ \tilde{\alpha} \f$ are projected onto the box
+   * \f$ [\beta_{\min}\mu, \beta_{\max}\mu] \f$, and the correction of the direction toward the
+   * projection is solved with the current factorization. The corrected direction is kept if its step
+   * length grows by at least \f$ \gamma\delta \f$, otherwise the refinement stops. The number of
+   * correctors grows with the cost ratio of the last factorization to a solve.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] t_solve Time of a solve with the current factorization (in seconds).
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalCentralityCorrectors(Real const t_solve)
+  {
+    // Create alias for easier access
+    Parameter<Real>  & p{this->m_parameter};
+    Input<Real>      & i{this->m_input};
+    Iterate<Real>    & z{this->m_iterate};
+    Acceptance<Real> & a{this->m_acceptance};
+
+    // Set number of correctors from the factorization to solve cost ratio
+    Real const ratio{z.t_factor/std::max(t_solve, std::numeric_limits<Real>::min())};
+    Integer const n_corr{std::min(this->m_correctors, 1 + static_cast<Integer>(std::min(ratio/p.corr_ratio,
+      Real(this->m_correctors))))};
+
+    // Set complementarity rows offset and slacks
+    Integer const oC{i.nV}, nC{2*i.nE+2*i.nI};
+    Array<Real> slacks(nC);
+    if (i.nE > 0) {slacks.head(i.nE) = z.r1; slacks.segment(i.nE, i.nE) = z.r2;}
+    if (i.nI > 0) {slacks.segment(2*i.nE, i.nI) = z.s1; slacks.segment(2*i.nE+i.nI, i.nI) = z.s2;}
+
+    this->fractionToBoundary();
+    Real alpha{std::min(a.p, a.d)};
+    Array<Real> w;
+    Direction<Real> d_;
+    this->resetDirection(d_);
+    for (Integer k{0}; k < n_corr && alpha < 1.0; ++k)
+    {
+      // Project the complementarity products at the target step length onto the target box
+      Real const target{std::min(alpha + p.corr_step, Real(1.0))};
+      this->evalComplementarity(target, target, w);
+      Array<Real> const t((w.max(p.corr_beta_min*z.mu).min(p.corr_beta_max*z.mu) - w).max(-p.corr_beta_max*z.mu));
+
+      // Evaluate corrected direction
+      this->evalTrialStep(d_);
+      Vector<Real> const b_(z.b);
+      z.b.segment(oC, nC) -= (t/slacks).matrix();
+      this->evalNewtonStep();
+      this->fractionToBoundary();
+
+      // Reject corrector if the step length does not grow enough
+      Real const alpha_new{std::min(a.p, a.d)};
+      if (alpha_new < alpha + p.corr_gain*(target - alpha)) {
+        this->evalLinearCombination(d_, d_, d_, 1.0, 0.0, 0.0);
+        z.b = b_;
+        break;
+      }
+      alpha = alpha_new;
+      ++this->m_counter.C;
+    }
+  }
+
   /**
    * \brief Store a trial step into another direction object.
    * \tparam Real Floating-point type used by the algorithm.
    * \param[out] v Destination direction that will contain the trial step.
    */
-  template<typename Real>
-  void Solver<Real>::evalTrialStep(Direction<Real> & v) const
+  template<typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalTrialStep(Direction<Real> & v) const
   {
     Input<Real>     const & i{this->m_input};
     Direction<Real> const & d{this->m_direction};
@@ -388,8 +564,8 @@ namespace Pipal {
    * \brief Scale a trial step by the fraction-to-boundary values.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template<typename Real>
-  void Solver<Real>::evalTrialStepCut()
+  template<typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalTrialStepCut()
   {
     // Create alias for easier access
     Input<Real>      & i{this->m_input};
@@ -409,8 +585,8 @@ namespace Pipal {
    * \param[out] d2 Direction for the second parameter combination.
    * \param[out] d3 Direction for the third parameter combination.
    */
-  template<typename Real>
-  void Solver<Real>::evalTrialSteps(Direction<Real> & d1, Direction<Real> & d2, Direction<Real> & d3)
+  template<typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalTrialSteps(Direction<Real> & d1, Direction<Real> & d2, Direction<Real> & d3)
   {
     // Create alias for easier access
     Iterate<Real> const & z{this->m_iterate};
@@ -453,8 +629,8 @@ namespace Pipal {
    * \param[in] dx_norm Norm of the primal direction (precomputed).
    * \param[in] dl_norm Norm of the dual direction (precomputed).
    */
-  template<typename Real>
-  void Solver<Real>::setDirection(Vector<Real> const & dx, Vector<Real> const & dr1, Vector<Real> const & dr2,
+  template<typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::setDirection(Vector<Real> const & dx, Vector<Real> const & dr1, Vector<Real> const & dr2,
     Vector<Real> const & ds1, Vector<Real> const & ds2, Vector<Real> const & dlE, Vector<Real> const & dlI,
     Real const dx_norm, Real const dl_norm)
   {
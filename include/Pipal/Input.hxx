@@ -25,8 +25,8 @@ namespace Pipal
    * \param[in] cl Lower bounds for the constraints.
    * \param[in] cu Upper bounds for the constraints.
    */
-  template <typename Real>
-  void Solver<Real>::buildInput(std::string  const & name, Vector<Real> const & x0, Vector<Real> const & bl,
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::buildInput(std::string  const & name, Vector<Real> const & x0, Vector<Real> const & bl,
     Vector<Real> const & bu, Vector<Real> const & cl, Vector<Real> const & cu)
   {
     // Create alias for easier access
@@ -19,8 +19,8 @@ namespace Pipal {
    * \brief Initialize an Iterate object for a given problem/input.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::buildIterate()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::buildIterate()
   {
     // Create alias for easier access
     Parameter<Real> & p{this->m_parameter};
@@ -50,13 +50,25 @@ namespace Pipal {
     z.kkt.setZero(3);
     z.kkt_.setConstant(p.opt_err_mem, std::numeric_limits<Real>::infinity());
     z.fs = 1.0;
+    z.xs.resize(0);
     z.cEs.setOnes(i.nE);
     z.cEu.setZero(i.nE);
     z.cIs.setOnes(i.nI);
     z.cIu.setZero(i.nI);
     z.A.resize(i.nA, i.nA);
+    z.Ad.setOnes(i.nA);
+    z.Ait = 0;
     z.shift22 = 0;
+    z.Ikept.resize(0);
     z.cut_ = false;
+    z.active.resize(0);
+    z.active_k = 0;
+    z.trials = 0;
+    z.trial_k = -1;
+    z.trial_j = -1;
+    z.trial_n = 0;
+    z.infeas_k = 0;
+    z.t_factor = 0.0;
 
     // Initialize point
     z.x     = i.x0;
@@ -65,6 +77,15 @@ namespace Pipal {
     z.lE.setZero(i.nE);
     z.lI.setConstant(i.nI, 0.5);
     z.err   = 0;
+
+    // Apply the warm start (if consistent with the classification)
+    if (this->m_warm_start && this->m_warm.lE.size() == i.nE && this->m_warm.lI.size() == i.nI) {
+      z.rho = this->m_warm.rho;
+      z.mu  = std::max(this->m_warm.mu, p.mu_min);
+      z.lE  = this->m_warm.lE;
+      z.lI  = this->m_warm.lI;
+    }
+    this->evalVariableScalings();
     this->evalScalings();
     this->evalFunctions();
     this->evalGradients();
@@ -90,8 +111,8 @@ namespace Pipal {
    * \tparam Real Floating-point type used by the algorithm.
    * \return An integer termination code (0 = continue, 1..5 = specific exits).
    */
-  template <typename Real>
-  Integer Solver<Real>::checkTermination() const
+  template <typename Real, typename ProblemT>
+  Integer Solver<Real, ProblemT>::checkTermination() const
   {
     // Create alias for easier access
     Parameter<Real> const & p{this->m_parameter};
@@ -105,6 +126,9 @@ namespace Pipal {
     // Update termination based on optimality error of feasibility problem
     if (z.kkt(0) <= p.opt_err_tol && z.v > p.opt_err_tol) return 2;
 
+    // Update termination based on early infeasibility detection
+    if (z.infeas_k >= p.infeas_stable) return 2;
+
     // Update termination based on iteration count
     if (c.k >= p.iter_max) return 3;
 
@@ -121,8 +145,8 @@ namespace Pipal {
    * \brief Evaluate objective and constraint functions at the current iterate.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalFunctions()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalFunctions()
   {
     // Create alias for easier access
     Input<Real>   & i{this->m_input};
@@ -138,15 +162,19 @@ namespace Pipal {
     // Increment function evaluation counter
     incrementFunctionCount();
 
-    // Try AMPL functions evaluation
+    // Try AMPL functions evaluation (a false return rejects the point as an exception does)
     Vector<Real> c_orig;
-    try
+    bool ok{false};
+    PIPAL_TRY
     {
       // Evaluate AMPL functions
-      this->m_problem->objective(x_orig, z.f);
-      this->m_problem->constraints(x_orig, c_orig);
+      ok = this->m_problem->objective(x_orig, z.f) && this->m_problem->constraints(x_orig, c_orig);
+    }
+    PIPAL_CATCH_ALL
+    {
+      ok = false;
     }
-    catch (...)
+    if (!ok)
     {
       // Set evaluation flag, default values, and return
       z.err = 1;
@@ -206,11 +234,11 @@ namespace Pipal {
    *
    * Calls the problem-provided gradient/jacobian functions in the original space, maps the results
    * into the internal compressed representations and applies scaling. Increments gradient counters
-   * and handles exceptions.
+   * and handles evaluation failures (false returns or exceptions).
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalGradients()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalGradients()
   {
     // Create alias for easier access
     Input<Real>   & i{this->m_input};
@@ -229,13 +257,25 @@ namespace Pipal {
     // Try AMPL gradients evaluation
     Vector<Real> g_orig;
     SparseMatrix<Real> J_orig;
-    try
+    SparseMap<Real> const * J_view{nullptr};
+    bool ok{false};
+    PIPAL_TRY
+    {
+      // Evaluate AMPL gradients (a Jacobian exposed by the problem is read in place)
+      ok = this->m_problem->objective_gradient(x_orig, g_orig);
+      if constexpr (HasViews<Real, ProblemT>::value) {
+        ok = ok && this->m_problem->constraints_jacobian_view_at(x_orig, J_view);
+      }
+      if (ok && J_view == nullptr) {
+        ok = this->m_problem->constraints_jacobian(x_orig, J_orig);
+        J_orig.makeCompressed();
+      }
+    }
+    PIPAL_CATCH_ALL
     {
-      // Evaluate AMPL gradients
-      this->m_problem->objective_gradient(x_orig, g_orig);
-      this->m_problem->constraints_jacobian(x_orig, J_orig);
+      ok = false;
     }
-    catch (...)
+    if (!ok)
     {
       // Set evaluation flag, default values, and return
       z.err = 1;
@@ -245,19 +285,24 @@ namespace Pipal {
     // Set objective gradient
     z.g << g_orig(i.I1), g_orig(i.I3), g_orig(i.I4), g_orig(i.I5);
 
+    // Get constraint Jacobian storage
+    SparseMap<Real> const J{J_view != nullptr ? *J_view : SparseMap<Real>(J_orig.rows(), J_orig.cols(),
+      J_orig.nonZeros(), J_orig.outerIndexPtr(), J_orig.innerIndexPtr(), J_orig.valuePtr())};
+    if (z.xs.size() > 0) {z.g.array() *= z.xs;}
+
     // Initialize equality constraint Jacobian
     z.JE.setZero();
 
     // Set equality constraint Jacobian
     if (i.nE > 0) {
       Integer col_offset{0};
-      Pipal::insert_block<Real>(z.JE, J_orig, i.I6, i.I1, 0, col_offset);
+      Pipal::insert_block<Real>(z.JE, J, i.I6, i.I1, 0, col_offset);
       col_offset += i.I1.size();
-      Pipal::insert_block<Real>(z.JE, J_orig, i.I6, i.I3, 0, col_offset);
+      Pipal::insert_block<Real>(z.JE, J, i.I6, i.I3, 0, col_offset);
       col_offset += i.I3.size();
-      Pipal::insert_block<Real>(z.JE, J_orig, i.I6, i.I4, 0, col_offset);
+      Pipal::insert_block<Real>(z.JE, J, i.I6, i.I4, 0, col_offset);
       col_offset += i.I4.size();
-      Pipal::insert_block<Real>(z.JE, J_orig, i.I6, i.I5, 0, col_offset);
+      Pipal::insert_block<Real>(z.JE, J, i.I6, i.I5, 0, col_offset);
     }
 
     // Initialize inequality constraint Jacobian
@@ -280,42 +325,55 @@ namespace Pipal {
     }
     if (i.n7 > 0) {
       Integer row_offset{i.n3+i.n4+i.n5+i.n5}, col_offset{0};
-      Pipal::insert_block<Real>(z.JI, -J_orig, i.I7, i.I1, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I7, i.I1, row_offset, col_offset, -1.0);
       col_offset += i.I1.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I7, i.I3, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I7, i.I3, row_offset, col_offset);
       col_offset += i.I3.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I7, i.I4, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I7, i.I4, row_offset, col_offset);
       col_offset += i.I4.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I7, i.I5, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I7, i.I5, row_offset, col_offset);
     }
     if (i.n8 > 0) {
       Integer row_offset{i.n3+i.n4+i.n5+i.n5+i.n7}, col_offset{0};
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I8, i.I1, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I8, i.I1, row_offset, col_offset);
       col_offset += i.I1.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I8, i.I3, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I8, i.I3, row_offset, col_offset);
       col_offset += i.I3.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I8, i.I4, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I8, i.I4, row_offset, col_offset);
       col_offset += i.I4.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I8, i.I5, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I8, i.I5, row_offset, col_offset);
     }
     if (i.n9 > 0) {
       Integer row_offset{i.n3+i.n4+i.n5+i.n5+i.n7+i.n8}, col_offset{0};
-      Pipal::insert_block<Real>(z.JI, -J_orig, i.I9, i.I1, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I9, i.I1, row_offset, col_offset, -1.0);
       col_offset += i.I1.size();
-      Pipal::insert_block<Real>(z.JI, -J_orig, i.I9, i.I3, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I9, i.I3, row_offset, col_offset, -1.0);
       col_offset += i.I3.size();
-      Pipal::insert_block<Real>(z.JI, -J_orig, i.I9, i.I4, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I9, i.I4, row_offset, col_offset, -1.0);
       col_offset += i.I4.size();
-      Pipal::insert_block<Real>(z.JI, -J_orig, i.I9, i.I5, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I9, i.I5, row_offset, col_offset, -1.0);
       row_offset += i.n9; // Next row block
       col_offset = 0;
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I9, i.I1, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I9, i.I1, row_offset, col_offset);
       col_offset += i.I1.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I9, i.I3, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I9, i.I3, row_offset, col_offset);
       col_offset += i.I3.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I9, i.I4, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I9, i.I4, row_offset, col_offset);
       col_offset += i.I4.size();
-      Pipal::insert_block<Real>(z.JI, J_orig, i.I9, i.I5, row_offset, col_offset);
+      Pipal::insert_block<Real>(z.JI, J, i.I9, i.I5, row_offset, col_offset);
+    }
+
+    // Scale constraint Jacobian columns by primal variable scalings (bound rows are already scaled)
+    if (z.xs.size() > 0) {
+      Integer const o{i.n3+i.n4+2*i.n5};
+      for (Integer k{0}; k < z.JE.outerSize(); ++k) {
+        for (typename SparseMatrix<Real>::InnerIterator it(z.JE, k); it; ++it) {it.valueRef() *= z.xs(k);}
+      }
+      for (Integer k{0}; k < z.JI.outerSize(); ++k) {
+        for (typename SparseMatrix<Real>::InnerIterator it(z.JI, k); it; ++it) {
+          if (it.row() >= o) {it.valueRef() *= z.xs(k);}
+        }
+      }
     }
 
     // Scale objective gradient
@@ -336,6 +394,9 @@ namespace Pipal {
         }
       }
     }
+
+    // Update row-major copies for the multithreaded products
+    this->evalRowMajorCopies();
   }
 
   /**
@@ -346,8 +407,8 @@ namespace Pipal {
    * penalization and scaling factors.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalHessian()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalHessian()
   {
     // Create alias for easier access
     Input<Real>   & i{this->m_input};
@@ -366,58 +427,83 @@ namespace Pipal {
 
     // Try AMPL Hessian evaluation
     SparseMatrix<Real> H_orig;
-    try
+    SparseMap<Real> const * H_view{nullptr};
+    bool ok{true};
+    PIPAL_TRY
+    {
+      // Evaluate H_orig (a Hessian exposed by the problem is read in place)
+      if constexpr (HasViews<Real, ProblemT>::value) {
+        ok = this->m_problem->lagrangian_hessian_view_at(x_orig, l_orig, H_view);
+      }
+      if (ok && H_view == nullptr) {
+        ok = this->m_problem->lagrangian_hessian(x_orig, l_orig, H_orig);
+        H_orig.makeCompressed();
+      }
+    }
+    PIPAL_CATCH_ALL
     {
-      // Evaluate H_orig
-      this->m_problem->lagrangian_hessian(x_orig, l_orig, H_orig);
+      ok = false;
     }
-    catch (...)
+    if (!ok)
     {
       // Set evaluation flag, default values, and return
       z.err = 1;
       return;
     }
 
+    // Get Hessian of the Lagrangian storage
+    SparseMap<Real> const H{H_view != nullptr ? *H_view : SparseMap<Real>(H_orig.rows(), H_orig.cols(),
+      H_orig.nonZeros(), H_orig.outerIndexPtr(), H_orig.innerIndexPtr(), H_orig.valuePtr())};
+
     // Set Hessian of the Lagrangian
     Integer row_offset{0}, col_offset{0};
-    Pipal::insert_block<Real>(z.H, H_orig, i.I1, i.I1, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I1, i.I1, row_offset, col_offset);
     col_offset += i.I1.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I1, i.I3, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I1, i.I3, row_offset, col_offset);
     col_offset += i.I3.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I1, i.I4, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I1, i.I4, row_offset, col_offset);
     col_offset += i.I4.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I1, i.I5, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I1, i.I5, row_offset, col_offset);
     row_offset += i.I1.size();
     col_offset = 0; // Next row block
-    Pipal::insert_block<Real>(z.H, H_orig, i.I3, i.I1, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I3, i.I1, row_offset, col_offset);
     col_offset += i.I1.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I3, i.I3, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I3, i.I3, row_offset, col_offset);
     col_offset += i.I3.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I3, i.I4, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I3, i.I4, row_offset, col_offset);
     col_offset += i.I4.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I3, i.I5, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I3, i.I5, row_offset, col_offset);
     row_offset += i.I3.size();
     col_offset = 0; // Next row block
-    Pipal::insert_block<Real>(z.H, H_orig, i.I4, i.I1, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I4, i.I1, row_offset, col_offset);
     col_offset += i.I1.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I4, i.I3, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I4, i.I3, row_offset, col_offset);
     col_offset += i.I3.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I4, i.I4, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I4, i.I4, row_offset, col_offset);
     col_offset += i.I4.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I4, i.I5, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I4, i.I5, row_offset, col_offset);
     row_offset += i.I4.size();
     col_offset = 0; // Next row block
-    Pipal::insert_block<Real>(z.H, H_orig, i.I5, i.I1, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I5, i.I1, row_offset, col_offset);
     col_offset += i.I1.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I5, i.I3, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I5, i.I3, row_offset, col_offset);
     col_offset += i.I3.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I5, i.I4, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I5, i.I4, row_offset, col_offset);
     col_offset += i.I4.size();
-    Pipal::insert_block<Real>(z.H, H_orig, i.I5, i.I5, row_offset, col_offset);
+    Pipal::insert_block<Real>(z.H, H, i.I5, i.I5, row_offset, col_offset);
 
     // Workaround to ensure all diagonal entries exist (access or create them)
     for (Integer i{0}; i < z.H.rows(); ++i) {(void) z.H.coeffRef(i, i);}
 
+    // Scale H by primal variable scalings
+    if (z.xs.size() > 0) {
+      for (Integer k{0}; k < z.H.outerSize(); ++k) {
+        for (typename SparseMatrix<Real>::InnerIterator it(z.H, k); it; ++it) {
+          it.valueRef() *= z.xs(it.row())*z.xs(k);
+        }
+      }
+    }
+
     // Rescale H
     z.H *= z.rho*z.fs;
   }
@@ -429,8 +515,8 @@ namespace Pipal {
    * \param[in] mu Current interior-point parameter.
    * \return The infinity-norm of the KKT optimality vector.
    */
-  template <typename Real>
-  Real Solver<Real>::evalKKTError(Real const rho, Real const mu)
+  template <typename Real, typename ProblemT>
+  Real Solver<Real, ProblemT>::evalKKTError(Real const rho, Real const mu)
   {
     // Create alias for easier access
     Input<Real>   & i{this->m_input};
@@ -444,8 +530,9 @@ namespace Pipal {
     kkt.head(i.nV) = rho*z.g;
 
     // Set gradient of Lagrangian for constraints
-    if (i.nE > 0) {kkt.head(i.nV) += (z.lE.matrix().transpose()*z.JE).transpose();}
-    if (i.nI > 0) {kkt.head(i.nV) += (z.lI.matrix().transpose()*z.JI).transpose();}
+    Vector<Real> Jl;
+    if (i.nE > 0) {this->evalTransposeProduct(z.JE, z.lE.matrix(), Jl); kkt.head(i.nV) += Jl;}
+    if (i.nI > 0) {this->evalTransposeProduct(z.JI, z.lI.matrix(), Jl); kkt.head(i.nV) += Jl;}
 
     // Set complementarity for constraint slacks
     if (i.nE > 0) {
@@ -468,8 +555,8 @@ namespace Pipal {
    * \brief Compute the three KKT error measures used by the solver.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalKKTErrors()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalKKTErrors()
   {
     // Create alias for easier access
     Iterate<Real> & z{this->m_iterate};
@@ -485,8 +572,8 @@ namespace Pipal {
    * \tparam Real Floating-point type used by the algorithm.
    * \param[out] l Vector to store multipliers in original space.
    */
-  template <typename Real>
-  void Solver<Real>::evalLambdaOriginal(Vector<Real> & l) const
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalLambdaOriginal(Vector<Real> & l) const
   {
     // Create alias for easier access
     Input<Real>   const & i{this->m_input};
@@ -520,8 +607,8 @@ namespace Pipal {
    * \brief Compute the merit function value for the current iterate.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalMerit()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalMerit()
   {
     // Create alias for easier access
     Input<Real>   & i{this->m_input};
@@ -545,40 +632,17 @@ namespace Pipal {
    * \brief Assemble and (attempt to) factorize the Newton system matrix.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalNewtonMatrix()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalNewtonMatrix()
   {
     // Create alias for easier access
     Parameter<Real> & p{this->m_parameter};
     Input<Real>     & i{this->m_input};
     Iterate<Real>   & z{this->m_iterate};
 
-    // Check for equality constraints
-    if (i.nE > 0)
-    {
-      // Set diagonal terms
-      for (Integer j{0}; j < i.nE; ++j) {
-        z.A.coeffRef(i.nV+j,      i.nV+j)      = (1.0 + z.lE(j))/z.r1(j);
-        z.A.coeffRef(i.nV+i.nE+j, i.nV+i.nE+j) = (1.0 - z.lE(j))/z.r2(j);
-      }
-
-      // Set constraint Jacobian
-      Pipal::insert_block<Real>(z.A, z.JE, i.nV+2*i.nE+2*i.nI, 0);
-    }
-
-    // Check for inequality constraints
-    if (i.nI > 0)
-    {
-      // Set diagonal terms
-      const Integer offset{i.nV+2*i.nE};
-      for (Integer j{0}; j < i.nI; ++j) {
-        z.A.coeffRef(offset+j,      offset+j)      = z.lI(j)/z.s1(j);
-        z.A.coeffRef(offset+i.nI+j, offset+i.nI+j) = (1.0 - z.lI(j))/z.s2(j);
-      }
-
-      // Set constraint Jacobian
-      Pipal::insert_block<Real>(z.A, z.JI, i.nV+3*i.nE+2*i.nI, 0);
-    }
+    // Screen inequality constraints and assemble Newton matrix (without shifts)
+    this->evalScreening();
+    this->evalNewtonAssembly();
 
     // Set minimum potential shift
     Real min_shift{std::max(p.shift_min, p.shift_factor1*z.shift)};
@@ -590,32 +654,32 @@ namespace Pipal {
     bool done{false};
     z.shift22 = 0;
 
+    // Load the symbolic analysis from the cache (if enabled and not available)
+    z.ldlt.pool(z.Hnnz+z.JEnnz+z.JInnz >= p.par_nnz_min ? this->m_pool.get() : nullptr);
+    bool analyzed{this->m_symbolic_cache.empty() || z.ldlt.analyzed(z.A)};
+    if (!analyzed) {analyzed = this->loadSymbolicAnalysis();}
+
+    // Set Newton matrix size (screened inequality constraints excluded)
+    Integer const nK{static_cast<Integer>(z.Ikept.size())}, nR{i.nV+3*i.nE+3*nK};
+
     // Loop until inertia is correct
     while (!done && z.shift < p.shift_max)
     {
-      // Set Hessian of Lagrangian
-      Pipal::insert_block<Real>(z.A, z.H+z.shift*Matrix<Real>::Identity(i.nV, i.nV), 0, 0);
-
-      // Set diagonal terms
-      {
-        const Integer offset{i.nV+2*i.nE+2*i.nI};
-        for (Integer j{0}; j < i.nE; ++j) {
-          z.A.coeffRef(offset+j, offset+j) = -z.shift22;
-        }
-      }
-      {
-        const Integer offset{i.nV+3*i.nE+2*i.nI};
-        // Set diagonal terms
-        for (Integer j{0}; j < i.nI; ++j) {
-          z.A.coeffRef(offset+j, offset+j) = -z.shift22;
-        }
-      }
+      // Set shifted Hessian and multipliers diagonal terms
+      Real * val{z.A.valuePtr()};
+      typename SparseMatrix<Real>::StorageIndex const * ptr{z.A.outerIndexPtr()};
+      for (Integer j{0}; j < i.nV; ++j) {val[z.Adiag(j)] = z.Hdiag(j) + z.shift;}
+      for (Integer j{i.nV+2*i.nE+2*nK}; j < nR; ++j) {val[ptr[j]] = -z.shift22;}
 
-      // Set number of nonzeros in (upper triangle of) Newton matrix
+      // Set number of nonzeros in (lower triangle of) Newton matrix
       z.Annz = static_cast<Integer>(z.A.nonZeros());
 
-      // Factor primal-dual matrix
-      z.ldlt.compute(z.A);
+      // Factor primal-dual matrix (equilibrated if enabled)
+      std::chrono::steady_clock::time_point const t_start{std::chrono::steady_clock::now()};
+      if (this->m_equilibration) {this->evalEquilibration(); z.ldlt.compute(z.Ae);}
+      else {z.ldlt.compute(z.A);}
+      std::chrono::duration<Real> const t_factor{std::chrono::steady_clock::now() - t_start};
+      z.t_factor = t_factor.count();
 
       // Approximate number of negative pivots (inertia)
       Integer neig{static_cast<Integer>((z.ldlt.vectorD().array() < 0.0).count())};
@@ -624,27 +688,538 @@ namespace Pipal {
       incrementFactorizationCount();
 
       // Set number of nonnegative eigenvalues
-      Integer peig{i.nA - neig};
+      Integer peig{nR - neig};
 
       // Check inertia
-      if (peig < i.nV+2*i.nE+2*i.nI) {z.shift = std::max(min_shift, z.shift/p.shift_factor2);}
-      else if (neig < i.nE+i.nI && z.shift22 == 0) {z.shift22 = p.shift_min;}
+      if (peig < i.nV+2*i.nE+2*nK) {z.shift = std::max(min_shift, z.shift/p.shift_factor2);}
+      else if (neig < i.nE+nK && z.shift22 == 0) {z.shift22 = p.shift_min;}
       else {done = true;}
     }
 
+    // Save the symbolic analysis to the cache
+    if (!analyzed) {this->saveSymbolicAnalysis();}
+
     // Update Hessian
     z.H.diagonal().array() += z.shift;
+  }
+
+  /**
+   * \brief Path of the symbolic analysis cache file for the current problem structure.
+   *
+   * The file name contains a hash of the Newton matrix sparsity pattern and of the variables and
+   * constraints classification.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \return The cache file path.
+   */
+  template <typename Real, typename ProblemT>
+  std::string Solver<Real, ProblemT>::symbolicAnalysisPath() const
+  {
+    // Create alias for easier access
+    Input<Real>   const & i{this->m_input};
+    Iterate<Real> const & z{this->m_iterate};
 
-    // Compress Newton matrix
-    z.A.makeCompressed();
+    // Hash sparsity pattern and classification
+    Fnv1a hash;
+    hash.update(static_cast<std::uint64_t>(z.A.rows()));
+    hash.update(z.A.outerIndexPtr(), (z.A.outerSize()+1)*sizeof(*z.A.outerIndexPtr()));
+    hash.update(z.A.innerIndexPtr(), z.A.nonZeros()*sizeof(*z.A.innerIndexPtr()));
+    for (Indices const * I : {&i.I1, &i.I2, &i.I3, &i.I4, &i.I5, &i.I6, &i.I7, &i.I8, &i.I9}) {hash.update(*I);}
+    return this->m_symbolic_cache + "/pipal_" + hash.hex() + ".bin";
+  }
+
+  /**
+   * \brief Load the symbolic analysis of the Newton matrix from the cache.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \return True if a valid analysis was loaded, false otherwise.
+   */
+  template <typename Real, typename ProblemT>
+  bool Solver<Real, ProblemT>::loadSymbolicAnalysis()
+  {
+    // Create alias for easier access
+    Input<Real>   & i{this->m_input};
+    Iterate<Real> & z{this->m_iterate};
+
+    // Open cache file
+    std::ifstream file(this->symbolicAnalysisPath(), std::ios::in | std::ios::binary);
+    if (!file) {return false;}
+
+    // Check header and classification (guards against hash collisions)
+    std::uint64_t magic;
+    std::uint32_t version;
+    if (!read_binary(file, magic) || magic != SYMBOLIC_MAGIC || !read_binary(file, version) ||
+        version != SYMBOLIC_VERSION) {return false;}
+    Indices I;
+    for (Indices const * I_ref : {&i.I1, &i.I2, &i.I3, &i.I4, &i.I5, &i.I6, &i.I7, &i.I8, &i.I9}) {
+      if (!read_binary(file, I) || I.size() != I_ref->size() || (I != *I_ref).any()) {return false;}
+    }
+
+    // Load factorization symbolic analysis
+    return z.ldlt.loadAnalysis(file, z.A);
+  }
+
+  /**
+   * \brief Save the symbolic analysis of the Newton matrix to the cache.
+   *
+   * Failures in writing the cache file are silently ignored.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::saveSymbolicAnalysis() const
+  {
+    // Create alias for easier access
+    Input<Real>   const & i{this->m_input};
+    Iterate<Real> const & z{this->m_iterate};
+
+    // Write cache file
+    write_binary_file(this->symbolicAnalysisPath(), [&i, &z] (std::ostream & os) {
+      write_binary(os, SYMBOLIC_MAGIC);
+      write_binary(os, SYMBOLIC_VERSION);
+      for (Indices const * I : {&i.I1, &i.I2, &i.I3, &i.I4, &i.I5, &i.I6, &i.I7, &i.I8, &i.I9}) {write_binary(os, *I);}
+      z.ldlt.saveAnalysis(os);
+    });
+  }
+
+  /**
+   * \brief Look up the solution cache for the current problem instance.
+   *
+   * The cache key is made of the problem parameters (if exposed) and of the bounds. On an exact hit
+   * the cached solution is stored as the solution of the solve, on a near miss it is stored as the
+   * warm start of the solve (if its size matches the initial guess). Without parameters the key does
+   * not identify the problem instance, hence exact hits are disabled and the nearest cached solution
+   * is only used as a warm start.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] x_guess Initial guess for the primal variables.
+   * \param[in] bl Lower bounds on the primal variables.
+   * \param[in] bu Upper bounds on the primal variables.
+   * \param[in] cl Lower bounds on the constraints.
+   * \param[in] cu Upper bounds on the constraints.
+   * \param[out] key The cache key.
+   * \return True on an exact hit, false otherwise.
+   */
+  template <typename Real, typename ProblemT>
+  bool Solver<Real, ProblemT>::lookupCache(Vector<Real> const & x_guess, Vector<Real> const & bl,
+    Vector<Real> const & bu, Vector<Real> const & cl, Vector<Real> const & cu, Vector<Real> & key)
+  {
+    // Reset cache state (a user warm start is consumed by the current solve)
+    this->m_warm_start = this->m_warm_user && this->m_warm.x.size() == x_guess.size();
+    this->m_warm_user  = false;
+    this->m_cache_hit  = false;
+    if (!this->m_cache) {return false;}
+
+    // Build the cache key
+    Vector<Real> parameters;
+    if constexpr (HasParameters<Real, ProblemT>::value) {
+      PIPAL_ASSERT(this->m_problem->parameters(parameters),
+        "Pipal::Solver::lookupCache(...): error in evaluating problem parameters");
+    }
+    key = SolutionCache<Real>::key(parameters, {&bl, &bu, &cl, &cu});
+
+    // Look up exact hits (only if the key identifies the problem instance) and near misses
+    if (parameters.size() > 0 && this->m_cache->find(key, this->m_warm)) {
+      this->m_cache_hit = this->m_warm.x.size() == x_guess.size();
+      return this->m_cache_hit;
+    }
+    Real distance;
+    if (!this->m_warm_start) {
+      this->m_warm_start = this->m_cache->nearest(key, this->m_warm, distance) &&
+        this->m_warm.x.size() == x_guess.size();
+    }
+    return false;
+  }
+
+  /**
+   * \brief Store the solution of the current solve in the solution cache.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] key The cache key.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::storeCache(Vector<Real> const & key)
+  {
+    // Store primal-dual solution and parameters
+    this->m_cache->insert(key, this->warm_start());
+  }
+
+  /**
+   * \brief Select the inequality constraints kept in the Newton matrix.
+   *
+   * Eliminating the slacks and multiplier of the inequality constraint \f$ j \f$ from the Newton
+   * system adds the term \f$ w_j \mathbf{J}_j^\top \mathbf{J}_j \f$ to the Hessian block, with
+   * \f$ w_j = (s_{1,j}/\lambda_j + s_{2,j}/(1-\lambda_j))^{-1} \f$. For constraints with large slack
+   * and negligible multiplier this term is below a threshold and it is dropped, i.e., the constraint
+   * is screened. Constraints approaching their boundary have a growing term and are kept again. If
+   * screening is disabled all the inequality constraints are kept.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalScreening()
+  {
+    // Create alias for easier access
+    Parameter<Real> & p{this->m_parameter};
+    Input<Real>     & i{this->m_input};
+    Iterate<Real>   & z{this->m_iterate};
+
+    // Keep all inequality constraints
+    if (!this->m_screening || i.nI == 0) {
+      if (z.Ikept.size() != i.nI) {
+        z.Ikept = Indices::LinSpaced(i.nI, 0, i.nI-1);
+        z.Ipos  = z.Ikept;
+      }
+      return;
+    }
+
+    // Evaluate squared row norms of the inequality constraint Jacobian
+    Array<Real> Jn(Array<Real>::Zero(i.nI));
+    for (Integer k{0}; k < z.JI.outerSize(); ++k) {
+      for (typename SparseMatrix<Real>::InnerIterator it(z.JI, k); it; ++it) {
+        Jn(it.row()) += it.value()*it.value();
+      }
+    }
+
+    // Keep inequality constraints with non-negligible eliminated curvature
+    Array<Real> const w((z.s1/z.lI + z.s2/(1.0 - z.lI)).inverse());
+    z.Ikept = find(w*Jn > p.screen_tol);
+    z.Ipos.setConstant(i.nI, -1);
+    for (Integer k{0}; k < z.Ikept.size(); ++k) {z.Ipos(z.Ikept(k)) = k;}
+  }
+
+  /**
+   * \brief Assemble the lower triangle of the Newton system matrix.
+   *
+   * The matrix is assembled directly in compressed column storage. The column pointers are computed
+   * first, then the row indices and values are written by column ranges, possibly in parallel, as
+   * each thread owns disjoint columns no synchronization is needed. The positions of the Hessian
+   * diagonal entries are stored, so that the inertia correction loop only updates the shifted
+   * diagonal entries. Hessian and multiplier shifts are not included. Screened inequality constraints
+   * are not included, the slacks and multipliers blocks only hold the kept ones.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalNewtonAssembly()
+  {
+    using StorageIndex  = typename SparseMatrix<Real>::StorageIndex;
+    using InnerIterator = typename SparseMatrix<Real>::InnerIterator;
+
+    // Create alias for easier access
+    Parameter<Real> & p{this->m_parameter};
+    Input<Real>     & i{this->m_input};
+    Iterate<Real>   & z{this->m_iterate};
+
+    // Set block offsets and size (screened inequality constraints excluded)
+    Integer const nK{static_cast<Integer>(z.Ikept.size())};
+    Integer const oE{i.nV+2*i.nE+2*nK}, oI{i.nV+3*i.nE+2*nK}, nR{oI+nK};
+
+    // Use the executor on large matrices only
+    Executor * pool{z.Hnnz+z.JEnnz+z.JInnz >= p.par_nnz_min ? this->m_pool.get() : nullptr};
+
+    // Count the lower triangle nonzeros of each column
+    std::vector<StorageIndex> count(nR+1, 0);
+    Pipal::parallel_ranges(pool, i.nV, static_cast<StorageIndex const *>(nullptr),
+      [&z, &count] (Integer const begin, Integer const end) {
+        for (Integer c{begin}; c < end; ++c) {
+          StorageIndex n{1}; // Diagonal entry (always present)
+          for (InnerIterator it(z.H, c); it; ++it) {if (it.row() > c) {++n;}}
+          for (InnerIterator it(z.JE, c); it; ++it) {++n;}
+          for (InnerIterator it(z.JI, c); it; ++it) {if (z.Ipos(it.row()) >= 0) {++n;}}
+          count[c+1] = n;
+        }
+      });
+    for (Integer c{i.nV}; c < oE; ++c) {count[c+1] = 2;} // Slacks diagonal and coupling entries
+    for (Integer c{oE}; c < nR; ++c) {count[c+1] = 1;}    // Multipliers diagonal entries
+    for (Integer c{0}; c < nR; ++c) {count[c+1] += count[c];}
+
+    // Allocate the compressed storage
+    z.A.resize(nR, nR);
+    z.A.resizeNonZeros(count[nR]);
+    std::copy(count.begin(), count.end(), z.A.outerIndexPtr());
+    StorageIndex * idx{z.A.innerIndexPtr()};
+    Real         * val{z.A.valuePtr()};
+    z.Adiag.resize(i.nV);
+    z.Hdiag.resize(i.nV);
+
+    // Fill row indices and values by column ranges
+    Pipal::parallel_ranges(pool, nR, count.data(),
+      [&i, &z, &count, idx, val, nK, oE, oI] (Integer const begin, Integer const end) {
+        for (Integer c{begin}; c < end; ++c) {
+          StorageIndex k{count[c]};
+          if (c < i.nV) {
+            // Hessian of Lagrangian (lower triangle) and constraint Jacobians
+            z.Adiag(c) = k; z.Hdiag(c) = 0.0;
+            idx[k] = c; val[k++] = 0.0;
+            for (InnerIterator it(z.H, c); it; ++it) {
+              if (it.row() == c) {z.Hdiag(c) = it.value();}
+              else if (it.row() > c) {idx[k] = it.row(); val[k++] = it.value();}
+            }
+            for (InnerIterator it(z.JE, c); it; ++it) {idx[k] = oE+it.row(); val[k++] = it.value();}
+            for (InnerIterator it(z.JI, c); it; ++it) {
+              if (z.Ipos(it.row()) >= 0) {idx[k] = oI+z.Ipos(it.row()); val[k++] = it.value();}
+            }
+          } else if (c < i.nV+i.nE) {
+            // Equality constraint slacks (lower)
+            Integer const j{c-i.nV};
+            idx[k] = c;    val[k++] = (1.0 + z.lE(j))/z.r1(j);
+            idx[k] = oE+j; val[k++] = 1.0;
+          } else if (c < i.nV+2*i.nE) {
+            // Equality constraint slacks (upper)
+            Integer const j{c-i.nV-i.nE};
+            idx[k] = c;    val[k++] = (1.0 - z.lE(j))/z.r2(j);
+            idx[k] = oE+j; val[k++] = -1.0;
+          } else if (c < i.nV+2*i.nE+nK) {
+            // Inequality constraint slacks (lower)
+            Integer const j{c-i.nV-2*i.nE}, q{z.Ikept(j)};
+            idx[k] = c;    val[k++] = z.lI(q)/z.s1(q);
+            idx[k] = oI+j; val[k++] = 1.0;
+          } else if (c < oE) {
+            // Inequality constraint slacks (upper)
+            Integer const j{c-i.nV-2*i.nE-nK}, q{z.Ikept(j)};
+            idx[k] = c;    val[k++] = (1.0 - z.lI(q))/z.s2(q);
+            idx[k] = oI+j; val[k++] = -1.0;
+          } else {
+            // Multipliers
+            idx[k] = c; val[k++] = 0.0;
+          }
+        }
+      });
+  }
+
+  /**
+   * \brief Symmetric (Ruiz) equilibration of the Newton system matrix.
+   *
+   * Computes a positive diagonal matrix \f$\mathbf{D}\f$ such that the rows of the equilibrated
+   * matrix \f$\mathbf{D}\mathbf{A}\mathbf{D}\f$ have unit infinity-norm (up to a tolerance). Only the
+   * lower triangle of the Newton matrix is referenced. Since the scaling is a congruence, the
+   * inertia of the matrix is preserved and can still be read from the factorization.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalEquilibration()
+  {
+    // Create alias for easier access
+    Parameter<Real> & p{this->m_parameter};
+    Iterate<Real>   & z{this->m_iterate};
+
+    // Initialize equilibrated matrix and scaling factors
+    z.Ae = z.A;
+    z.Ad.setOnes(z.A.rows());
+    z.Ait = 0;
+
+    // Ruiz iterations
+    Array<Real> r(z.A.rows());
+    while (z.Ait < p.equil_iter_max)
+    {
+      // Evaluate row infinity-norms of the symmetric matrix from its lower triangle
+      r.setZero();
+      for (Integer k{0}; k < z.Ae.outerSize(); ++k) {
+        for (typename SparseMatrix<Real>::InnerIterator it(z.Ae, k); it; ++it) {
+          if (it.row() < it.col()) {continue;}
+          Real const v{std::abs(it.value())};
+          r(it.row()) = std::max(r(it.row()), v);
+          r(it.col()) = std::max(r(it.col()), v);
+        }
+      }
+
+      // Leave empty rows unscaled
+      r = (r > 0.0).select(r, 1.0);
+
+      // Check convergence
+      if ((1.0 - r).abs().maxCoeff() <= p.equil_tol) {break;}
+
+      // Scale matrix and update scaling factors
+      r = r.sqrt().inverse();
+      for (Integer k{0}; k < z.Ae.outerSize(); ++k) {
+        for (typename SparseMatrix<Real>::InnerIterator it(z.Ae, k); it; ++it) {
+          it.valueRef() *= r(it.row())*r(it.col());
+        }
+      }
+      z.Ad *= r;
+      ++z.Ait;
+    }
+  }
+
+  /**
+   * \brief Solve the Newton system with the current factorization.
+   *
+   * If equilibration is enabled, the system \f$\mathbf{A}\mathbf{x} = \mathbf{b}\f$ is solved as
+   * \f$\mathbf{x} = \mathbf{D}(\mathbf{D}\mathbf{A}\mathbf{D})^{-1}\mathbf{D}\mathbf{b}\f$. If some
+   * inequality constraints are screened, their slacks and multiplier are eliminated from the
+   * right-hand side, the reduced system is solved, and their directions are recovered by
+   * back-substitution, so that both vectors always have the full Newton system size.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] b Right-hand side vector.
+   * \param[out] x Solution vector.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalNewtonSolve(Vector<Real> const & b, Vector<Real> & x) const
+  {
+    // Create alias for easier access
+    Input<Real>   const & i{this->m_input};
+    Iterate<Real> const & z{this->m_iterate};
+
+    // Solve (equilibrated) system
+    auto solve = [this, &z] (Vector<Real> const & rhs, Vector<Real> & sol) {
+      if (this->m_equilibration) {
+        sol = (z.Ad * z.ldlt.solve((z.Ad * rhs.array()).matrix()).array()).matrix();
+      } else {
+        sol = z.ldlt.solve(rhs);
+      }
+    };
+
+    // Solve the full system if no inequality constraint is screened
+    Integer const nK{static_cast<Integer>(z.Ikept.size())};
+    if (nK == i.nI) {solve(b, x); return;}
+
+    // Set full and reduced system block offsets
+    Integer const oS{i.nV+2*i.nE}, oE{oS+2*i.nI}, oI{oE+i.nE};
+    Integer const oEr{oS+2*nK}, oIr{oEr+i.nE};
+
+    // Restrict right-hand side to the kept inequality constraints
+    Vector<Real> br(oIr+nK);
+    br.head(oS) = b.head(oS);
+    br.segment(oEr, i.nE) = b.segment(oE, i.nE);
+    for (Integer k{0}; k < nK; ++k) {
+      Integer const j{z.Ikept(k)};
+      br(oS+k)    = b(oS+j);
+      br(oS+nK+k) = b(oS+i.nI+j);
+      br(oIr+k)   = b(oI+j);
+    }
+
+    // Eliminate the screened inequality constraints
+    Array<Real> const D1(z.lI/z.s1), D2((1.0 - z.lI)/z.s2);
+    Array<Real> const w((D1.inverse() + D2.inverse() + z.shift22).inverse());
+    Vector<Real> t(Vector<Real>::Zero(i.nI)), Jt;
+    for (Integer j{0}; j < i.nI; ++j) {
+      if (z.Ipos(j) < 0) {t(j) = w(j)*(b(oS+j)/D1(j) - b(oS+i.nI+j)/D2(j) - b(oI+j));}
+    }
+    this->evalTransposeProduct(z.JI, t, Jt);
+    br.head(i.nV) -= Jt;
+
+    // Solve the reduced system
+    Vector<Real> xr;
+    solve(br, xr);
+
+    // Expand the solution to the full system size
+    x.resize(b.size());
+    x.head(oS) = xr.head(oS);
+    x.segment(oE, i.nE) = xr.segment(oEr, i.nE);
+    for (Integer k{0}; k < nK; ++k) {
+      Integer const j{z.Ikept(k)};
+      x(oS+j)      = xr(oS+k);
+      x(oS+i.nI+j) = xr(oS+nK+k);
+      x(oI+j)      = xr(oIr+k);
+    }
+
+    // Recover the screened inequality constraint directions by back-substitution
+    Vector<Real> Jx;
+    this->evalJacobianProduct(z.JI, z.JIr, x.head(i.nV), Jx);
+    for (Integer j{0}; j < i.nI; ++j) {
+      if (z.Ipos(j) >= 0) {continue;}
+      x(oI+j)      = w(j)*Jx(j) + t(j);
+      x(oS+j)      = (b(oS+j) - x(oI+j))/D1(j);
+      x(oS+i.nI+j) = (b(oS+i.nI+j) + x(oI+j))/D2(j);
+    }
+  }
+
+  /**
+   * \brief Update the row-major copies of the constraint Jacobians.
+   *
+   * The copies are kept only for the Jacobians large enough for the multithreaded products, and are
+   * released otherwise. The pattern of a copy is built together with the position and row of each
+   * entry in its storage, and the values are then refilled in place as long as the pattern of the
+   * Jacobian is unchanged. Since the Jacobians are rebuilt from the problem at each evaluation, the
+   * pattern is checked entry by entry during the refill, and the copy is rebuilt on a mismatch.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalRowMajorCopies()
+  {
+    // Create alias for easier access
+    Parameter<Real> const & p{this->m_parameter};
+    Iterate<Real>         & z{this->m_iterate};
+
+    auto update = [this, &p] (SparseMatrix<Real> const & J, SparseMatrixRow<Real> & Jr, Indices & Jp,
+      Indices & Ji) {
+      // Release the copies not used by the multithreaded products
+      if (!this->m_pool || J.nonZeros() < p.par_nnz_min) {
+        if (Jr.nonZeros() > 0) {Jr = SparseMatrixRow<Real>(); Jp.resize(0); Ji.resize(0);}
+        return;
+      }
+
+      // Refill the values in place (if the pattern is unchanged)
+      bool same{Jp.size() == J.nonZeros() && Jr.rows() == J.rows() && Jr.cols() == J.cols()};
+      Integer n{0};
+      for (Integer c{0}; same && c < J.outerSize(); ++c) {
+        for (typename SparseMatrix<Real>::InnerIterator it(J, c); it; ++it, ++n) {
+          if (Ji(n) != it.row() || Jr.innerIndexPtr()[Jp(n)] != c) {same = false; break;}
+          Jr.valuePtr()[Jp(n)] = it.value();
+        }
+      }
+      if (same) {return;}
+
+      // Rebuild the pattern and the entry positions (in the storage order of the column-major matrix)
+      Jr = J;
+      Jp.resize(J.nonZeros());
+      Ji.resize(J.nonZeros());
+      Indices next(Jr.rows());
+      for (Integer r{0}; r < Jr.rows(); ++r) {next(r) = Jr.outerIndexPtr()[r];}
+      n = 0;
+      for (Integer c{0}; c < J.outerSize(); ++c) {
+        for (typename SparseMatrix<Real>::InnerIterator it(J, c); it; ++it, ++n) {
+          Ji(n) = it.row();
+          Jp(n) = next(it.row())++;
+        }
+      }
+    };
+    update(z.JE, z.JEr, z.JEp, z.JEi);
+    update(z.JI, z.JIr, z.JIp, z.JIi);
+  }
+
+  /**
+   * \brief Compute a constraint Jacobian product \f$ \mathbf{y} = \mathbf{Jx} \f$.
+   *
+   * When multithreading is enabled, the product is computed row-wise on the row-major copy of the
+   * Jacobian, otherwise the Eigen sparse product is used.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] J Constraint Jacobian.
+   * \param[in] Jr Constraint Jacobian (row-major copy).
+   * \param[in] x Dense vector.
+   * \param[out] y Product vector.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalJacobianProduct(SparseMatrix<Real> const & J,
+    SparseMatrixRow<Real> const & Jr, Vector<Real> const & x, Vector<Real> & y) const
+  {
+    // Multithreaded product on the row-major copy
+    if (this->m_pool && Jr.nonZeros() >= this->m_parameter.par_nnz_min) {
+      Pipal::outer_product<Real>(this->m_pool.get(), Jr, x, y);
+    } else {
+      y = J*x;
+    }
+  }
+
+  /**
+   * \brief Compute a transposed product \f$ \mathbf{y} = \mathbf{J}^\top \mathbf{x} \f$.
+   *
+   * The product is computed column-wise on the column-major storage of the matrix, each entry is
+   * accumulated in storage order by a single thread.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] J Sparse matrix.
+   * \param[in] x Dense vector.
+   * \param[out] y Product vector.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalTransposeProduct(SparseMatrix<Real> const & J, Vector<Real> const & x,
+    Vector<Real> & y) const
+  {
+    // Multithreaded product on large matrices only
+    Executor * pool{J.nonZeros() >= this->m_parameter.par_nnz_min ? this->m_pool.get() : nullptr};
+    Pipal::outer_product<Real>(pool, J, x, y);
   }
 
   /**
    * \brief Build the right-hand side vector for the Newton system.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalNewtonRhs()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalNewtonRhs()
   {
     // Create alias for easier access
     Input<Real>   & i{this->m_input};
@@ -657,8 +1232,9 @@ namespace Pipal {
     z.b.head(i.nV) = z.rho*z.g;
 
     // Set gradient of Lagrangian for constraints
-    if (i.nE > 0) {z.b.head(i.nV) += (z.lE.matrix().transpose()*z.JE).transpose();}
-    if (i.nI > 0) {z.b.head(i.nV) += (z.lI.matrix().transpose()*z.JI).transpose();}
+    Vector<Real> Jl;
+    if (i.nE > 0) {this->evalTransposeProduct(z.JE, z.lE.matrix(), Jl); z.b.head(i.nV) += Jl;}
+    if (i.nI > 0) {this->evalTransposeProduct(z.JI, z.lI.matrix(), Jl); z.b.head(i.nV) += Jl;}
 
     // Set complementarity for constraint slacks
     if (i.nE > 0) {
@@ -683,8 +1259,8 @@ namespace Pipal {
    * \brief Evaluate scaling multipliers for objective and constraints.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalScalings()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalScalings()
   {
     // Create alias for easier access
     Parameter<Real> & p{this->m_parameter};
@@ -729,12 +1305,92 @@ namespace Pipal {
     }
   }
 
+  /**
+   * \brief Evaluate scaling factors for the primal variables.
+   *
+   * The factors are the nominal magnitudes or the inverse of the infinity-norms of the constraint
+   * Jacobian columns at the initial guess (bound constraints excluded). They are clamped and
+   * rounded to powers of two, so that scaling and unscaling are exact.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalVariableScalings()
+  {
+    #define CMD "Pipal::Solver::evalVariableScalings(...): "
+
+    // Create alias for easier access
+    Parameter<Real> & p{this->m_parameter};
+    Input<Real>     & i{this->m_input};
+    Iterate<Real>   & z{this->m_iterate};
+
+    // Check for disabled scaling
+    z.xs.resize(0);
+    if (this->m_scaling == Scaling::NONE) {return;}
+
+    // Evaluate scaling factors
+    Array<Real> xs(i.nV);
+    if (this->m_scaling == Scaling::NOMINAL) {
+      PIPAL_ASSERT(this->m_nominal.size() == i.n0,
+        CMD "nominal magnitudes size must match the number of primal variables");
+      Array<Real> const nominal(this->m_nominal.array());
+      xs << nominal(i.I1), nominal(i.I3), nominal(i.I4), nominal(i.I5);
+    } else {
+      this->evalGradients();
+      xs.setZero();
+      Integer const o{i.n3+i.n4+2*i.n5};
+      for (Integer k{0}; k < z.JE.outerSize(); ++k) {
+        for (typename SparseMatrix<Real>::InnerIterator it(z.JE, k); it; ++it) {
+          xs(k) = std::max(xs(k), std::abs(it.value()));
+        }
+      }
+      for (Integer k{0}; k < z.JI.outerSize(); ++k) {
+        for (typename SparseMatrix<Real>::InnerIterator it(z.JI, k); it; ++it) {
+          if (it.row() >= o) {xs(k) = std::max(xs(k), std::abs(it.value()));}
+        }
+      }
+      xs = (xs > 0.0 && xs.isFinite()).select(xs.inverse(), 1.0);
+    }
+
+    // Clamp and round to powers of two
+    xs = xs.max(1.0/p.var_scale_max).min(p.var_scale_max).unaryExpr(
+      [] (Real const v) {return std::exp2(std::round(std::log2(v)));});
+    z.xs = xs;
+
+    // Scale bounds and initial guess
+    this->applyVariableScalings();
+    z.x = i.x0;
+
+    #undef CMD
+  }
+
+  /**
+   * \brief Scale the primal variable bounds and initial guess of the input by the variable scalings.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::applyVariableScalings()
+  {
+    // Create alias for easier access
+    Input<Real>   & i{this->m_input};
+    Iterate<Real> & z{this->m_iterate};
+
+    // Check for disabled scaling
+    if (z.xs.size() == 0) {return;}
+
+    // Scale bounds and initial guess
+    i.x0 = (i.x0.array() / z.xs).matrix();
+    i.l3 = (i.l3.array() / z.xs.segment(i.n1, i.n3)).matrix();
+    i.u4 = (i.u4.array() / z.xs.segment(i.n1+i.n3, i.n4)).matrix();
+    i.l5 = (i.l5.array() / z.xs.segment(i.n1+i.n3+i.n4, i.n5)).matrix();
+    i.u5 = (i.u5.array() / z.xs.segment(i.n1+i.n3+i.n4, i.n5)).matrix();
+  }
+
   /**
    * \brief Compute internal slack variables from current iterate.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::evalSlacks()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalSlacks()
   {
     // Create alias for easier access
     Parameter<Real> & p{this->m_parameter};
@@ -771,8 +1427,8 @@ namespace Pipal {
    * \tparam Real Floating-point type used by the algorithm.
    * \param[out] x Vector to store primal variables in original space.
    */
-  template <typename Real>
-  void Solver<Real>::evalXOriginal(Vector<Real> & x)
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalXOriginal(Vector<Real> & x)
   {
     // Create alias for easier access
     Input<Real>      & i{this->m_input};
@@ -781,65 +1437,33 @@ namespace Pipal {
     // Initialize x in original space
     x.setZero(i.n0);
 
+    // Unscale primal variables
+    Vector<Real> const xu(z.xs.size() > 0 ? Vector<Real>(z.x.array()*z.xs) : z.x);
+
     // Evaluate x in original space
-    x(i.I1) = z.x.head(i.n1);
+    x(i.I1) = xu.head(i.n1);
     x(i.I2) = i.b2;
-    x(i.I3) = z.x.segment(i.n1, i.n3);
-    x(i.I4) = z.x.segment(i.n1+i.n3, i.n4);
-    x(i.I5) = z.x.segment(i.n1+i.n3+i.n4, i.n5);
+    x(i.I3) = xu.segment(i.n1, i.n3);
+    x(i.I4) = xu.segment(i.n1+i.n3, i.n4);
+    x(i.I5) = xu.segment(i.n1+i.n3+i.n4, i.n5);
   }
 
   /**
    * \brief Reserve and initialize the internal sparse Newton matrix structure.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::initNewtonMatrix()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::initNewtonMatrix()
   {
     // Create alias for easier access
     Input<Real>   & i{this->m_input};
     Iterate<Real> & z{this->m_iterate};
 
-    // Allocate memory
-    z.A.reserve(z.Hnnz + 5*i.nE + 5*i.nI + z.JEnnz + z.JInnz);
-
-    // Initialize interior-point Hessians
-    {
-      Integer diag;
-      for (Integer k{0}; k < 2*i.nE; ++k) {
-        diag = i.nV+k;
-        z.A.coeffRef(diag, diag) = 1.0;
-      }
-
-      for (Integer k{0}; k < 2*i.nI; ++k) {
-        diag = i.nV+2*i.nE+k;
-        z.A.coeffRef(diag, diag) = 1.0;
-      }
-    }
-
-    // Check for constraints
-    if (i.nE > 0)
-    {
-      // Initialize constraint Jacobian
-      Integer row, col;
-      for (Integer k{0}; k < i.nE; ++k) {
-        row = i.nV+2*i.nE+2*i.nI+k, col = i.nV+k;
-        z.A.coeffRef(row, col) = 1.0;
-        z.A.coeffRef(row, col+i.nE) = -1.0;
-      }
-    }
-
-    // Check for inequality constraints
-    if (i.nI > 0)
-    {
-      // Initialize constraint Jacobian
-      Integer row, col;
-      for (Integer k{0}; k < i.nI; ++k) {
-        row = i.nV+3*i.nE+2*i.nI+k, col = i.nV+2*i.nE+k;
-        z.A.coeffRef(row, col) = 1.0;
-        z.A.coeffRef(row, col+i.nI) = -1.0;
-      }
-    }
+    // Allocate memory for the Newton matrix
+    z.A.resize(i.nA, i.nA);
+    z.A.reserve(z.Hnnz + 3*i.nE + 3*i.nI + z.JEnnz + z.JInnz);
+    z.Adiag.setZero(i.nV);
+    z.Hdiag.setZero(i.nV);
   }
 
   /**
@@ -857,8 +1481,8 @@ namespace Pipal {
    * \param[in] cI Inequality constraint values.
    * \param[in] phi Merit function value.
    */
-  template <typename Real>
-  void Solver<Real>::setPrimals(Vector<Real> const & x, Array<Real> const & r1, Array<Real> const & r2,
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::setPrimals(Vector<Real> const & x, Array<Real> const & r1, Array<Real> const & r2,
     Array<Real> const & s1, Array<Real> const & s2, Array<Real> const & lE, Array<Real> const & lI,
     Real const f, Array<Real> const & cE, Array<Real> const & cI, Real const phi)
   {
@@ -891,8 +1515,8 @@ namespace Pipal {
   * \param[in] y Difference in gradients.
   * \return Updated Hessian approximation.
   */
-  template <typename Real>
-  void Solver<Real>::bfgsUpdate(Vector<Real> const & s, Vector<Real> const & y)
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::bfgsUpdate(Vector<Real> const & s, Vector<Real> const & y)
   {
     // Create alias for easier access
     Iterate<Real> & z{this->m_iterate};
@@ -913,8 +1537,8 @@ namespace Pipal {
    * parameter memory used for adaptive strategies.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::updateIterate()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::updateIterate()
   {
     // Create alias for easier access
     Parameter<Real>  & p{this->m_parameter};
@@ -934,6 +1558,11 @@ namespace Pipal {
     this->evalGradients();
     this->evalDependent();
 
+    // Count stagnant violation iterations at a stationary point of the violation
+    if (this->m_infeasibility && z.v > p.opt_err_tol && z.kkt(0) <= std::max(p.opt_err_tol, p.infeas_tol) &&
+        z.v >= (1.0 - p.infeas_dec)*z.v_) {++z.infeas_k;}
+    else {z.infeas_k = 0;}
+
     // Update objective Hessian approximation if enabled
     if (this->m_bfgs) {
       if (this->m_counter.k % this->m_parameter.bfgs_update_freq == 0) {
@@ -955,8 +1584,8 @@ namespace Pipal {
    * the desired tolerances.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::updateParameters()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::updateParameters()
   {
 
     Parameter<Real> & p{this->m_parameter};
@@ -999,8 +1628,8 @@ namespace Pipal {
    * \brief Apply a step to the primal and dual variables of the iterate.
    * \tparam Real Floating-point type used by the algorithm.
    */
-  template <typename Real>
-  void Solver<Real>::updatePoint()
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::updatePoint()
   {
     // Create alias for easier access
     Input<Real>      & i{this->m_input};
@@ -1023,8 +1652,8 @@ namespace Pipal {
    * \param[in] cI Inequality constraint values.
    * \return The 1-norm feasibility violation.
    */
-  template <typename Real>
-  Real Solver<Real>::evalViolation(Array<Real> const & cE, Array<Real> const & cI) const
+  template <typename Real, typename ProblemT>
+  Real Solver<Real, ProblemT>::evalViolation(Array<Real> const & cE, Array<Real> const & cI) const
   {
     // Create alias for easier access
     Input<Real> const & i{this->m_input};
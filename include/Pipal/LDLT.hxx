@@ -0,0 +1,507 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_LDLT_HXX
+#define INCLUDE_PIPAL_LDLT_HXX
+
+// STL
+#include <atomic>
+#include <vector>
+
+namespace Pipal
+{
+
+  /**
+   * \brief Multithreaded sparse \f$ \mathbf{LDL}^\top \f$ factorization.
+   *
+   * The SparseLDLT class factorizes a symmetric (possibly indefinite) sparse matrix, of which only
+   * the lower triangle is referenced, as \f$ \mathbf{PAP}^\top = \mathbf{LDL}^\top \f$, where
+   * \f$ \mathbf{P} \f$ is an approximate minimum degree ordering, \f$ \mathbf{L} \f$ is unit lower
+   * triangular and \f$ \mathbf{D} \f$ is diagonal. The interface mirrors Eigen::SimplicialLDLT.
+   *
+   * The symbolic analysis (ordering, elimination tree and column counts of the factor) is reused as
+   * long as the sparsity pattern of the matrix does not change. The numeric factorization is
+   * up-looking: the elimination tree is split into independent subtrees whose rows are factored
+   * concurrently on a thread pool, the remaining top nodes are factored afterwards. Each row is
+   * computed by a single thread with the same operations of the serial algorithm, so that the factor
+   * does not depend on the number of threads.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real>
+  class SparseLDLT
+  {
+    static_assert(std::is_floating_point_v<Real>,
+      "Pipal::SparseLDLT<Real>: Real must be a floating-point type.");
+
+  public:
+    using StorageIndex = typename SparseMatrix<Real>::StorageIndex;
+    using Permutation  = Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, StorageIndex>;
+
+  private:
+    Executor *             m_pool{nullptr};          /*!< Executor (serial execution if null). */
+    Eigen::ComputationInfo m_info{Eigen::Success};   /*!< Computation status. */
+    bool                   m_analyzed{false};        /*!< Symbolic analysis flag. */
+    Integer                m_n{0};                   /*!< Matrix size. */
+    Integer                m_threads{0};             /*!< Number of threads of the current schedule. */
+
+    std::vector<StorageIndex> m_Aptr;   /*!< Analyzed matrix column pointers. */
+    std::vector<StorageIndex> m_Aidx;   /*!< Analyzed matrix row indices. */
+    Permutation               m_P;      /*!< Fill-reducing permutation. */
+    Permutation               m_Pinv;   /*!< Inverse of the fill-reducing permutation. */
+    SparseMatrix<Real>        m_Ap;     /*!< Permuted matrix (upper triangle). */
+    std::vector<StorageIndex> m_parent; /*!< Elimination tree. */
+    std::vector<StorageIndex> m_Lnnz;   /*!< Factor column nonzeros (strictly lower part). */
+    std::vector<StorageIndex> m_Lptr;   /*!< Factor column pointers. */
+    std::vector<StorageIndex> m_Lidx;   /*!< Factor row indices (strictly lower part). */
+    std::vector<Real>         m_Lval;   /*!< Factor values (strictly lower part). */
+    Vector<Real>              m_D;      /*!< Diagonal factor. */
+
+    std::vector<std::vector<StorageIndex>> m_tasks; /*!< Rows factored by each thread. */
+    std::vector<StorageIndex>              m_top;   /*!< Rows factored after all threads. */
+
+    /**
+     * \brief Check if the sparsity pattern matches the analyzed one.
+     * \param[in] A Compressed sparse matrix.
+     * \return True if the pattern matches, false otherwise.
+     */
+    bool samePattern(SparseMatrix<Real> const & A) const
+    {
+      if (!this->m_analyzed || A.rows() != this->m_n || A.cols() != this->m_n) {return false;}
+      StorageIndex const * ptr{A.outerIndexPtr()};
+      StorageIndex const * idx{A.innerIndexPtr()};
+      return std::equal(this->m_Aptr.begin(), this->m_Aptr.end(), ptr) &&
+        std::equal(this->m_Aidx.begin(), this->m_Aidx.end(), idx);
+    }
+
+    /**
+     * \brief Split the elimination tree in balanced independent subtrees, one set per thread.
+     * \param[in] threads Number of threads.
+     */
+    void schedule(Integer const threads)
+    {
+      Integer const n{this->m_n};
+      this->m_threads = threads;
+      this->m_tasks.assign(threads, std::vector<StorageIndex>());
+      this->m_top.clear();
+
+      // Serial execution
+      if (threads <= 1) {
+        this->m_tasks[0].resize(n);
+        std::iota(this->m_tasks[0].begin(), this->m_tasks[0].end(), StorageIndex(0));
+        return;
+      }
+
+      // Estimate the work of each subtree (parents follow children in the natural order)
+      std::vector<double> work(n);
+      for (Integer j{0}; j < n; ++j) {
+        double const c{static_cast<double>(this->m_Lptr[j+1] - this->m_Lptr[j] + 1)};
+        work[j] += c*c;
+        if (this->m_parent[j] >= 0) {work[this->m_parent[j]] += work[j];}
+      }
+      std::vector<std::vector<StorageIndex>> children(n);
+      std::vector<StorageIndex> candidates;
+      double total{0.0};
+      for (Integer j{0}; j < n; ++j) {
+        if (this->m_parent[j] >= 0) {children[this->m_parent[j]].push_back(j);}
+        else {candidates.push_back(j); total += work[j];}
+      }
+
+      // Move the roots of too large subtrees to the top set
+      auto heavier = [&work] (StorageIndex const a, StorageIndex const b) {
+        return work[a] < work[b] || (work[a] == work[b] && a > b);
+      };
+      std::make_heap(candidates.begin(), candidates.end(), heavier);
+      double const limit{total/static_cast<double>(4*threads)};
+      while (!candidates.empty() && work[candidates.front()] > limit) {
+        std::pop_heap(candidates.begin(), candidates.end(), heavier);
+        StorageIndex const j{candidates.back()};
+        candidates.pop_back();
+        this->m_top.push_back(j);
+        for (StorageIndex k : children[j]) {
+          candidates.push_back(k);
+          std::push_heap(candidates.begin(), candidates.end(), heavier);
+        }
+      }
+      std::sort(this->m_top.begin(), this->m_top.end());
+
+      // Assign the subtrees to the threads (largest first to the least loaded thread)
+      std::sort(candidates.begin(), candidates.end(),
+        [&heavier] (StorageIndex const a, StorageIndex const b) {return heavier(b, a);});
+      std::vector<double> load(threads, 0.0);
+      std::vector<StorageIndex> stack;
+      for (StorageIndex r : candidates) {
+        Integer const t{static_cast<Integer>(std::min_element(load.begin(), load.end()) - load.begin())};
+        load[t] += work[r];
+        stack.assign(1, r);
+        while (!stack.empty()) {
+          StorageIndex const j{stack.back()};
+          stack.pop_back();
+          this->m_tasks[t].push_back(j);
+          stack.insert(stack.end(), children[j].begin(), children[j].end());
+        }
+      }
+      for (std::vector<StorageIndex> & task : this->m_tasks) {std::sort(task.begin(), task.end());}
+    }
+
+    /**
+     * \brief Complete the symbolic analysis for the current ordering.
+     *
+     * The permuted matrix, the elimination tree, the column counts of the factor and the schedule of
+     * the numeric factorization are computed from the matrix pattern.
+     * \param[in] A Symmetric sparse matrix (lower triangle referenced).
+     */
+    void symbolic(SparseMatrix<Real> const & A)
+    {
+      Integer const n{this->m_n};
+
+      // Permuted matrix (upper triangle)
+      this->m_Ap.resize(n, n);
+      this->m_Ap.template selfadjointView<Eigen::Upper>() =
+        A.template selfadjointView<Eigen::Lower>().twistedBy(this->m_P);
+
+      // Elimination tree and column counts of the factor
+      using InnerIterator = typename SparseMatrix<Real>::InnerIterator;
+      this->m_parent.assign(n, -1);
+      this->m_Lnnz.assign(n, 0);
+      std::vector<StorageIndex> tags(n, -1);
+      for (Integer k{0}; k < n; ++k) {
+        tags[k] = k;
+        for (InnerIterator it(this->m_Ap, k); it; ++it) {
+          StorageIndex i{static_cast<StorageIndex>(it.index())};
+          if (i >= k) {continue;}
+          for (; tags[i] != k; i = this->m_parent[i]) {
+            if (this->m_parent[i] == -1) {this->m_parent[i] = k;}
+            ++this->m_Lnnz[i];
+            tags[i] = k;
+          }
+        }
+      }
+      this->m_Lptr.assign(n+1, 0);
+      for (Integer k{0}; k < n; ++k) {this->m_Lptr[k+1] = this->m_Lptr[k] + this->m_Lnnz[k];}
+      this->m_Lidx.resize(this->m_Lptr[n]);
+      this->m_Lval.resize(this->m_Lptr[n]);
+
+      // Schedule the numeric factorization
+      this->schedule(this->m_pool != nullptr ? this->m_pool->size() : 1);
+      this->m_D.resize(n);
+      this->m_analyzed = true;
+      this->m_info = Eigen::Success;
+    }
+
+    /**
+     * \brief Workspace of a factorization task.
+     */
+    struct Workspace
+    {
+      std::vector<Real>         y;       /*!< Dense row accumulator. */
+      std::vector<StorageIndex> tags;    /*!< Visited nodes tags. */
+      std::vector<StorageIndex> pattern; /*!< Row pattern stack. */
+
+      /**
+       * \brief Workspace constructor.
+       * \param[in] n Matrix size.
+       */
+      explicit Workspace(Integer const n) : y(n, 0.0), tags(n, -1), pattern(n) {}
+    };
+
+    /**
+     * \brief Compute a row of the factor.
+     * \param[in] k Row index.
+     * \param[in,out] w Task workspace.
+     * \return True if the pivot is nonzero, false otherwise.
+     */
+    bool row(StorageIndex const k, Workspace & w)
+    {
+      using InnerIterator = typename SparseMatrix<Real>::InnerIterator;
+
+      Integer const n{this->m_n};
+      Real         * y{w.y.data()};
+      StorageIndex * tags{w.tags.data()};
+      StorageIndex * pattern{w.pattern.data()};
+
+      // Scatter the upper triangle column and compute the row pattern of the factor
+      Integer top{n};
+      tags[k] = k;
+      for (InnerIterator it(this->m_Ap, k); it; ++it) {
+        StorageIndex i{static_cast<StorageIndex>(it.index())};
+        if (i > k) {continue;}
+        y[i] += it.value();
+        Integer len{0};
+        for (; tags[i] != k; i = this->m_parent[i]) {pattern[len++] = i; tags[i] = k;}
+        while (len > 0) {pattern[--top] = pattern[--len];}
+      }
+
+      // Sparse triangular solve with the previous rows
+      Real d{y[k]};
+      y[k] = 0.0;
+      for (; top < n; ++top) {
+        StorageIndex const i{pattern[top]};
+        Real const y_i{y[i]};
+        y[i] = 0.0;
+        Real const l_ki{y_i/this->m_D[i]};
+        StorageIndex const p_end{this->m_Lptr[i] + this->m_Lnnz[i]};
+        StorageIndex p{this->m_Lptr[i]};
+        for (; p < p_end; ++p) {y[this->m_Lidx[p]] -= this->m_Lval[p]*y_i;}
+        d -= l_ki*y_i;
+        this->m_Lidx[p] = k;
+        this->m_Lval[p] = l_ki;
+        ++this->m_Lnnz[i];
+      }
+
+      // Set the pivot
+      this->m_D[k] = d;
+      return d != 0.0;
+    }
+
+  public:
+    /**
+     * \brief Default constructor.
+     */
+    SparseLDLT() = default;
+
+    /**
+     * \brief Deleted copy constructor.
+     * \note This class is not copyable.
+     */
+    SparseLDLT(SparseLDLT const &) = delete;
+
+    /**
+     * \brief Deleted assignment operator.
+     * \note This class is not assignable.
+     */
+    SparseLDLT & operator=(SparseLDLT const &) = delete;
+
+    /**
+     * \brief Set the executor used by the numeric factorization.
+     * \param[in] t_pool Executor (serial execution if null).
+     */
+    void pool(Executor * t_pool) {this->m_pool = t_pool;}
+
+    /**
+     * \brief Get the computation status.
+     * \return \c Eigen::Success if the factorization succeeded, \c Eigen::NumericalIssue if a zero
+     * pivot was found.
+     */
+    Eigen::ComputationInfo info() const {return this->m_info;}
+
+    /**
+     * \brief Get the diagonal factor.
+     * \return The diagonal factor \f$ \mathbf{D} \f$.
+     */
+    Vector<Real> const & vectorD() const {return this->m_D;}
+
+    /**
+     * \brief Get the fill-reducing permutation.
+     * \return The permutation \f$ \mathbf{P} \f$.
+     */
+    Permutation const & permutationP() const {return this->m_P;}
+
+    /**
+     * \brief Get the number of nonzeros in the strictly lower part of the factor.
+     * \return The number of nonzeros of \f$ \mathbf{L} \f$ (unit diagonal excluded).
+     */
+    Integer nonZeros() const {return static_cast<Integer>(this->m_Lidx.size());}
+
+    /**
+     * \brief Perform the symbolic analysis of a matrix.
+     * \param[in] A Symmetric sparse matrix (lower triangle referenced).
+     */
+    void analyzePattern(SparseMatrix<Real> const & A)
+    {
+      #define CMD "Pipal::SparseLDLT::analyzePattern(...): "
+
+      PIPAL_ASSERT(A.rows() == A.cols(), CMD "matrix must be square");
+      if (!A.isCompressed()) {SparseMatrix<Real> C(A); C.makeCompressed(); this->analyzePattern(C); return;}
+
+      Integer const n{static_cast<Integer>(A.rows())};
+      this->m_n = n;
+      StorageIndex const * Aptr{A.outerIndexPtr()};
+      StorageIndex const * Aidx{A.innerIndexPtr()};
+      this->m_Aptr.assign(Aptr, Aptr+n+1);
+      this->m_Aidx.assign(Aidx, Aidx+Aptr[n]);
+
+      // Approximate minimum degree ordering
+      Eigen::AMDOrdering<StorageIndex> amd;
+      {
+        SparseMatrix<Real> C;
+        C = A.template selfadjointView<Eigen::Lower>();
+        amd(C, this->m_Pinv);
+      }
+      if (this->m_Pinv.size() != n) {this->m_Pinv.setIdentity(n);}
+      this->m_P = this->m_Pinv.inverse();
+
+      // Elimination tree, column counts and schedule
+      this->symbolic(A);
+
+      #undef CMD
+    }
+
+    /**
+     * \brief Check if the symbolic analysis matches the sparsity pattern of a matrix.
+     * \param[in] A Symmetric sparse matrix (lower triangle referenced).
+     * \return True if the symbolic analysis can be reused, false otherwise.
+     */
+    bool analyzed(SparseMatrix<Real> const & A) const {return A.isCompressed() && this->samePattern(A);}
+
+    /**
+     * \brief Write the symbolic analysis to a binary stream.
+     *
+     * Only the matrix pattern and the fill-reducing ordering are written, the rest of the analysis is
+     * cheap to recompute (compared with the ordering) and it is rebuilt on load.
+     * \param[in] os Output stream.
+     */
+    void saveAnalysis(std::ostream & os) const
+    {
+      write_binary(os, static_cast<std::uint32_t>(sizeof(StorageIndex)));
+      write_binary(os, this->m_Aptr);
+      write_binary(os, this->m_Aidx);
+      write_binary(os, this->m_Pinv.indices());
+    }
+
+    /**
+     * \brief Read the symbolic analysis of a matrix from a binary stream.
+     *
+     * The stored pattern must match the one of the matrix and the ordering must be a permutation, then
+     * the elimination tree and the column counts of the factor are recomputed.
+     * \param[in] is Input stream.
+     * \param[in] A Symmetric sparse matrix (lower triangle referenced) the analysis refers to.
+     * \return True if a valid analysis matching the pattern of the matrix was read, false otherwise.
+     */
+    bool loadAnalysis(std::istream & is, SparseMatrix<Real> const & A)
+    {
+      if (!A.isCompressed() || A.rows() != A.cols()) {return false;}
+      Integer const n{static_cast<Integer>(A.rows())};
+      std::uint32_t index_size;
+      std::vector<StorageIndex> Aptr, Aidx;
+      typename Permutation::IndicesType Pinv;
+      if (!read_binary(is, index_size) || index_size != sizeof(StorageIndex) ||
+          !read_binary(is, Aptr) || !read_binary(is, Aidx) || !read_binary(is, Pinv)) {return false;}
+
+      // Check consistency with the matrix pattern
+      if (Aptr.size() != static_cast<std::size_t>(n+1) || Pinv.size() != n ||
+          !std::equal(Aptr.begin(), Aptr.end(), A.outerIndexPtr()) ||
+          Aidx.size() != static_cast<std::size_t>(A.nonZeros()) ||
+          !std::equal(Aidx.begin(), Aidx.end(), A.innerIndexPtr())) {return false;}
+      std::vector<bool> seen(n, false);
+      for (Integer k{0}; k < n; ++k) {
+        if (Pinv[k] < 0 || Pinv[k] >= n || seen[Pinv[k]]) {return false;}
+        seen[Pinv[k]] = true;
+      }
+
+      // Restore the ordering and recompute the rest of the analysis
+      this->m_n    = n;
+      this->m_Aptr = std::move(Aptr);
+      this->m_Aidx = std::move(Aidx);
+      this->m_Pinv.indices() = Pinv;
+      this->m_P    = this->m_Pinv.inverse();
+      this->symbolic(A);
+      return true;
+    }
+
+    /**
+     * \brief Perform the numeric factorization of a matrix with the analyzed pattern.
+     * \param[in] A Symmetric sparse matrix (lower triangle referenced).
+     */
+    void factorize(SparseMatrix<Real> const & A)
+    {
+      #define CMD "Pipal::SparseLDLT::factorize(...): "
+
+      PIPAL_ASSERT(this->m_analyzed, CMD "symbolic analysis not performed");
+      if (!A.isCompressed()) {SparseMatrix<Real> C(A); C.makeCompressed(); this->factorize(C); return;}
+      PIPAL_ASSERT(A.rows() == this->m_n && A.nonZeros() == static_cast<Eigen::Index>(this->m_Aidx.size()),
+        CMD "matrix pattern does not match the analyzed one");
+
+      // Update the schedule if the executor changed
+      Integer const threads{this->m_pool != nullptr ? this->m_pool->size() : 1};
+      if (threads != this->m_threads) {this->schedule(threads);}
+
+      // Permute the matrix values
+      this->m_Ap.template selfadjointView<Eigen::Upper>() =
+        A.template selfadjointView<Eigen::Lower>().twistedBy(this->m_P);
+
+      // Factor the rows of the independent subtrees, then the top nodes
+      std::fill(this->m_Lnnz.begin(), this->m_Lnnz.end(), 0);
+      std::atomic<bool> ok{true};
+      auto factor = [this, &ok] (std::vector<StorageIndex> const & rows) {
+        if (rows.empty()) {return;}
+        Workspace w(this->m_n);
+        bool task_ok{true};
+        for (StorageIndex k : rows) {task_ok = this->row(k, w) && task_ok;}
+        if (!task_ok) {ok = false;}
+      };
+      if (threads > 1) {
+        this->m_pool->run(threads, [this, &factor] (Integer const t) {factor(this->m_tasks[t]);});
+      } else {
+        factor(this->m_tasks[0]);
+      }
+      factor(this->m_top);
+
+      this->m_info = ok ? Eigen::Success : Eigen::NumericalIssue;
+
+      #undef CMD
+    }
+
+    /**
+     * \brief Factorize a matrix, reusing the symbolic analysis if the pattern did not change.
+     * \param[in] A Symmetric sparse matrix (lower triangle referenced).
+     * \return A reference to this object.
+     */
+    SparseLDLT & compute(SparseMatrix<Real> const & A)
+    {
+      if (!A.isCompressed()) {SparseMatrix<Real> C(A); C.makeCompressed(); return this->compute(C);}
+      if (!this->samePattern(A)) {this->analyzePattern(A);}
+      this->factorize(A);
+      return *this;
+    }
+
+    /**
+     * \brief Solve a linear system with the computed factorization.
+     * \param[in] b Right-hand side vector.
+     * \return The solution vector.
+     */
+    Vector<Real> solve(Vector<Real> const & b) const
+    {
+      Integer const n{this->m_n};
+      StorageIndex const * perm{this->m_P.indices().data()};
+
+      // Permute
+      Vector<Real> y(n);
+      for (Integer i{0}; i < n; ++i) {y[perm[i]] = b[i];}
+
+      // Forward substitution with L
+      for (Integer k{0}; k < n; ++k) {
+        Real const y_k{y[k]};
+        if (y_k == 0.0) {continue;}
+        for (StorageIndex q{this->m_Lptr[k]}; q < this->m_Lptr[k+1]; ++q) {y[this->m_Lidx[q]] -= this->m_Lval[q]*y_k;}
+      }
+
+      // Diagonal scaling
+      y.array() *= this->m_D.array().inverse();
+
+      // Backward substitution with L^T
+      for (Integer k{n-1}; k >= 0; --k) {
+        Real tmp{y[k]};
+        for (StorageIndex q{this->m_Lptr[k]}; q < this->m_Lptr[k+1]; ++q) {tmp -= this->m_Lval[q]*y[this->m_Lidx[q]];}
+        y[k] = tmp;
+      }
+
+      // Permute back
+      Vector<Real> x(n);
+      for (Integer i{0}; i < n; ++i) {x[i] = y[perm[i]];}
+      return x;
+    }
+
+  }; // class SparseLDLT
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_LDLT_HXX
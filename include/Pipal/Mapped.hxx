@@ -0,0 +1,355 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_MAPPED_HXX
+#define INCLUDE_PIPAL_MAPPED_HXX
+
+// STL
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Pipal
+{
+
+  static constexpr std::uint64_t MAPPED_MAGIC{0x50414d4c41504950ull}; /*!< Mapped problem file tag ("PIPALMAP"). */
+  static constexpr std::uint32_t MAPPED_VERSION{1};                   /*!< Mapped problem file version. */
+  static constexpr std::size_t   MAPPED_ALIGN{64};                    /*!< Alignment of the file sections. */
+
+  /**
+   * \brief Header of a mapped problem file.
+   */
+  struct MappedHeader
+  {
+    std::uint64_t magic;      /*!< File tag. */
+    std::uint32_t version;    /*!< File version. */
+    std::uint32_t real_size;  /*!< Size of the floating-point type. */
+    std::uint32_t index_size; /*!< Size of the sparse storage index type. */
+    std::uint32_t reserved;   /*!< Reserved (zero). */
+    std::int64_t  n;          /*!< Number of primal variables. */
+    std::int64_t  m;          /*!< Number of constraints. */
+    std::int64_t  nnz_q;      /*!< Number of non-zeros of the objective Hessian. */
+    std::int64_t  nnz_a;      /*!< Number of non-zeros of the constraints Jacobian. */
+  }; // struct MappedHeader
+
+  /**
+   * \brief Byte offsets of the sections of a mapped problem file.
+   *
+   * All the sections start at multiples of MAPPED_ALIGN, so that the mapped arrays are suitably
+   * aligned for vectorized access.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real>
+  struct MappedLayout
+  {
+    using StorageIndex = typename SparseMatrix<Real>::StorageIndex;
+
+    std::size_t c;       /*!< Objective linear term. */
+    std::size_t bl;      /*!< Lower bounds on the primal variables. */
+    std::size_t bu;      /*!< Upper bounds on the primal variables. */
+    std::size_t cl;      /*!< Lower bounds on the constraints. */
+    std::size_t cu;      /*!< Upper bounds on the constraints. */
+    std::size_t q_outer; /*!< Objective Hessian column pointers. */
+    std::size_t q_inner; /*!< Objective Hessian row indices. */
+    std::size_t q_value; /*!< Objective Hessian values. */
+    std::size_t a_outer; /*!< Constraints Jacobian column pointers. */
+    std::size_t a_inner; /*!< Constraints Jacobian row indices. */
+    std::size_t a_value; /*!< Constraints Jacobian values. */
+    std::size_t size;    /*!< Total file size. */
+
+    /**
+     * \brief Compute the layout of a mapped problem file.
+     * \param[in] h File header.
+     */
+    explicit MappedLayout(MappedHeader const & h)
+    {
+      std::size_t const n(h.n), m(h.m), nnz_q(h.nnz_q), nnz_a(h.nnz_a);
+      std::size_t offset{0};
+      auto const section = [&offset] (std::size_t const bytes) {
+        offset = (offset + MAPPED_ALIGN - 1)/MAPPED_ALIGN*MAPPED_ALIGN;
+        std::size_t const start{offset};
+        offset += bytes;
+        return start;
+      };
+      section(sizeof(MappedHeader));
+      this->c       = section(n*sizeof(Real));
+      this->bl      = section(n*sizeof(Real));
+      this->bu      = section(n*sizeof(Real));
+      this->cl      = section(m*sizeof(Real));
+      this->cu      = section(m*sizeof(Real));
+      this->q_outer = section((n+1)*sizeof(StorageIndex));
+      this->q_inner = section(nnz_q*sizeof(StorageIndex));
+      this->q_value = section(nnz_q*sizeof(Real));
+      this->a_outer = section((n+1)*sizeof(StorageIndex));
+      this->a_inner = section(nnz_a*sizeof(StorageIndex));
+      this->a_value = section(nnz_a*sizeof(Real));
+      this->size    = offset;
+    }
+  }; // struct MappedLayout
+
+  /**
+   * \brief Write a quadratic program to a file that can be memory-mapped by MappedProblem.
+   *
+   * The problem is
+   * \f[
+   *  \begin{array}{l}
+   *    \text{minimize} ~ \frac{1}{2} \mathbf{x}^\top Q \mathbf{x} + \mathbf{c}^\top \mathbf{x} \\
+   *    \text{subject to} ~ \mathbf{c}_l \leq A \mathbf{x} \leq \mathbf{c}_u, ~
+   *      \mathbf{b}_l \leq \mathbf{x} \leq \mathbf{b}_u
+   *  \end{array} \text{,}
+   * \f]
+   * where both triangles of the symmetric matrix \f$ Q \f$ must be stored.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] path Problem file path.
+   * \param[in] Q Objective Hessian.
+   * \param[in] c Objective linear term.
+   * \param[in] A Constraints Jacobian.
+   * \param[in] bl Lower bounds on the primal variables.
+   * \param[in] bu Upper bounds on the primal variables.
+   * \param[in] cl Lower bounds on the constraints.
+   * \param[in] cu Upper bounds on the constraints.
+   * \return True if the file was written successfully, false otherwise.
+   */
+  template <typename Real>
+  static bool write_mapped_problem(std::string const & path, SparseMatrix<Real> Q, Vector<Real> const & c,
+    SparseMatrix<Real> A, Vector<Real> const & bl, Vector<Real> const & bu, Vector<Real> const & cl,
+    Vector<Real> const & cu)
+  {
+    #define CMD "Pipal::write_mapped_problem(...): "
+
+    using StorageIndex = typename SparseMatrix<Real>::StorageIndex;
+
+    // Check dimensions
+    Integer const n{static_cast<Integer>(c.size())}, m{static_cast<Integer>(A.rows())};
+    PIPAL_ASSERT(Q.rows() == n && Q.cols() == n,
+      CMD "objective Hessian must be " << n << "x" << n << ".");
+    PIPAL_ASSERT(A.cols() == n,
+      CMD "constraints Jacobian must have " << n << " columns.");
+    PIPAL_ASSERT(bl.size() == n && bu.size() == n,
+      CMD "primal variable bounds must have size " << n << ".");
+    PIPAL_ASSERT(cl.size() == m && cu.size() == m,
+      CMD "constraint bounds must have size " << m << ".");
+
+    // Build header and layout
+    Q.makeCompressed();
+    A.makeCompressed();
+    MappedHeader const h{MAPPED_MAGIC, MAPPED_VERSION, sizeof(Real), sizeof(StorageIndex), 0,
+      n, m, Q.nonZeros(), A.nonZeros()};
+    MappedLayout<Real> const l(h);
+
+    return write_binary_file(path, [&] (std::ostream & os) {
+      std::size_t offset{0};
+      auto const section = [&os, &offset] (std::size_t const start, void const * data, std::size_t const bytes) {
+        static char const zeros[MAPPED_ALIGN]{};
+        os.write(zeros, static_cast<std::streamsize>(start - offset));
+        os.write(static_cast<char const *>(data), static_cast<std::streamsize>(bytes));
+        offset = start + bytes;
+      };
+      std::size_t const nr(n*sizeof(Real)), mr(m*sizeof(Real)), ni((n+1)*sizeof(StorageIndex));
+      section(0, &h, sizeof(MappedHeader));
+      section(l.c,  c.data(),  nr);
+      section(l.bl, bl.data(), nr);
+      section(l.bu, bu.data(), nr);
+      section(l.cl, cl.data(), mr);
+      section(l.cu, cu.data(), mr);
+      section(l.q_outer, Q.outerIndexPtr(), ni);
+      section(l.q_inner, Q.innerIndexPtr(), Q.nonZeros()*sizeof(StorageIndex));
+      section(l.q_value, Q.valuePtr(),      Q.nonZeros()*sizeof(Real));
+      section(l.a_outer, A.outerIndexPtr(), ni);
+      section(l.a_inner, A.innerIndexPtr(), A.nonZeros()*sizeof(StorageIndex));
+      section(l.a_value, A.valuePtr(),      A.nonZeros()*sizeof(Real));
+    });
+
+    #undef CMD
+  }
+
+  /**
+   * \brief Quadratic program read in place from a memory-mapped file.
+   *
+   * The compressed column arrays of the objective Hessian and of the constraints Jacobian, the
+   * objective linear term and the bounds are mapped read-only from a file written by
+   * write_mapped_problem, and wrapped in Eigen::Map views. The objective and constraints are
+   * evaluated directly on the mapped data, and the constant derivatives are exposed through
+   * \c constraints_jacobian_view and \c lagrangian_hessian_view, so that the solver assembles its
+   * matrices from the mapped pages without intermediate copies. Large problems are thus paged in
+   * on demand and shared between processes mapping the same file.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real>
+  class MappedProblem : public Problem<Real>
+  {
+    using StorageIndex = typename SparseMatrix<Real>::StorageIndex;
+    using VectorMap    = Eigen::Map<Vector<Real> const, Eigen::Aligned16>;
+
+    void *         m_data{MAP_FAILED}; /*!< Mapped file. */
+    std::size_t    m_size{0};          /*!< Mapped file size. */
+    Integer        m_n{0};             /*!< Number of primal variables. */
+    Integer        m_m{0};             /*!< Number of constraints. */
+    VectorMap      m_c{nullptr, 0};    /*!< Objective linear term. */
+    VectorMap      m_bl{nullptr, 0};   /*!< Lower bounds on the primal variables. */
+    VectorMap      m_bu{nullptr, 0};   /*!< Upper bounds on the primal variables. */
+    VectorMap      m_cl{nullptr, 0};   /*!< Lower bounds on the constraints. */
+    VectorMap      m_cu{nullptr, 0};   /*!< Upper bounds on the constraints. */
+    SparseMap<Real> m_Q{0, 0, 0, nullptr, nullptr, nullptr}; /*!< Objective Hessian. */
+    SparseMap<Real> m_A{0, 0, 0, nullptr, nullptr, nullptr}; /*!< Constraints Jacobian. */
+
+    /**
+     * \brief Get a pointer to a section of the mapped file.
+     * \tparam T Type of the section entries.
+     * \param[in] offset Byte offset of the section.
+     * \return The pointer to the section.
+     */
+    template <typename T>
+    T const * section(std::size_t const offset) const
+    {
+      return reinterpret_cast<T const *>(static_cast<char const *>(this->m_data) + offset);
+    }
+
+    /**
+     * \brief Check the compressed column arrays of a mapped matrix.
+     * \param[in] mat Mapped matrix.
+     * \return True if the arrays are consistent, false otherwise.
+     */
+    static bool valid(SparseMap<Real> const & mat)
+    {
+      StorageIndex const * outer{mat.outerIndexPtr()};
+      StorageIndex const * inner{mat.innerIndexPtr()};
+      if (outer[0] != 0 || outer[mat.cols()] != mat.nonZeros()) {return false;}
+      for (Eigen::Index j{0}; j < mat.cols(); ++j) {
+        if (outer[j] > outer[j+1]) {return false;}
+        for (StorageIndex k{outer[j]}; k < outer[j+1]; ++k) {
+          if (inner[k] < 0 || inner[k] >= mat.rows() || (k > outer[j] && inner[k] <= inner[k-1])) {return false;}
+        }
+      }
+      return true;
+    }
+
+  public:
+    /**
+     * \brief MappedProblem constructor.
+     * \param[in] path Problem file path (see write_mapped_problem).
+     * \param[in] t_name Name of the optimization problem.
+     */
+    explicit MappedProblem(std::string const & path, std::string t_name = "mapped")
+      : Problem<Real>(std::move(t_name))
+    {
+      #define CMD "Pipal::MappedProblem::MappedProblem(...): "
+
+      // Map the file
+      int const fd{::open(path.c_str(), O_RDONLY)};
+      PIPAL_ASSERT(fd >= 0, CMD "unable to open '" << path << "' (" << std::strerror(errno) << ").");
+      struct stat st;
+      if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(MappedHeader)) {
+        this->m_size = static_cast<std::size_t>(st.st_size);
+        this->m_data = ::mmap(nullptr, this->m_size, PROT_READ, MAP_SHARED, fd, 0);
+      }
+      ::close(fd);
+      PIPAL_ASSERT(this->m_data != MAP_FAILED, CMD "unable to map '" << path << "'.");
+
+      // Check the header
+      MappedHeader h;
+      std::memcpy(&h, this->m_data, sizeof(MappedHeader));
+      std::int64_t const size(this->m_size);
+      bool ok{h.magic == MAPPED_MAGIC && h.version == MAPPED_VERSION && h.real_size == sizeof(Real) &&
+        h.index_size == sizeof(StorageIndex) && h.n >= 0 && h.m >= 0 && h.nnz_q >= 0 && h.nnz_a >= 0 &&
+        h.n < size && h.m < size && h.nnz_q < size && h.nnz_a < size && MappedLayout<Real>(h).size <= this->m_size};
+
+      // Wrap the sections
+      if (ok) {
+        MappedLayout<Real> const l(h);
+        this->m_n = static_cast<Integer>(h.n);
+        this->m_m = static_cast<Integer>(h.m);
+        new (&this->m_c)  VectorMap(this->section<Real>(l.c),  this->m_n);
+        new (&this->m_bl) VectorMap(this->section<Real>(l.bl), this->m_n);
+        new (&this->m_bu) VectorMap(this->section<Real>(l.bu), this->m_n);
+        new (&this->m_cl) VectorMap(this->section<Real>(l.cl), this->m_m);
+        new (&this->m_cu) VectorMap(this->section<Real>(l.cu), this->m_m);
+        new (&this->m_Q) SparseMap<Real>(this->m_n, this->m_n, h.nnz_q, this->section<StorageIndex>(l.q_outer),
+          this->section<StorageIndex>(l.q_inner), this->section<Real>(l.q_value));
+        new (&this->m_A) SparseMap<Real>(this->m_m, this->m_n, h.nnz_a, this->section<StorageIndex>(l.a_outer),
+          this->section<StorageIndex>(l.a_inner), this->section<Real>(l.a_value));
+        ok = valid(this->m_Q) && valid(this->m_A);
+      }
+      if (!ok) {
+        ::munmap(this->m_data, this->m_size);
+        PIPAL_ERROR(CMD "invalid problem file '" << path << "'.");
+      }
+
+      #undef CMD
+    }
+
+    /**
+     * \brief MappedProblem destructor (unmaps the file).
+     */
+    ~MappedProblem() override {::munmap(this->m_data, this->m_size);}
+
+    /**
+     * \brief Get the number of primal variables.
+     * \return The number of primal variables.
+     */
+    Integer primal_size() const {return this->m_n;}
+
+    /**
+     * \brief Get the number of constraints.
+     * \return The number of constraints.
+     */
+    Integer constraints_size() const {return this->m_m;}
+
+    bool objective(Vector<Real> const & x, Real & out) const override
+    {
+      out = Real(0.5)*x.dot(this->m_Q*x) + this->m_c.dot(x);
+      return std::isfinite(out);
+    }
+
+    bool objective_gradient(Vector<Real> const & x, Vector<Real> & out) const override
+    {
+      out = this->m_Q*x + this->m_c;
+      return out.allFinite();
+    }
+
+    bool constraints(Vector<Real> const & x, Vector<Real> & out) const override
+    {
+      out = this->m_A*x;
+      return out.allFinite();
+    }
+
+    bool constraints_jacobian(Vector<Real> const &, SparseMatrix<Real> & out) const override
+    {
+      out = this->m_A;
+      return true;
+    }
+
+    bool lagrangian_hessian(Vector<Real> const &, Vector<Real> const &, SparseMatrix<Real> & out) const override
+    {
+      out = this->m_Q;
+      return true;
+    }
+
+    SparseMap<Real> const * constraints_jacobian_view() const override {return &this->m_A;}
+    SparseMap<Real> const * lagrangian_hessian_view() const override {return &this->m_Q;}
+
+    bool primal_lower_bounds(Vector<Real> & out) const override {out = this->m_bl; return true;}
+    bool primal_upper_bounds(Vector<Real> & out) const override {out = this->m_bu; return true;}
+    bool constraints_lower_bounds(Vector<Real> & out) const override {out = this->m_cl; return true;}
+    bool constraints_upper_bounds(Vector<Real> & out) const override {out = this->m_cu; return true;}
+
+  }; // class MappedProblem
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_MAPPED_HXX
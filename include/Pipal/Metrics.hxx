@@ -0,0 +1,493 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_METRICS_HXX
+#define INCLUDE_PIPAL_METRICS_HXX
+
+// STL
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Pipal
+{
+
+  /**
+   * \brief Lock-free histogram with logarithmically spaced buckets.
+   *
+   * The histogram counts samples in buckets whose upper bounds are \f$ b_k = b_{\min}
+   * 10^{k/d} \f$, with \f$ d \f$ buckets per decade, plus an overflow bucket. Recording a sample is
+   * wait-free (a few relaxed atomic increments), so that it can be used concurrently by many solver
+   * instances. Percentiles are estimated by geometric interpolation within the buckets.
+   */
+  class Histogram
+  {
+  public:
+    static constexpr Integer BUCKETS{64}; /*!< Number of finite buckets. */
+
+  private:
+    double m_min{1.0};   /*!< Upper bound of the first bucket. */
+    double m_decade{4};  /*!< Number of buckets per decade. */
+
+    std::array<std::atomic<std::uint64_t>, BUCKETS+1> m_counts{}; /*!< Bucket counters (+ overflow). */
+    std::atomic<std::uint64_t> m_count{0};                       /*!< Number of samples. */
+    std::atomic<double>        m_sum{0.0};                       /*!< Sum of the samples. */
+
+  public:
+    /**
+     * \brief Histogram constructor.
+     * \param[in] t_min Upper bound of the first bucket.
+     * \param[in] t_decade Number of buckets per decade.
+     */
+    Histogram(double const t_min, double const t_decade) : m_min(t_min), m_decade(t_decade) {}
+
+    /**
+     * \brief Deleted copy constructor.
+     * \note This class is not copyable.
+     */
+    Histogram(Histogram const &) = delete;
+
+    /**
+     * \brief Deleted assignment operator.
+     * \note This class is not assignable.
+     */
+    Histogram & operator=(Histogram const &) = delete;
+
+    /**
+     * \brief Upper bound of a bucket.
+     * \param[in] k Bucket index.
+     * \return The upper bound of the bucket (infinity for the overflow bucket).
+     */
+    double bound(Integer const k) const
+    {
+      if (k >= BUCKETS) {return std::numeric_limits<double>::infinity();}
+      return this->m_min*std::pow(10.0, static_cast<double>(k)/this->m_decade);
+    }
+
+    /**
+     * \brief Record a sample.
+     * \param[in] x Sample value.
+     */
+    void record(double const x)
+    {
+      Integer k{0};
+      if (x > this->m_min) {
+        k = static_cast<Integer>(std::ceil(this->m_decade*std::log10(x/this->m_min) - 1.0e-12));
+        k = std::min(std::max(k, Integer(0)), BUCKETS);
+      }
+      this->m_counts[k].fetch_add(1, std::memory_order_relaxed);
+      this->m_count.fetch_add(1, std::memory_order_relaxed);
+      double sum{this->m_sum.load(std::memory_order_relaxed)};
+      while (!this->m_sum.compare_exchange_weak(sum, sum + x, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * \brief Get the number of samples.
+     * \return The number of samples.
+     */
+    std::uint64_t count() const {return this->m_count.load(std::memory_order_relaxed);}
+
+    /**
+     * \brief Get the sum of the samples.
+     * \return The sum of the samples.
+     */
+    double sum() const {return this->m_sum.load(std::memory_order_relaxed);}
+
+    /**
+     * \brief Get the number of samples in a bucket.
+     * \param[in] k Bucket index.
+     * \return The number of samples in the bucket.
+     */
+    std::uint64_t bucket(Integer const k) const {return this->m_counts[k].load(std::memory_order_relaxed);}
+
+    /**
+     * \brief Estimate a percentile of the recorded samples.
+     * \param[in] q Percentile in the range [0, 1].
+     * \return The estimated percentile (zero if no sample has been recorded).
+     */
+    double percentile(double const q) const
+    {
+      std::array<std::uint64_t, BUCKETS+1> counts;
+      std::uint64_t total{0};
+      for (Integer k{0}; k <= BUCKETS; ++k) {counts[k] = this->bucket(k); total += counts[k];}
+      if (total == 0) {return 0.0;}
+      double const target{std::min(std::max(q, 0.0), 1.0)*static_cast<double>(total)};
+      double cumulative{0.0};
+      for (Integer k{0}; k <= BUCKETS; ++k) {
+        if (counts[k] == 0) {continue;}
+        if (cumulative + static_cast<double>(counts[k]) >= target) {
+          if (k == 0) {return this->bound(0);}
+          if (k == BUCKETS) {return this->bound(BUCKETS-1);}
+          double const t{(target - cumulative)/static_cast<double>(counts[k])};
+          return this->bound(k-1)*std::pow(this->bound(k)/this->bound(k-1), t);
+        }
+        cumulative += static_cast<double>(counts[k]);
+      }
+      return this->bound(BUCKETS-1);
+    }
+
+    /**
+     * \brief Reset the histogram.
+     * \note Concurrent records may be partially lost while resetting.
+     */
+    void reset()
+    {
+      for (auto & c : this->m_counts) {c.store(0, std::memory_order_relaxed);}
+      this->m_count.store(0, std::memory_order_relaxed);
+      this->m_sum.store(0.0, std::memory_order_relaxed);
+    }
+
+  }; // class Histogram
+
+  /**
+   * \brief Process-wide registry of aggregated solve telemetry.
+   *
+   * The Metrics class collects, for every recorded solve, the number of iterations, function,
+   * gradient and Hessian evaluations, matrix factorizations, the wall time and the termination
+   * status. Recording is lock-free, so that thousands of solves per second from any number of
+   * threads can be aggregated. The registry produces p50/p95/p99 summaries and can be exported
+   * (on demand or periodically) to a file in Prometheus text format or JSON.
+   */
+  class Metrics
+  {
+  public:
+    /**
+     * \brief Export file format.
+     */
+    using Format = enum class Format : Integer {PROMETHEUS = 0, JSON = 1};
+
+    static constexpr Integer STATUSES{7}; /*!< Number of tracked termination statuses. */
+
+  private:
+    using SteadyClock = std::chrono::steady_clock;
+
+    /**
+     * \brief Periodic export configuration.
+     */
+    struct Export
+    {
+      std::string path;      /*!< Export file path. */
+      Format      format;    /*!< Export file format. */
+      double      period;    /*!< Export period in seconds. */
+    };
+
+    Histogram m_iterations{1.0, 8.0};      /*!< Iterations histogram. */
+    Histogram m_functions{1.0, 8.0};       /*!< Function evaluations histogram. */
+    Histogram m_gradients{1.0, 8.0};       /*!< Gradient evaluations histogram. */
+    Histogram m_hessians{1.0, 8.0};        /*!< Hessian evaluations histogram. */
+    Histogram m_factorizations{1.0, 8.0};  /*!< Matrix factorizations histogram. */
+    Histogram m_seconds{1.0e-6, 6.0};      /*!< Wall time histogram (seconds). */
+
+    std::array<std::atomic<std::uint64_t>, STATUSES> m_status{}; /*!< Termination status counters. */
+
+    mutable std::mutex        m_export_mutex;     /*!< Mutex guarding the export configuration. */
+    Export                    m_export;           /*!< Periodic export configuration. */
+    std::atomic<std::int64_t> m_export_period{0}; /*!< Export period (steady clock ticks, 0 if disabled). */
+    std::atomic<std::int64_t> m_last_export{0};   /*!< Last export time (steady clock ticks). */
+
+    /**
+     * \brief Default constructor (private, use instance()).
+     */
+    Metrics() = default;
+
+    /**
+     * \brief Name of a termination status.
+     * \param[in] k Termination status.
+     * \return The name of the termination status.
+     */
+    static char const * statusName(Integer const k)
+    {
+      switch (k) {
+        case 0:  return "none";
+        case 1:  return "optimal";
+        case 2:  return "infeasible";
+        case 3:  return "iteration_limit";
+        case 4:  return "invalid_bounds";
+        case 5:  return "evaluation_error";
+        default: return "other";
+      }
+    }
+
+    /**
+     * \brief Write a histogram in Prometheus text format.
+     * \param[in] os Output stream.
+     * \param[in] name Metric name.
+     * \param[in] help Metric description.
+     * \param[in] h Histogram.
+     */
+    static void writePrometheus(std::ostream & os, std::string const & name, std::string const & help,
+      Histogram const & h)
+    {
+      os << "# HELP " << name << ' ' << help << '\n' << "# TYPE " << name << " histogram\n";
+      std::uint64_t cumulative{0};
+      for (Integer k{0}; k < Histogram::BUCKETS; ++k) {
+        cumulative += h.bucket(k);
+        os << name << "_bucket{le=\"" << h.bound(k) << "\"} " << cumulative << '\n';
+      }
+      cumulative += h.bucket(Histogram::BUCKETS);
+      os << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n'
+         << name << "_sum " << h.sum() << '\n'
+         << name << "_count " << h.count() << '\n'
+         << "# HELP " << name << "_quantile Estimated quantiles of " << name << ".\n"
+         << "# TYPE " << name << "_quantile gauge\n"
+         << name << "_quantile{quantile=\"0.5\"} "  << h.percentile(0.50) << '\n'
+         << name << "_quantile{quantile=\"0.95\"} " << h.percentile(0.95) << '\n'
+         << name << "_quantile{quantile=\"0.99\"} " << h.percentile(0.99) << '\n';
+    }
+
+    /**
+     * \brief Write a histogram summary in JSON format.
+     * \param[in] os Output stream.
+     * \param[in] name Metric name.
+     * \param[in] h Histogram.
+     */
+    static void writeJSON(std::ostream & os, std::string const & name, Histogram const & h)
+    {
+      os << "    \"" << name << "\": {\"count\": " << h.count() << ", \"sum\": " << h.sum()
+         << ", \"p50\": " << h.percentile(0.50) << ", \"p95\": " << h.percentile(0.95)
+         << ", \"p99\": " << h.percentile(0.99) << ", \"buckets\": [";
+      bool first{true};
+      for (Integer k{0}; k <= Histogram::BUCKETS; ++k) {
+        std::uint64_t const n{h.bucket(k)};
+        if (n == 0) {continue;}
+        os << (first ? "" : ", ") << "[";
+        if (k < Histogram::BUCKETS) {os << h.bound(k);} else {os << "\"+Inf\"";}
+        os << ", " << n << "]";
+        first = false;
+      }
+      os << "]}";
+    }
+
+  public:
+    /**
+     * \brief Deleted copy constructor.
+     * \note This class is not copyable.
+     */
+    Metrics(Metrics const &) = delete;
+
+    /**
+     * \brief Deleted assignment operator.
+     * \note This class is not assignable.
+     */
+    Metrics & operator=(Metrics const &) = delete;
+
+    /**
+     * \brief Get the process-wide metrics registry.
+     * \return A reference to the process-wide metrics registry.
+     */
+    static Metrics & instance()
+    {
+      static Metrics metrics;
+      return metrics;
+    }
+
+    /**
+     * \brief Record the statistics of a solve.
+     * \param[in] c Counters of the solve.
+     * \param[in] seconds Wall time of the solve in seconds.
+     * \param[in] status Termination status of the solve.
+     */
+    void record(Counter const & c, double const seconds, Integer const status)
+    {
+      this->m_iterations.record(c.k);
+      this->m_functions.record(c.f);
+      this->m_gradients.record(c.g);
+      this->m_hessians.record(c.H);
+      this->m_factorizations.record(c.M);
+      this->m_seconds.record(seconds);
+      Integer const k{(status >= 0 && status < STATUSES-1) ? status : STATUSES-1};
+      this->m_status[k].fetch_add(1, std::memory_order_relaxed);
+      this->exportIfDue();
+    }
+
+    /**
+     * \brief Get the number of recorded solves.
+     * \return The number of recorded solves.
+     */
+    std::uint64_t solves() const {return this->m_seconds.count();}
+
+    /**
+     * \brief Get the number of recorded solves with a given termination status.
+     * \param[in] status Termination status.
+     * \return The number of recorded solves with the given status.
+     */
+    std::uint64_t status(Integer const status) const
+    {
+      Integer const k{(status >= 0 && status < STATUSES-1) ? status : STATUSES-1};
+      return this->m_status[k].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Get the iterations histogram.
+     * \return The iterations histogram.
+     */
+    Histogram const & iterations() const {return this->m_iterations;}
+
+    /**
+     * \brief Get the wall time histogram (in seconds).
+     * \return The wall time histogram.
+     */
+    Histogram const & seconds() const {return this->m_seconds;}
+
+    /**
+     * \brief Get the matrix factorizations histogram.
+     * \return The matrix factorizations histogram.
+     */
+    Histogram const & factorizations() const {return this->m_factorizations;}
+
+    /**
+     * \brief Reset all the collected metrics.
+     */
+    void reset()
+    {
+      this->m_iterations.reset();
+      this->m_functions.reset();
+      this->m_gradients.reset();
+      this->m_hessians.reset();
+      this->m_factorizations.reset();
+      this->m_seconds.reset();
+      for (auto & s : this->m_status) {s.store(0, std::memory_order_relaxed);}
+    }
+
+    /**
+     * \brief Write the collected metrics to a stream.
+     * \param[in] os Output stream.
+     * \param[in] format Output format.
+     */
+    void write(std::ostream & os, Format const format) const
+    {
+      os << std::setprecision(9);
+      if (format == Format::PROMETHEUS) {
+        os << "# HELP pipal_solves_total Number of recorded solves.\n"
+           << "# TYPE pipal_solves_total counter\n"
+           << "pipal_solves_total " << this->solves() << '\n'
+           << "# HELP pipal_solve_status_total Number of recorded solves by termination status.\n"
+           << "# TYPE pipal_solve_status_total counter\n";
+        for (Integer k{0}; k < STATUSES; ++k) {
+          os << "pipal_solve_status_total{status=\"" << statusName(k) << "\"} " << this->status(k) << '\n';
+        }
+        writePrometheus(os, "pipal_solve_iterations", "Iterations per solve.", this->m_iterations);
+        writePrometheus(os, "pipal_solve_functions", "Function evaluations per solve.", this->m_functions);
+        writePrometheus(os, "pipal_solve_gradients", "Gradient evaluations per solve.", this->m_gradients);
+        writePrometheus(os, "pipal_solve_hessians", "Hessian evaluations per solve.", this->m_hessians);
+        writePrometheus(os, "pipal_solve_factorizations", "Matrix factorizations per solve.",
+          this->m_factorizations);
+        writePrometheus(os, "pipal_solve_seconds", "Wall time per solve in seconds.", this->m_seconds);
+      } else {
+        os << "{\n  \"solves\": " << this->solves() << ",\n  \"status\": {";
+        for (Integer k{0}; k < STATUSES; ++k) {
+          os << (k > 0 ? ", " : "") << '"' << statusName(k) << "\": " << this->status(k);
+        }
+        os << "},\n  \"metrics\": {\n";
+        writeJSON(os, "iterations", this->m_iterations);     os << ",\n";
+        writeJSON(os, "functions", this->m_functions);       os << ",\n";
+        writeJSON(os, "gradients", this->m_gradients);       os << ",\n";
+        writeJSON(os, "hessians", this->m_hessians);         os << ",\n";
+        writeJSON(os, "factorizations", this->m_factorizations); os << ",\n";
+        writeJSON(os, "seconds", this->m_seconds);           os << "\n  }\n}\n";
+      }
+    }
+
+    /**
+     * \brief Export the collected metrics to a file.
+     *
+     * The file is written to a temporary file first and then renamed, so that readers never see a
+     * partially written file. The temporary file name is unique to the calling thread and call, so
+     * that concurrent exports to the same path do not interleave.
+     * \param[in] path Output file path.
+     * \param[in] format Output format.
+     * \return True if the file was written successfully, false otherwise.
+     */
+    bool exportToFile(std::string const & path, Format const format) const
+    {
+      static std::atomic<std::uint64_t> counter{0};
+      std::string const tmp{path + "." +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "." +
+        std::to_string(SteadyClock::now().time_since_epoch().count()) + "." +
+        std::to_string(counter.fetch_add(1, std::memory_order_relaxed)) + ".tmp"};
+      {
+        std::ofstream file(tmp, std::ios::out | std::ios::trunc);
+        if (!file) {return false;}
+        this->write(file, format);
+        if (!file) {std::remove(tmp.c_str()); return false;}
+      }
+      if (std::rename(tmp.c_str(), path.c_str()) != 0) {std::remove(tmp.c_str()); return false;}
+      return true;
+    }
+
+    /**
+     * \brief Enable periodic export of the collected metrics.
+     *
+     * The export is performed by the thread recording a solve once the period has elapsed since the
+     * last export, no background thread is created.
+     * \param[in] path Output file path.
+     * \param[in] format Output format.
+     * \param[in] period Export period in seconds.
+     */
+    void periodicExport(std::string const & path, Format const format, double const period)
+    {
+      PIPAL_ASSERT(period > 0.0,
+        "Pipal::Metrics::periodicExport(...): export period must be positive");
+      std::lock_guard<std::mutex> lock(this->m_export_mutex);
+      this->m_export = Export{path, format, period};
+      this->m_export_period.store(std::max<std::int64_t>(1, std::chrono::duration_cast<SteadyClock::duration>(
+        std::chrono::duration<double>(period)).count()), std::memory_order_release);
+    }
+
+    /**
+     * \brief Disable periodic export of the collected metrics.
+     */
+    void disablePeriodicExport()
+    {
+      std::lock_guard<std::mutex> lock(this->m_export_mutex);
+      this->m_export_period.store(0, std::memory_order_release);
+    }
+
+    /**
+     * \brief Export the collected metrics if the export period has elapsed.
+     *
+     * Only one of the concurrently recording threads performs the export. The configuration mutex is
+     * taken only by that thread, the check itself is a couple of atomic loads.
+     * \return True if an export was performed, false otherwise.
+     */
+    bool exportIfDue()
+    {
+      std::int64_t const period{this->m_export_period.load(std::memory_order_acquire)};
+      if (period == 0) {return false;}
+      std::int64_t const now{SteadyClock::now().time_since_epoch().count()};
+      std::int64_t last{this->m_last_export.load(std::memory_order_relaxed)};
+      if (last != 0 && now - last < period) {return false;}
+      if (!this->m_last_export.compare_exchange_strong(last, now, std::memory_order_relaxed)) {return false;}
+      Export e;
+      {
+        std::lock_guard<std::mutex> lock(this->m_export_mutex);
+        if (this->m_export_period.load(std::memory_order_relaxed) == 0) {return false;}
+        e = this->m_export;
+      }
+      return this->exportToFile(e.path, e.format);
+    }
+
+  }; // class Metrics
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_METRICS_HXX
@@ -38,6 +38,34 @@ namespace Pipal
     std::string    q;            /*!< Quantities header. */
     std::string    n;            /*!< Footer line. */
     TimePoint      t;            /*!< Timer. */
+    bool           e{false};     /*!< Equilibration columns flag. */
+    bool           p{false};     /*!< Trials column flag. */
+
+  /**
+   * \brief Build the line break, quantities header and footer line from the column flags.
+   *
+   * The optional equilibration and trials columns are placed, in this order, before the step
+   * length columns.
+   */
+  void
+  columns() {
+    this->l = "======+=========================+====================================+=========================+===========================================================================+";
+    this->q = "Iter. |  Objective     Infeas.  |  Pen. Par.   I.P. Par.  Opt. Error |    Merit     P.I.P. Err.|    Shift    ||P.Step||  ||D.Step||   Lin. Red.    Quad. Red.    Quality   | ";
+    this->n = "-----------  ---------- | ----------  ----------  ----------  -----------  -----------  ----------- | ";
+    if (this->e) {
+      this->l += "=========================+";
+      this->q += "Eq. Min.    Eq. Max.   | ";
+      this->n += "----------  ---------- | ";
+    }
+    if (this->p) {
+      this->l += "=========+";
+      this->q += "Trials | ";
+      this->n += "------ | ";
+    }
+    this->l += "=======================";
+    this->q += "Pri. Step.  Dual Step.";
+    this->n += "----------  ----------";
+  }
 
   public:
   /**
@@ -45,9 +73,7 @@ namespace Pipal
    */
   Output() {
     this->t = SteadyClock::now();
-    this->l = "======+=========================+====================================+=========================+===========================================================================+=======================";
-    this->q = "Iter. |  Objective     Infeas.  |  Pen. Par.   I.P. Par.  Opt. Error |    Merit     P.I.P. Err.|    Shift    ||P.Step||  ||D.Step||   Lin. Red.    Quad. Red.    Quality   | Pri. Step.  Dual Step.";
-    this->n = "-----------  ---------- | ----------  ----------  ----------  -----------  -----------  ----------- | ----------  ----------";
+    this->columns();
   }
 
   /**
@@ -55,6 +81,26 @@ namespace Pipal
    */
   ~Output() = default;
 
+  /**
+   * \brief Enable or disable the Newton matrix equilibration columns.
+   * \param[in] t_e Equilibration columns flag.
+   */
+  void
+  equilibration(bool const t_e) {
+    this->e = t_e;
+    this->columns();
+  }
+
+  /**
+   * \brief Enable or disable the trial steps column.
+   * \param[in] t_p Trials column flag.
+   */
+  void
+  pruning(bool const t_p) {
+    this->p = t_p;
+    this->columns();
+  }
+
   /**
    * \brief Print problem header information.
    * \param[in] i Problem input structure.
@@ -115,6 +161,26 @@ namespace Pipal
       << d.ltred << "  " << d.qtred << "  " << d.m << std::noshowpos << " | ";
   }
 
+  /**
+   * \brief Print the Newton matrix equilibration statistics.
+   * \param[in] z Current iterate.
+   */
+  void
+  printEquilibration(Iterate<Real> const & z) const {
+    if (z.Ad.size() == 0) {this->s << "----------  ---------- | "; return;}
+    this->s
+      << std::scientific << std::setprecision(4) << z.Ad.minCoeff() << "  " << z.Ad.maxCoeff() << " | ";
+  }
+
+  /**
+   * \brief Print the number of trial steps evaluated in the last step computation.
+   * \param[in] z Current iterate.
+   */
+  void
+  printTrials(Iterate<Real> const & z) const {
+    this->s << std::setw(6) << z.trials << " | ";
+  }
+
   /**
   * \brief Print a single iterate row to the console table.
   * \param[in] c Counters containing the current iteration index.
@@ -141,6 +207,32 @@ namespace Pipal
     this->s << '\n';
   }
 
+  /**
+   * \brief Print the outcome of an active-set polishing attempt.
+   * \param[in] z Current iterate.
+   * \param[in] accepted Whether the polished point was accepted.
+   */
+  void
+  printPolish(Iterate<Real> const & z, bool const accepted) const {
+    this->s
+      << "Polish| active constraints: " << z.active.count() << ", "
+      << (accepted ? "accepted" : "rejected") << ", opt. error: "
+      << std::scientific << std::setprecision(4) << z.kkt[1] << '\n';
+  }
+
+  /**
+   * \brief Print the outcome of a separation round.
+   * \param[in] c Counters containing the separation rounds index.
+   * \param[in] i Problem input structure (extended).
+   * \param[in] added Number of constraints appended by the separation oracle.
+   */
+  void
+  printSeparation(Counter const & c, Input<Real> const & i, Integer const added) const {
+    this->s
+      << "Separ.| round: " << c.S << ", appended constraints: " << added << ", equality constraints: "
+      << i.nE << ", inequality constraints: " << i.nI << '\n';
+  }
+
   /**
    * \brief Print final summary footer and termination message.
    * \param[in] c Counters used during evaluations.
@@ -192,7 +284,20 @@ namespace Pipal
       << "  Function evaluations...................... : " << c.f << '\n'
       << "  Gradient evaluations...................... : " << c.g << '\n'
       << "  Hessian evaluations....................... : " << c.H << '\n'
-      << "  Matrix factorizations..................... : " << c.M << '\n'
+      << "  Matrix factorizations..................... : " << c.M << '\n';
+    if (c.S > 0) {
+      this->s
+        << "  Separation rounds......................... : " << c.S << '\n';
+    }
+    if (this->p) {
+      this->s
+        << "  Trial steps............................... : " << c.T << '\n';
+    }
+    if (c.C > 0) {
+      this->s
+        << "  Centrality correctors..................... : " << c.C << '\n';
+    }
+    this->s
       << "  CPU millseconds........................... : "
       << std::scientific << std::setprecision(4)
       << std::chrono::duration_cast<MicroSeconds>(SteadyClock::now() - this->t).count()/1.0e3
@@ -0,0 +1,575 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_PARALLEL_HXX
+#define INCLUDE_PIPAL_PARALLEL_HXX
+
+// STL
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// POSIX threads (core affinity)
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Pipal
+{
+
+  /**
+   * \brief Interface of the executors running the parallel kernels of the solver.
+   *
+   * An executor runs batches of independent tasks and returns when all the tasks of a batch are
+   * done. Implementing this interface allows to run the solver kernels on the thread pool of the
+   * application (see Solver::executor).
+   */
+  class Executor
+  {
+  public:
+    /**
+     * \brief Executor destructor.
+     */
+    virtual ~Executor() = default;
+
+    /**
+     * \brief Get the number of threads that take part in a batch (including the calling thread).
+     * \return The number of threads.
+     */
+    virtual Integer size() const = 0;
+
+    /**
+     * \brief Execute a batch of tasks and wait for its completion.
+     * \param[in] tasks Number of tasks.
+     * \param[in] task Task function, called once with each index in [0, tasks).
+     * \note The task function must not throw.
+     */
+    virtual void run(Integer const tasks, std::function<void(Integer)> const & task) = 0;
+
+  }; // class Executor
+
+  /**
+   * \brief Minimal fork-join thread pool.
+   *
+   * The ThreadPool class owns a fixed number of worker threads and executes batches of independent
+   * tasks. The calling thread takes part in the execution of the batch, so that a pool of size
+   * \f$ n \f$ creates \f$ n-1 \f$ workers. Only one batch can be run at a time.
+   */
+  class ThreadPool : public Executor
+  {
+    std::vector<std::thread>            m_workers;         /*!< Worker threads. */
+    std::mutex                          m_mutex;           /*!< Batch state mutex. */
+    std::condition_variable             m_cv_task;         /*!< Task availability condition. */
+    std::condition_variable             m_cv_done;         /*!< Batch completion condition. */
+    std::function<void(Integer)> const * m_task{nullptr};  /*!< Current batch task. */
+    Integer                             m_tasks{0};        /*!< Number of tasks in the batch. */
+    Integer                             m_next{0};         /*!< Next task to be executed. */
+    Integer                             m_active{0};       /*!< Number of tasks being executed. */
+    bool                                m_stop{false};     /*!< Stop flag. */
+
+    /**
+     * \brief Execute the tasks of the current batch until none is left.
+     * \param[in] lock Lock on the batch state mutex (held on entry and exit).
+     */
+    void drain(std::unique_lock<std::mutex> & lock)
+    {
+      while (this->m_next < this->m_tasks) {
+        Integer const k{this->m_next++};
+        std::function<void(Integer)> const & task{*this->m_task};
+        ++this->m_active;
+        lock.unlock();
+        task(k);
+        lock.lock();
+        --this->m_active;
+      }
+      if (this->m_active == 0) {this->m_cv_done.notify_all();}
+    }
+
+  public:
+    /**
+     * \brief ThreadPool constructor.
+     * \param[in] t_threads Total number of threads (including the calling thread).
+     */
+    explicit ThreadPool(Integer const t_threads)
+    {
+      PIPAL_ASSERT(t_threads > 0,
+        "Pipal::ThreadPool::ThreadPool(...): number of threads must be positive");
+      for (Integer k{1}; k < t_threads; ++k) {
+        this->m_workers.emplace_back([this] () {
+          std::unique_lock<std::mutex> lock(this->m_mutex);
+          while (true) {
+            this->m_cv_task.wait(lock, [this] () {return this->m_stop || this->m_next < this->m_tasks;});
+            if (this->m_stop) {return;}
+            this->drain(lock);
+          }
+        });
+      }
+    }
+
+    /**
+     * \brief Deleted copy constructor.
+     * \note This class is not copyable.
+     */
+    ThreadPool(ThreadPool const &) = delete;
+
+    /**
+     * \brief Deleted assignment operator.
+     * \note This class is not assignable.
+     */
+    ThreadPool & operator=(ThreadPool const &) = delete;
+
+    /**
+     * \brief ThreadPool destructor (joins the workers).
+     */
+    ~ThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_stop = true;
+      }
+      this->m_cv_task.notify_all();
+      for (std::thread & t : this->m_workers) {t.join();}
+    }
+
+    /**
+     * \brief Get the total number of threads (including the calling thread).
+     * \return The total number of threads.
+     */
+    Integer size() const override {return static_cast<Integer>(this->m_workers.size()) + 1;}
+
+    /**
+     * \brief Execute a batch of tasks and wait for its completion.
+     * \param[in] tasks Number of tasks.
+     * \param[in] task Task function, called once with each index in [0, tasks).
+     * \note The task function must not throw.
+     */
+    void run(Integer const tasks, std::function<void(Integer)> const & task) override
+    {
+      if (tasks <= 0) {return;}
+      if (tasks == 1 || this->m_workers.empty()) {for (Integer k{0}; k < tasks; ++k) {task(k);} return;}
+      std::unique_lock<std::mutex> lock(this->m_mutex);
+      this->m_task  = &task;
+      this->m_tasks = tasks;
+      this->m_next  = 0;
+      this->m_cv_task.notify_all();
+      this->drain(lock);
+      this->m_cv_done.wait(lock, [this] () {return this->m_next >= this->m_tasks && this->m_active == 0;});
+      this->m_task  = nullptr;
+      this->m_tasks = 0;
+      this->m_next  = 0;
+    }
+
+  }; // class ThreadPool
+
+  /**
+   * \brief Work-stealing thread pool shared by several solvers.
+   *
+   * Each worker owns a queue of tasks. The tasks of a batch are spread over the queues, the workers
+   * execute the tasks of their own queue first and steal from the other queues when it is empty.
+   * Batches can be run concurrently from any thread, and from within the tasks themselves. The
+   * calling thread executes queued tasks while waiting for its batch, so that nested and concurrent
+   * batches neither deadlock nor need further threads, and it sleeps when there is nothing left to
+   * execute. Hence, a single pool sized to the machine
+   * can serve all the solvers of a process without oversubscription (see \c shared).
+   */
+  class WorkStealingPool : public Executor
+  {
+    /**
+     * \brief Batch of tasks being executed.
+     */
+    struct Batch
+    {
+      std::function<void(Integer)> const * task;    /*!< Task function. */
+      std::atomic<Integer>                 pending; /*!< Number of tasks not yet completed. */
+      bool                                 done;    /*!< Completion flag (guarded by the sleep mutex). */
+    };
+
+    static constexpr Integer SPIN{64}; /*!< Idle polls of the queues before a waiting caller sleeps. */
+
+    /**
+     * \brief Task of a batch.
+     */
+    struct Job
+    {
+      Batch * batch; /*!< Batch of the task. */
+      Integer index; /*!< Index of the task in the batch. */
+    };
+
+    /**
+     * \brief Queue of tasks owned by a worker.
+     */
+    struct Queue
+    {
+      std::mutex      mutex; /*!< Queue mutex. */
+      std::deque<Job> jobs;  /*!< Queued tasks. */
+    };
+
+    std::vector<std::thread>            m_workers;      /*!< Worker threads. */
+    std::vector<std::unique_ptr<Queue>> m_queues;       /*!< Task queues (one per worker). */
+    std::mutex                          m_mutex;        /*!< Sleep mutex. */
+    std::condition_variable             m_cv;           /*!< Task availability and batch completion condition. */
+    std::atomic<Integer>                m_queued{0};    /*!< Number of queued tasks. */
+    std::atomic<Integer>                m_next{0};      /*!< First queue of the next batch. */
+    bool                                m_stop{false};  /*!< Stop flag. */
+
+    /**
+     * \brief Get the pool and the queue index of the current thread.
+     * \return The pool (null if the thread is not a worker) and the queue index of the thread.
+     */
+    static std::pair<WorkStealingPool const *, Integer> & worker()
+    {
+      static thread_local std::pair<WorkStealingPool const *, Integer> w{nullptr, -1};
+      return w;
+    }
+
+    /**
+     * \brief Execute a queued task, from the own queue (newest first) or stolen from another queue
+     * (oldest first).
+     * \param[in] self Queue index of the current thread (-1 if it is not a worker).
+     * \return True if a task was executed, false if all the queues are empty.
+     */
+    bool execute(Integer const self)
+    {
+      Integer const n{static_cast<Integer>(this->m_queues.size())};
+      Job job{nullptr, 0};
+      for (Integer k{0}; k < n && job.batch == nullptr; ++k) {
+        Integer const q{self >= 0 ? (self + k) % n : k};
+        Queue & queue{*this->m_queues[q]};
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) {continue;}
+        if (q == self) {job = queue.jobs.back(); queue.jobs.pop_back();}
+        else {job = queue.jobs.front(); queue.jobs.pop_front();}
+      }
+      if (job.batch == nullptr) {return false;}
+      --this->m_queued;
+      (*job.batch->task)(job.index);
+
+      // The last task wakes the caller of the batch (the batch must not be accessed afterwards)
+      if (job.batch->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        {
+          std::lock_guard<std::mutex> lock(this->m_mutex);
+          job.batch->done = true;
+        }
+        this->m_cv.notify_all();
+      }
+      return true;
+    }
+
+  public:
+    /**
+     * \brief WorkStealingPool constructor.
+     * \param[in] t_threads Total number of threads (including the calling thread).
+     * \param[in] t_affinity Pin each worker to a core (Linux only, ignored elsewhere).
+     */
+    explicit WorkStealingPool(Integer const t_threads, bool const t_affinity = false)
+    {
+      PIPAL_ASSERT(t_threads > 0,
+        "Pipal::WorkStealingPool::WorkStealingPool(...): number of threads must be positive");
+      for (Integer k{1}; k < t_threads; ++k) {this->m_queues.emplace_back(std::make_unique<Queue>());}
+      for (Integer k{0}; k+1 < t_threads; ++k) {
+        this->m_workers.emplace_back([this, k] () {
+          worker() = {this, k};
+          while (true) {
+            if (this->execute(k)) {continue;}
+            std::unique_lock<std::mutex> lock(this->m_mutex);
+            this->m_cv.wait(lock, [this] () {return this->m_stop || this->m_queued > 0;});
+            if (this->m_stop) {return;}
+          }
+        });
+        #if defined(__linux__)
+        if (t_affinity) {
+          // Spread the workers of successive pools over the cores
+          static std::atomic<unsigned> core{0};
+          cpu_set_t set;
+          CPU_ZERO(&set);
+          CPU_SET((core.fetch_add(1) + 1) % std::max(1u, std::thread::hardware_concurrency()), &set);
+          pthread_setaffinity_np(this->m_workers.back().native_handle(), sizeof(cpu_set_t), &set);
+        }
+        #else
+        static_cast<void>(t_affinity);
+        #endif
+      }
+    }
+
+    /**
+     * \brief Deleted copy constructor.
+     * \note This class is not copyable.
+     */
+    WorkStealingPool(WorkStealingPool const &) = delete;
+
+    /**
+     * \brief Deleted assignment operator.
+     * \note This class is not assignable.
+     */
+    WorkStealingPool & operator=(WorkStealingPool const &) = delete;
+
+    /**
+     * \brief WorkStealingPool destructor (joins the workers).
+     */
+    ~WorkStealingPool() override
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_stop = true;
+      }
+      this->m_cv.notify_all();
+      for (std::thread & t : this->m_workers) {t.join();}
+    }
+
+    /**
+     * \brief Get the process-wide pool, with one thread per hardware thread.
+     * \return The process-wide pool.
+     */
+    static std::shared_ptr<WorkStealingPool> shared()
+    {
+      static std::shared_ptr<WorkStealingPool> const pool{std::make_shared<WorkStealingPool>(
+        std::max<Integer>(1, static_cast<Integer>(std::thread::hardware_concurrency())))};
+      return pool;
+    }
+
+    /**
+     * \brief Get the total number of threads (including the calling thread).
+     * \return The total number of threads.
+     */
+    Integer size() const override {return static_cast<Integer>(this->m_workers.size()) + 1;}
+
+    /**
+     * \brief Execute a batch of tasks and wait for its completion.
+     *
+     * The batch can be run from any thread, also concurrently with other batches and from within a
+     * task of another batch.
+     * \param[in] tasks Number of tasks.
+     * \param[in] task Task function, called once with each index in [0, tasks).
+     * \note The task function must not throw.
+     */
+    void run(Integer const tasks, std::function<void(Integer)> const & task) override
+    {
+      if (tasks <= 0) {return;}
+      if (tasks == 1 || this->m_workers.empty()) {for (Integer k{0}; k < tasks; ++k) {task(k);} return;}
+
+      // Spread the tasks over the queues
+      Batch batch{&task, {tasks}, false};
+      Integer const n{static_cast<Integer>(this->m_queues.size())};
+      Integer const first{this->m_next.fetch_add(1) % n};
+      for (Integer k{0}; k < tasks; ++k) {
+        Queue & queue{*this->m_queues[(first + k) % n]};
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(Job{&batch, k});
+      }
+      this->m_queued += tasks;
+      {std::lock_guard<std::mutex> lock(this->m_mutex);}
+      this->m_cv.notify_all();
+
+      // Execute queued tasks until the batch is completed, and sleep after a short spin when the
+      // queues are empty (a sleeping caller is woken by new tasks to keep nested batches going)
+      Integer const self{worker().first == this ? worker().second : -1};
+      for (Integer spin{0}; batch.pending.load(std::memory_order_acquire) > 0;) {
+        if (this->execute(self)) {spin = 0; continue;}
+        if (++spin < SPIN) {std::this_thread::yield(); continue;}
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        this->m_cv.wait(lock, [this, &batch] () {return batch.done || this->m_queued > 0;});
+        spin = 0;
+      }
+
+      // Wait for the last task to release the batch
+      std::unique_lock<std::mutex> lock(this->m_mutex);
+      this->m_cv.wait(lock, [&batch] () {return batch.done;});
+    }
+
+  }; // class WorkStealingPool
+
+  /**
+   * \brief Executor bounding the number of threads that take part in the batches of another one.
+   *
+   * The batches are run by the underlying executor, while the kernels split their work in at most
+   * as many tasks as the bound. Several solvers can thus share a single pool (e.g., the
+   * \c WorkStealingPool::shared() one), each with its own number of threads.
+   */
+  class LimitedExecutor : public Executor
+  {
+    std::shared_ptr<Executor> m_base; /*!< Underlying executor. */
+    Integer                   m_size; /*!< Maximum number of threads. */
+
+  public:
+    /**
+     * \brief LimitedExecutor constructor.
+     * \param[in] t_base Underlying executor.
+     * \param[in] t_size Maximum number of threads (including the calling thread).
+     */
+    LimitedExecutor(std::shared_ptr<Executor> t_base, Integer const t_size)
+      : m_base(std::move(t_base)), m_size(t_size)
+    {
+      PIPAL_ASSERT(this->m_base && t_size > 0,
+        "Pipal::LimitedExecutor::LimitedExecutor(...): invalid executor or number of threads");
+    }
+
+    /**
+     * \brief Get the number of threads that take part in a batch (including the calling thread).
+     * \return The number of threads.
+     */
+    Integer size() const override {return std::min(this->m_size, this->m_base->size());}
+
+    /**
+     * \brief Execute a batch of tasks on the underlying executor and wait for its completion.
+     * \param[in] tasks Number of tasks.
+     * \param[in] task Task function, called once with each index in [0, tasks).
+     * \note The task function must not throw.
+     */
+    void run(Integer const tasks, std::function<void(Integer)> const & task) override
+    {
+      this->m_base->run(tasks, task);
+    }
+
+  }; // class LimitedExecutor
+
+  /**
+   * \brief Sequence lock holding a trivially copyable value.
+   *
+   * A single writer publishes new values without blocking, while any number of readers get
+   * consistent copies from any thread, retrying if a write happened during the copy. The value is
+   * stored in atomic words, so that concurrent reads and writes are free of data races.
+   * \tparam T Type of the value (trivially copyable).
+   */
+  template <typename T>
+  class SeqLock
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Pipal::SeqLock<T>: T must be trivially copyable.");
+
+    static constexpr std::size_t WORDS{(sizeof(T) + sizeof(std::uint64_t) - 1)/sizeof(std::uint64_t)};
+
+    std::atomic<std::uint64_t>                      m_seq{0}; /*!< Sequence number (odd while writing). */
+    std::array<std::atomic<std::uint64_t>, WORDS>   m_data{}; /*!< Value words. */
+
+  public:
+    /**
+     * \brief Publish a new value (single writer).
+     * \param[in] value Value.
+     */
+    void store(T const & value)
+    {
+      std::uint64_t words[WORDS]{};
+      std::memcpy(words, &value, sizeof(T));
+      std::uint64_t const seq{this->m_seq.load(std::memory_order_relaxed)};
+      this->m_seq.store(seq + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      for (std::size_t k{0}; k < WORDS; ++k) {this->m_data[k].store(words[k], std::memory_order_relaxed);}
+      this->m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * \brief Get a consistent copy of the last published value.
+     * \return The value.
+     */
+    T load() const
+    {
+      std::uint64_t words[WORDS];
+      std::uint64_t seq0, seq1;
+      do {
+        seq0 = this->m_seq.load(std::memory_order_acquire);
+        for (std::size_t k{0}; k < WORDS; ++k) {words[k] = this->m_data[k].load(std::memory_order_relaxed);}
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq1 = this->m_seq.load(std::memory_order_relaxed);
+      } while ((seq0 & 1) != 0 || seq0 != seq1);
+      T value;
+      std::memcpy(&value, words, sizeof(T));
+      return value;
+    }
+
+  }; // class SeqLock
+
+  /**
+   * \brief Execute a kernel on contiguous chunks of a range, one chunk per thread.
+   *
+   * If the cumulative weights of the range items are given (e.g., the outer index pointer of a
+   * compressed sparse matrix), the chunks are balanced with respect to the weights, otherwise they
+   * have the same number of items.
+   * \tparam Index Type of the cumulative weights.
+   * \tparam Kernel Kernel function type, called as \c kernel(begin, end).
+   * \param[in] pool Executor (serial execution if null).
+   * \param[in] n Number of items in the range.
+   * \param[in] ptr Cumulative weights of the items (size \f$ n+1 \f$, may be null).
+   * \param[in] kernel Kernel function.
+   */
+  template <typename Index, typename Kernel>
+  static void parallel_ranges(Executor * pool, Integer const n, Index const * ptr, Kernel && kernel)
+  {
+    // Serial execution
+    Integer const threads{pool != nullptr ? std::min(pool->size(), n) : 1};
+    if (threads <= 1) {kernel(Integer(0), n); return;}
+
+    // Split the range in chunks with balanced weights
+    std::vector<Integer> bounds(threads+1, n);
+    bounds[0] = 0;
+    if (ptr != nullptr) {
+      double const total{static_cast<double>(ptr[n] - ptr[0])};
+      for (Integer t{1}, o{0}; t < threads; ++t) {
+        double const target{total*static_cast<double>(t)/static_cast<double>(threads)};
+        while (o < n && static_cast<double>(ptr[o] - ptr[0]) < target) {++o;}
+        bounds[t] = std::max(o, bounds[t-1]);
+      }
+    } else {
+      for (Integer t{1}; t < threads; ++t) {bounds[t] = (n*t)/threads;}
+    }
+
+    // Parallel execution
+    pool->run(threads, [&kernel, &bounds] (Integer const t) {kernel(bounds[t], bounds[t+1]);});
+  }
+
+  /**
+   * \brief Compute the outer dot products of a sparse matrix with a dense vector.
+   *
+   * For each outer index \f$ o \f$ (a row for row-major storage, a column for column-major storage)
+   * the function computes \f$ y_o = \sum_k a_{ok} x_k \f$. Hence, \f$ \mathbf{y} = \mathbf{Ax} \f$
+   * for a row-major (CSR) matrix, and \f$ \mathbf{y} = \mathbf{A}^\top \mathbf{x} \f$ for a
+   * column-major (CSC) matrix. The outer range is split into contiguous chunks with balanced number
+   * of nonzeros, one per thread. Each entry of the result is accumulated by a single thread in the
+   * storage order, so that the result does not depend on the number of threads and matches the
+   * serial Eigen product.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \tparam Options Storage options of the sparse matrix.
+   * \param[in] pool Executor (serial execution if null).
+   * \param[in] A Sparse matrix.
+   * \param[in] x Dense vector.
+   * \param[out] y Vector of outer dot products.
+   */
+  template <typename Real, int Options>
+  static void outer_product(Executor * pool, Eigen::SparseMatrix<Real, Options> const & A,
+    Vector<Real> const & x, Vector<Real> & y)
+  {
+    using InnerIterator = typename Eigen::SparseMatrix<Real, Options>::InnerIterator;
+
+    // Outer dot products on a contiguous range
+    Integer const outer{static_cast<Integer>(A.outerSize())};
+    y.resize(outer);
+    auto kernel = [&A, &x, &y] (Integer const begin, Integer const end) {
+      for (Integer o{begin}; o < end; ++o) {
+        Real tmp{0.0};
+        for (InnerIterator it(A, o); it; ++it) {tmp += it.value()*x[it.index()];}
+        y[o] = tmp;
+      }
+    };
+
+    // Execute on chunks with balanced number of nonzeros
+    parallel_ranges(pool, outer, A.isCompressed() ? A.outerIndexPtr() : nullptr, kernel);
+  }
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_PARALLEL_HXX
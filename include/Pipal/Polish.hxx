@@ -0,0 +1,194 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_POLISH_HXX
+#define INCLUDE_PIPAL_POLISH_HXX
+
+namespace Pipal
+{
+
+  /**
+   * \brief Identify the active inequality constraints and track the active set stability.
+   *
+   * An inequality constraint is active if its multiplier dominates its slack. The active set is
+   * considered stable when it does not change between iterations and no constraint is penalized,
+   * i.e., no multiplier is at its penalty bound.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::evalActiveSet()
+  {
+    // Create alias for easier access
+    Input<Real>   & i{this->m_input};
+    Iterate<Real> & z{this->m_iterate};
+
+    // Check for penalized constraints
+    bool penalized{false};
+    if (i.nE > 0) {penalized = penalized || (z.r1 >= 1.0 + z.lE).any() || (z.r2 >= 1.0 - z.lE).any();}
+    if (i.nI > 0) {penalized = penalized || (z.s2 >= 1.0 - z.lI).any();}
+
+    // Identify active inequality constraints
+    Mask active(z.s1 < z.lI);
+
+    // Update active set stability counter
+    if (!penalized && active.size() == z.active.size() && (active == z.active).all()) {++z.active_k;}
+    else {z.active_k = 0;}
+    z.active = std::move(active);
+  }
+
+  /**
+   * \brief Polish the current iterate on the identified active set.
+   *
+   * Solves the equality-constrained problem in which the active inequality constraints and the
+   * equality constraints hold with equality, and the inactive inequality constraints are dropped,
+   * by a few Newton iterations on the reduced KKT system
+   * \f[
+   *   \begin{bmatrix} \mathbf{H} & \mathbf{J}_\mathcal{A}^\top \\ \mathbf{J}_\mathcal{A} &
+   *   \mathbf{0} \end{bmatrix} \begin{bmatrix} \Delta\mathbf{x} \\ \Delta\boldsymbol{\lambda}_
+   *   \mathcal{A} \end{bmatrix} = -\begin{bmatrix} \rho\nabla f + \mathbf{J}_\mathcal{A}^\top
+   *   \boldsymbol{\lambda}_\mathcal{A} \\ \mathbf{c}_\mathcal{A} \end{bmatrix} \text{.}
+   * \f]
+   * The polished point is accepted if, at every iteration, the multipliers are within their bounds
+   * and the optimality and feasibility errors improve, otherwise the iterate is restored.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \return True if the polished point is accepted, false otherwise.
+   */
+  template <typename Real, typename ProblemT>
+  bool Solver<Real, ProblemT>::polishSolution()
+  {
+    // Create alias for easier access
+    Parameter<Real> & p{this->m_parameter};
+    Input<Real>     & i{this->m_input};
+    Iterate<Real>   & z{this->m_iterate};
+
+    // Reset active set stability counter
+    z.active_k = 0;
+
+    // Indices of active inequality constraints
+    Indices const act(find(z.active));
+    Integer const nA{static_cast<Integer>(act.size())};
+    Indices pos(Indices::Constant(i.nI, -1));
+    for (Integer k{0}; k < nA; ++k) {pos(act(k)) = k;}
+
+    // Store current iterate
+    Vector<Real> const x(z.x), g(z.g);
+    Array<Real> const r1(z.r1), r2(z.r2), s1(z.s1), s2(z.s2), lE(z.lE), lI(z.lI);
+    Array<Real> const cE(z.cE), cEu(z.cEu), cI(z.cI), cIu(z.cIu);
+    SparseMatrix<Real> const JE(z.JE), JI(z.JI), H(z.H);
+    Vector<Real> const kkt(z.kkt);
+    Real const f{z.f}, fu{z.fu}, mu{z.mu}, v{z.v}, vu{z.vu}, phi{z.phi};
+
+    // Drop inactive inequality constraints
+    for (Integer k{0}; k < i.nI; ++k) {if (pos(k) < 0) {z.lI(k) = 0.0;}}
+
+    // Newton iterations on the active set
+    Real err_prev{std::max(kkt(1), v)};
+    bool accepted{false};
+    Integer const n{i.nV+i.nE+nA};
+    for (Integer it{0}; it < p.polish_iter_max; ++it)
+    {
+      // Evaluate Hessian of the Lagrangian
+      accepted = false;
+      if (!this->m_bfgs) {
+        this->evalHessian();
+        if (z.err > 0) {break;}
+      }
+
+      // Assemble lower triangle of the reduced KKT matrix
+      std::vector<Eigen::Triplet<Real>> triplets;
+      triplets.reserve(z.H.nonZeros() + z.JE.nonZeros() + z.JI.nonZeros() + i.nE + nA);
+      for (Integer c{0}; c < z.H.outerSize(); ++c) {
+        for (typename SparseMatrix<Real>::InnerIterator it_H(z.H, c); it_H; ++it_H) {
+          if (it_H.row() >= c) {triplets.emplace_back(it_H.row(), c, it_H.value());}
+        }
+      }
+      for (Integer c{0}; c < z.JE.outerSize(); ++c) {
+        for (typename SparseMatrix<Real>::InnerIterator it_J(z.JE, c); it_J; ++it_J) {
+          triplets.emplace_back(i.nV + it_J.row(), c, it_J.value());
+        }
+      }
+      for (Integer c{0}; c < z.JI.outerSize(); ++c) {
+        for (typename SparseMatrix<Real>::InnerIterator it_J(z.JI, c); it_J; ++it_J) {
+          if (pos(it_J.row()) >= 0) {triplets.emplace_back(i.nV + i.nE + pos(it_J.row()), c, it_J.value());}
+        }
+      }
+      for (Integer k{i.nV}; k < n; ++k) {triplets.emplace_back(k, k, -p.shift_min);}
+      SparseMatrix<Real> K(n, n);
+      K.setFromTriplets(triplets.begin(), triplets.end());
+
+      // Factorize and check inertia (reduced Hessian must be positive definite)
+      SparseLDLT<Real> ldlt;
+      ldlt.pool(K.nonZeros() >= p.par_nnz_min ? this->m_pool.get() : nullptr);
+      ldlt.compute(K);
+      this->incrementFactorizationCount();
+      if (ldlt.info() != Eigen::Success ||
+          (ldlt.vectorD().array() < 0.0).count() != i.nE+nA) {break;}
+
+      // Assemble right-hand side
+      Vector<Real> b(n), Jl;
+      b.head(i.nV) = z.rho*z.g;
+      if (i.nE > 0) {
+        this->evalTransposeProduct(z.JE, z.lE.matrix(), Jl); b.head(i.nV) += Jl;
+        b.segment(i.nV, i.nE) = z.cE;
+      }
+      if (i.nI > 0) {this->evalTransposeProduct(z.JI, z.lI.matrix(), Jl); b.head(i.nV) += Jl;}
+      for (Integer k{0}; k < nA; ++k) {b(i.nV+i.nE+k) = z.cI(act(k));}
+
+      // Solve reduced KKT system and update primal-dual point
+      Vector<Real> const dir(ldlt.solve(-b));
+      z.x += dir.head(i.nV);
+      if (i.nE > 0) {z.lE += dir.segment(i.nV, i.nE).array();}
+      for (Integer k{0}; k < nA; ++k) {z.lI(act(k)) += dir(i.nV+i.nE+k);}
+
+      // Check multipliers bounds
+      if ((z.lE.abs() >= 1.0).any() || (z.lI < 0.0).any() || (z.lI >= 1.0).any()) {break;}
+
+      // Evaluate functions and gradients
+      this->evalFunctions();
+      if (z.err > 0) {break;}
+      this->evalInfeasibility(z);
+      this->evalGradients();
+      if (z.err > 0) {break;}
+
+      // Evaluate quantities for the smallest interior-point parameter
+      z.mu = p.mu_min;
+      this->evalDependent();
+
+      // Check for errors improvement
+      Real const err{std::max(z.kkt(1), z.v)};
+      if (!std::isfinite(err) || err >= err_prev) {break;}
+      accepted = true;
+      err_prev = err;
+      if (err <= p.opt_err_tol) {break;}
+    }
+
+    // Restore interior-point parameter and set inactive constraint multipliers on the central path
+    if (accepted) {
+      z.mu = mu;
+      for (Integer k{0}; k < i.nI; ++k) {if (pos(k) < 0) {z.lI(k) = z.mu/z.s1(k);}}
+      this->evalDependent();
+      if (this->m_bfgs) {z.H = H;}
+      return true;
+    }
+
+    // Restore iterate
+    this->setPrimals(x, r1, r2, s1, s2, lE, lI, f, cE, cI, phi);
+    z.g = g; z.fu = fu; z.cEu = cEu; z.cIu = cIu;
+    z.JE = JE; z.JI = JI; z.H = H;
+    this->evalRowMajorCopies();
+    z.kkt = kkt; z.mu = mu; z.v = v; z.vu = vu; z.err = 0;
+    return false;
+  }
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_POLISH_HXX
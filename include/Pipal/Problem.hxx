@@ -130,6 +130,63 @@ namespace Pipal {
      */
     virtual bool lagrangian_hessian(Vector<Real> const & x, Vector<Real> const & l, SparseMatrix<Real> & out) const = 0;
 
+    /**
+     * \brief Read-only view of a constant Jacobian of the constraints function.
+     *
+     * Problems with linear constraints may expose the storage of their Jacobian, so that the solver
+     * reads it in place instead of evaluating \c constraints_jacobian into a temporary matrix.
+     * \return A pointer to the Jacobian view, or null if the Jacobian is not constant (default).
+     */
+    virtual SparseMap<Real> const * constraints_jacobian_view() const {return nullptr;}
+
+    /**
+     * \brief Read-only view of a constant Hessian of the Lagrangian function.
+     *
+     * Problems with quadratic objective and linear constraints may expose the storage of their
+     * Hessian, so that the solver reads it in place instead of evaluating \c lagrangian_hessian into
+     * a temporary matrix.
+     * \return A pointer to the Hessian view, or null if the Hessian is not constant (default).
+     */
+    virtual SparseMap<Real> const * lagrangian_hessian_view() const {return nullptr;}
+
+    /**
+     * \brief Evaluate the Jacobian of the constraints function in place and view it.
+     *
+     * Problems owning the storage of their Jacobian may evaluate it in place at the given point and
+     * expose it, so that the solver reads it without copying it into a temporary matrix. The view
+     * must stay valid until the next evaluation.
+     * \param[in] x Primal variables.
+     * \param[out] out A pointer to the Jacobian view, or null if not available (the constant view by
+     * default, see \c constraints_jacobian_view).
+     * \return True if the evaluation was successful, false otherwise.
+     */
+    virtual bool constraints_jacobian_view_at(Vector<Real> const & x, SparseMap<Real> const * & out) const
+    {
+      static_cast<void>(x);
+      out = this->constraints_jacobian_view();
+      return true;
+    }
+
+    /**
+     * \brief Evaluate the Hessian of the Lagrangian function in place and view it.
+     *
+     * Problems owning the storage of their Hessian may evaluate it in place at the given point and
+     * expose it, so that the solver reads it without copying it into a temporary matrix. The view
+     * must stay valid until the next evaluation.
+     * \param[in] x Primal variables.
+     * \param[in] l Dual variables.
+     * \param[out] out A pointer to the Hessian view, or null if not available (the constant view by
+     * default, see \c lagrangian_hessian_view).
+     * \return True if the evaluation was successful, false otherwise.
+     */
+    virtual bool lagrangian_hessian_view_at(Vector<Real> const & x, Vector<Real> const & l,
+      SparseMap<Real> const * & out) const
+    {
+      static_cast<void>(x); static_cast<void>(l);
+      out = this->lagrangian_hessian_view();
+      return true;
+    }
+
     /**
      * \brief Lower bounds on the primal variables.
      * \param[out] out The lower bounds on the primal variables.
@@ -158,6 +215,29 @@ namespace Pipal {
      */
     virtual bool constraints_upper_bounds(Vector<Real> & out) const = 0;
 
+    /**
+     * \brief Separation oracle for lazily generated constraints.
+     *
+     * Problems with a huge set of candidate constraints may start from a small working set and expose
+     * the remaining candidates through this oracle. The solver calls it at each optimal point of the
+     * current working set, the oracle must append the candidate constraints violated at the given
+     * point to the end of the constraints vector (so that the constraints function, Jacobian, Hessian
+     * and bounds account for them from now on) and return their number.
+     * \param[in] x Primal variables.
+     * \return The number of appended constraints (zero if no candidate constraint is violated).
+     */
+    virtual Integer separate(Vector<Real> const & x) {static_cast<void>(x); return 0;}
+
+    /**
+     * \brief Parameters defining the problem instance.
+     *
+     * Parametric problems may expose the data their functions depend on, so that the solution cache
+     * can identify identical or similar instances (together with the bounds).
+     * \param[out] out The problem parameters (empty if the problem is not parametric).
+     * \return True if the evaluation was successful, false otherwise.
+     */
+    virtual bool parameters(Vector<Real> & out) const {out.resize(0); return true;}
+
   }; // class Problem
 
   /**
@@ -177,6 +257,7 @@ namespace Pipal {
     using ConstraintsJacobianFunc = std::function<bool(Vector<Real> const &, SparseMatrix<Real> &)>;
     using LagrangianHessianFunc   = std::function<bool(Vector<Real> const &, Vector<Real> const &, SparseMatrix<Real> &)>;
     using BoundsFunc              = std::function<bool(Vector<Real> &)>;
+    using SeparationFunc          = std::function<Integer(Vector<Real> const &)>;
 
   private:
     // Problem functions
@@ -192,6 +273,9 @@ namespace Pipal {
     BoundsFunc m_constraints_lower_bounds{nullptr}; /*!< Lower bounds on the constraints. */
     BoundsFunc m_constraints_upper_bounds{nullptr}; /*!< Upper bounds on the constraints. */
 
+    // Separation oracle
+    SeparationFunc m_separation{nullptr}; /*!< Separation oracle (optional). */
+
   public:
     /**
      * \brief Constructor for the ProblemWrapper class (without the Hessian of the Lagrangian).
@@ -373,6 +457,21 @@ namespace Pipal {
       this->m_lagrangian_hessian = lagrangian_hessian;
     }
 
+    /**
+     * \brief Get the separation oracle.
+     * \return The separation oracle.
+     */
+    SeparationFunc & separation() {return this->m_separation;}
+
+    /**
+     * \brief Set the separation oracle.
+     * \param[in] separation The separation oracle to set.
+     */
+    void separation(SeparationFunc const & separation)
+    {
+      this->m_separation = separation;
+    }
+
     /**
      * \brief Evaluate the objective function.
      * \param[in] x Primal variables.
@@ -470,8 +569,183 @@ namespace Pipal {
       return this->m_constraints_upper_bounds(out);
     }
 
+    /**
+     * \brief Separation oracle for lazily generated constraints.
+     * \param[in] x Primal variables.
+     * \return The number of appended constraints (zero if no oracle is set).
+     */
+    Integer separate(Vector<Real> const & x) override
+    {
+      return this->m_separation ? this->m_separation(x) : 0;
+    }
+
   }; // class ProblemWrapper
 
+  /**
+   * \brief Static (CRTP) problem class for the Pipal library.
+   *
+   * The StaticProblem class is the compile-time counterpart of the Problem class. The derived class
+   * implements the same methods as the Problem class (\c objective, \c objective_gradient,
+   * \c constraints, \c constraints_jacobian, \c lagrangian_hessian and the four bounds methods), but
+   * without the \c virtual keyword. When used as \c Solver<Real, Derived>, the solver calls the
+   * derived methods directly, so that small objectives and constraints can be inlined into the
+   * solver's evaluation routines. The derived class may also implement the \c separate oracle for
+   * lazily generated constraints and the \c parameters method for the solution cache.
+   * \tparam Real The real number type.
+   * \tparam Derived The derived problem class.
+   */
+  template <typename Real, typename Derived>
+  class StaticProblem
+  {
+    static_assert(std::is_floating_point_v<Real>,
+      "Pipal::StaticProblem<Real, Derived>: Real must be a floating-point type.");
+
+    std::string m_name{"(Unnamed Pipal Problem)"}; /*!< Name of the optimization problem. */
+
+  public:
+    using UniquePtr = std::unique_ptr<Derived>;
+
+    /**
+     * \brief Default constructor.
+     */
+    StaticProblem() = default;
+
+    /**
+     * \brief Problem constructor.
+     * \param[in] t_name Name of the optimization problem.
+     */
+    StaticProblem(std::string t_name) : m_name(std::move(t_name)) {};
+
+    /**
+     * \brief Deleted copy constructor.
+     * \note This class is not copyable.
+     */
+    StaticProblem(StaticProblem const &) = delete;
+
+    /**
+     * \brief Deleted assignment operator.
+     * \note This class is not assignable.
+     */
+    StaticProblem & operator=(StaticProblem const &) = delete;
+
+    /**
+     * \brief Deleted move constructor.
+     * \note This class is not movable.
+     */
+    StaticProblem(StaticProblem &&) = delete;
+
+    /**
+     * \brief Deleted move assignment operator.
+     * \note This class is not movable.
+     */
+    StaticProblem & operator=(StaticProblem &&) = delete;
+
+    /**
+     * \brief Get the name of the optimization problem.
+     * \return The name of the optimization problem.
+     */
+    std::string const & name() const {return this->m_name;}
+
+    /**
+     * \brief Set the name of the optimization problem.
+     * \param[in] t_name The name of the optimization problem.
+     */
+    void name(std::string const & t_name) {this->m_name = t_name;}
+
+    /**
+     * \brief Get the derived problem object.
+     * \return A reference to the derived problem object.
+     */
+    Derived & derived() {return static_cast<Derived &>(*this);}
+
+    /**
+     * \brief Get the derived problem object.
+     * \return A constant reference to the derived problem object.
+     */
+    Derived const & derived() const {return static_cast<Derived const &>(*this);}
+
+  protected:
+    /**
+     * \brief Default destructor.
+     * \note The destructor is protected and non-virtual, derived objects must be owned through a
+     * pointer to the derived class.
+     */
+    ~StaticProblem() = default;
+
+  }; // class StaticProblem
+
+  /**
+   * \brief Check at compile time whether a type implements the Pipal problem interface.
+   *
+   * The check is satisfied by any class exposing the Problem methods with compatible signatures,
+   * that is the Problem class itself, its derived classes and the StaticProblem derived classes.
+   * \tparam Real The real number type.
+   * \tparam T The type to check.
+   */
+  template <typename Real, typename T, typename = void>
+  struct IsProblem : std::false_type {};
+
+  template <typename Real, typename T>
+  struct IsProblem<Real, T, std::void_t<
+    decltype(std::declval<T const &>().name()),
+    decltype(bool(std::declval<T const &>().objective(
+      std::declval<Vector<Real> const &>(), std::declval<Real &>()))),
+    decltype(bool(std::declval<T const &>().objective_gradient(
+      std::declval<Vector<Real> const &>(), std::declval<Vector<Real> &>()))),
+    decltype(bool(std::declval<T const &>().constraints(
+      std::declval<Vector<Real> const &>(), std::declval<Vector<Real> &>()))),
+    decltype(bool(std::declval<T const &>().constraints_jacobian(
+      std::declval<Vector<Real> const &>(), std::declval<SparseMatrix<Real> &>()))),
+    decltype(bool(std::declval<T const &>().lagrangian_hessian(std::declval<Vector<Real> const &>(),
+      std::declval<Vector<Real> const &>(), std::declval<SparseMatrix<Real> &>()))),
+    decltype(bool(std::declval<T const &>().primal_lower_bounds(std::declval<Vector<Real> &>()))),
+    decltype(bool(std::declval<T const &>().primal_upper_bounds(std::declval<Vector<Real> &>()))),
+    decltype(bool(std::declval<T const &>().constraints_lower_bounds(std::declval<Vector<Real> &>()))),
+    decltype(bool(std::declval<T const &>().constraints_upper_bounds(std::declval<Vector<Real> &>())))
+  >> : std::true_type {};
+
+  /**
+   * \brief Check at compile time whether a problem type implements the separation oracle.
+   * \tparam Real The real number type.
+   * \tparam T The type to check.
+   */
+  template <typename Real, typename T, typename = void>
+  struct HasSeparation : std::false_type {};
+
+  template <typename Real, typename T>
+  struct HasSeparation<Real, T, std::void_t<
+    decltype(Integer(std::declval<T &>().separate(std::declval<Vector<Real> const &>())))
+  >> : std::true_type {};
+
+  /**
+   * \brief Check at compile time whether a problem type exposes its parameters.
+   * \tparam Real The real number type.
+   * \tparam T The type to check.
+   */
+  template <typename Real, typename T, typename = void>
+  struct HasParameters : std::false_type {};
+
+  template <typename Real, typename T>
+  struct HasParameters<Real, T, std::void_t<
+    decltype(bool(std::declval<T const &>().parameters(std::declval<Vector<Real> &>())))
+  >> : std::true_type {};
+
+  /**
+   * \brief Check at compile time whether a problem type exposes views of its derivatives.
+   * \tparam Real The real number type.
+   * \tparam T The type to check.
+   */
+  template <typename Real, typename T, typename = void>
+  struct HasViews : std::false_type {};
+
+  template <typename Real, typename T>
+  struct HasViews<Real, T, std::void_t<
+    decltype(bool(std::declval<T const &>().constraints_jacobian_view_at(std::declval<Vector<Real> const &>(),
+      std::declval<SparseMap<Real> const * &>()))),
+    decltype(bool(std::declval<T const &>().lagrangian_hessian_view_at(std::declval<Vector<Real> const &>(),
+      std::declval<Vector<Real> const &>(), std::declval<SparseMap<Real> const * &>())))
+  >> : std::true_type {};
+
 } // namespace Pipal
 
 #endif // INCLUDE_PIPAL_PROBLEM_HXX
@@ -0,0 +1,554 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_REMOTE_HXX
+#define INCLUDE_PIPAL_REMOTE_HXX
+
+// STL
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+// Linux
+#include <csignal>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Pipal
+{
+
+  static constexpr std::size_t REMOTE_ALIGN{64}; /*!< Alignment of the shared channel sections. */
+
+  /**
+   * \brief Operation requested to a remote worker.
+   */
+  using RemoteOp = enum class RemoteOp : Integer
+  {
+    OBJECTIVE          = 0, /*!< Objective function. */
+    OBJECTIVE_GRADIENT = 1, /*!< Objective function gradient. */
+    CONSTRAINTS        = 2, /*!< Constraints function. */
+    JACOBIAN           = 3, /*!< Constraints Jacobian. */
+    HESSIAN            = 4, /*!< Lagrangian Hessian. */
+    BOUNDS             = 5, /*!< Primal and constraints bounds. */
+    STOP               = 6  /*!< Worker shutdown. */
+  }; // enum class RemoteOp
+
+  /**
+   * \brief Control block of the shared channel between a RemoteProblem and its worker.
+   *
+   * The two sequence words are also the futexes the processes sleep on. A request is published by
+   * incrementing \c request after the inputs are written, and it is completed when \c response
+   * reaches the same value, after the outputs and the status are written.
+   */
+  struct RemoteHeader
+  {
+    std::atomic<std::uint32_t> request;  /*!< Sequence number of the last request. */
+    std::atomic<std::uint32_t> response; /*!< Sequence number of the last completed request. */
+    RemoteOp                   op;       /*!< Requested operation. */
+    std::int32_t               status;   /*!< Status of the last request (1 on success). */
+    std::int64_t               J_nnz;    /*!< Number of non-zeros of the returned Jacobian. */
+    std::int64_t               H_nnz;    /*!< Number of non-zeros of the returned Hessian. */
+  }; // struct RemoteHeader
+
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free && sizeof(std::atomic<std::uint32_t>) == 4,
+    "Pipal::RemoteHeader: futex words must be lock-free 32-bit atomics");
+
+  /**
+   * \brief Problem whose functions are evaluated by a worker process.
+   *
+   * The model is built by a factory in a child process forked at construction, so that a crash of the
+   * model (e.g., a segmentation fault of a legacy simulator) can not bring down the solver. The two
+   * processes share an anonymous memory segment holding the control block and fixed-capacity buffers
+   * for \f$ \mathbf{x} \f$, \f$ \boldsymbol{\lambda} \f$, the gradient, the constraints, and the
+   * compressed Jacobian and Hessian, which are read and written in place with no serialization.
+   * Requests are signalled through futexes on the sequence words of the control block.
+   *
+   * While waiting for a reply, the worker is polled for liveness. If it died, or it exceeded the
+   * evaluation timeout, it is reaped and a fresh worker is forked at the next request, while the
+   * pending request fails, so that the solver handles it as an evaluation error (the trial point is
+   * rejected by the line search). Each instance serves one solver, requests are not thread-safe.
+   * \note The worker is forked from the calling process, so that the factory must not rely on other
+   * threads of the parent. The worker is killed when the thread that forked it exits (the parent death
+   * signal is bound to the forking thread, not to the process), hence the instance must be constructed
+   * and used from a thread living as long as the instance itself (e.g., the main thread), since a
+   * restarted worker is forked by the thread issuing the request.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real>
+  class RemoteProblem : public Problem<Real>
+  {
+  public:
+    using Factory      = std::function<std::unique_ptr<Problem<Real>>()>; /*!< Model factory (run by the worker). */
+    using StorageIndex = typename SparseMatrix<Real>::StorageIndex;
+
+  private:
+    /**
+     * \brief Byte offsets of the sections of the shared segment.
+     */
+    struct Layout
+    {
+      std::size_t x, l, g, c, J_value, H_value, bounds, J_outer, J_inner, H_outer, H_inner, f, size;
+    };
+
+    Factory     m_factory;                  /*!< Model factory. */
+    Integer     m_n;                        /*!< Number of primal variables. */
+    Integer     m_m;                        /*!< Number of constraints. */
+    Integer     m_J_cap;                    /*!< Capacity of the Jacobian buffers. */
+    Integer     m_H_cap;                    /*!< Capacity of the Hessian buffers. */
+    Layout      m_layout;                   /*!< Sections of the shared segment. */
+    void *      m_data{MAP_FAILED};         /*!< Shared segment. */
+    Real        m_timeout{std::numeric_limits<Real>::infinity()}; /*!< Evaluation timeout (seconds). */
+    mutable pid_t   m_pid{-1};              /*!< Worker process identifier (-1 if not running). */
+    mutable Integer m_restarts{0};          /*!< Number of worker restarts. */
+
+    /**
+     * \brief Round up a byte offset to the section alignment.
+     * \param[in] offset Byte offset.
+     * \return The aligned byte offset.
+     */
+    static std::size_t align(std::size_t const offset)
+    {
+      return (offset + REMOTE_ALIGN - 1)/REMOTE_ALIGN*REMOTE_ALIGN;
+    }
+
+    /**
+     * \brief Get a section of the shared segment.
+     * \tparam T Type of the section elements.
+     * \param[in] offset Byte offset of the section.
+     * \return The pointer to the section.
+     */
+    template <typename T>
+    T * section(std::size_t const offset) const
+    {
+      return reinterpret_cast<T *>(static_cast<char *>(this->m_data) + offset);
+    }
+
+    /**
+     * \brief Get the control block of the shared segment.
+     * \return The control block.
+     */
+    RemoteHeader & header() const {return *this->section<RemoteHeader>(0);}
+
+    /**
+     * \brief Wait on a futex word while it holds a given value.
+     * \param[in] word Futex word.
+     * \param[in] value Expected value.
+     * \param[in] timeout Maximum waiting time (null to wait indefinitely).
+     */
+    static void futex_wait(std::atomic<std::uint32_t> & word, std::uint32_t const value,
+      struct timespec const * timeout)
+    {
+      ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT, value, timeout, nullptr, 0);
+    }
+
+    /**
+     * \brief Wake the processes waiting on a futex word.
+     * \param[in] word Futex word.
+     */
+    static void futex_wake(std::atomic<std::uint32_t> & word)
+    {
+      ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+    }
+
+    /**
+     * \brief Copy a sparse matrix to the shared segment.
+     * \param[in] mat Matrix (in compressed form).
+     * \param[in] rows Expected number of rows.
+     * \param[in] cap Capacity of the buffers.
+     * \param[in] outer Offset of the outer indices.
+     * \param[in] inner Offset of the inner indices.
+     * \param[in] value Offset of the values.
+     * \param[out] nnz Number of non-zeros.
+     * \return True if the matrix fits the buffers, false otherwise.
+     */
+    bool put(SparseMatrix<Real> & mat, Integer const rows, Integer const cap, std::size_t const outer,
+      std::size_t const inner, std::size_t const value, std::int64_t & nnz) const
+    {
+      mat.makeCompressed();
+      if (mat.rows() != rows || mat.cols() != this->m_n || mat.nonZeros() > cap) {return false;}
+      nnz = mat.nonZeros();
+      std::memcpy(this->section<StorageIndex>(outer), mat.outerIndexPtr(), (this->m_n+1)*sizeof(StorageIndex));
+      std::memcpy(this->section<StorageIndex>(inner), mat.innerIndexPtr(), nnz*sizeof(StorageIndex));
+      std::memcpy(this->section<Real>(value), mat.valuePtr(), nnz*sizeof(Real));
+      return true;
+    }
+
+    /**
+     * \brief Copy a sparse matrix from the shared segment.
+     *
+     * The worker owns the segment, so that its content is validated after the copy: the number of
+     * non-zeros must fit the buffers, the outer indices must be non-decreasing from zero to the number
+     * of non-zeros, and the inner indices must be in range.
+     * \param[out] mat Matrix.
+     * \param[in] rows Number of rows.
+     * \param[in] cap Capacity of the buffers.
+     * \param[in] nnz Number of non-zeros.
+     * \param[in] outer Offset of the outer indices.
+     * \param[in] inner Offset of the inner indices.
+     * \param[in] value Offset of the values.
+     * \return True if the matrix is valid, false otherwise.
+     */
+    bool get(SparseMatrix<Real> & mat, Integer const rows, Integer const cap, std::int64_t const nnz,
+      std::size_t const outer, std::size_t const inner, std::size_t const value) const
+    {
+      if (nnz < 0 || nnz > cap) {return false;}
+      mat.resize(rows, this->m_n);
+      mat.resizeNonZeros(nnz);
+      std::memcpy(mat.outerIndexPtr(), this->section<StorageIndex>(outer), (this->m_n+1)*sizeof(StorageIndex));
+      std::memcpy(mat.innerIndexPtr(), this->section<StorageIndex>(inner), nnz*sizeof(StorageIndex));
+      std::memcpy(mat.valuePtr(), this->section<Real>(value), nnz*sizeof(Real));
+      StorageIndex const * ptr{mat.outerIndexPtr()};
+      StorageIndex const * idx{mat.innerIndexPtr()};
+      if (ptr[0] != 0 || ptr[this->m_n] != nnz) {mat.resize(rows, this->m_n); return false;}
+      for (Integer k{0}; k < this->m_n; ++k) {
+        if (ptr[k] > ptr[k+1]) {mat.resize(rows, this->m_n); return false;}
+      }
+      for (std::int64_t k{0}; k < nnz; ++k) {
+        if (idx[k] < 0 || idx[k] >= rows) {mat.resize(rows, this->m_n); return false;}
+      }
+      return true;
+    }
+
+    /**
+     * \brief Serve an operation in the worker process.
+     * \param[in] model Model of the problem.
+     * \param[in] op Requested operation.
+     * \return True if the operation succeeded, false otherwise.
+     */
+    bool serve(Problem<Real> const & model, RemoteOp const op) const
+    {
+      // Create alias for easier access
+      Layout const & s{this->m_layout};
+      RemoteHeader & h{this->header()};
+      Integer const n{this->m_n}, m{this->m_m};
+
+      // Wrap the inputs (the model interface takes owning vectors)
+      Vector<Real> const x(Eigen::Map<Vector<Real> const>(this->section<Real>(s.x), n));
+      Vector<Real> out;
+      SparseMatrix<Real> mat;
+      switch (op) {
+        case RemoteOp::OBJECTIVE:
+          return model.objective(x, *this->section<Real>(s.f));
+        case RemoteOp::OBJECTIVE_GRADIENT:
+          if (!model.objective_gradient(x, out) || out.size() != n) {return false;}
+          Eigen::Map<Vector<Real>>(this->section<Real>(s.g), n) = out;
+          return true;
+        case RemoteOp::CONSTRAINTS:
+          if (!model.constraints(x, out) || out.size() != m) {return false;}
+          Eigen::Map<Vector<Real>>(this->section<Real>(s.c), m) = out;
+          return true;
+        case RemoteOp::JACOBIAN:
+          return model.constraints_jacobian(x, mat) &&
+            this->put(mat, m, this->m_J_cap, s.J_outer, s.J_inner, s.J_value, h.J_nnz);
+        case RemoteOp::HESSIAN:
+          return model.lagrangian_hessian(x, Eigen::Map<Vector<Real> const>(this->section<Real>(s.l), m), mat) &&
+            this->put(mat, n, this->m_H_cap, s.H_outer, s.H_inner, s.H_value, h.H_nnz);
+        case RemoteOp::BOUNDS: {
+          Vector<Real> bl, bu, cl, cu;
+          if (!model.primal_lower_bounds(bl) || !model.primal_upper_bounds(bu) ||
+              !model.constraints_lower_bounds(cl) || !model.constraints_upper_bounds(cu) ||
+              bl.size() != n || bu.size() != n || cl.size() != m || cu.size() != m) {return false;}
+          Real * bounds{this->section<Real>(s.bounds)};
+          Eigen::Map<Vector<Real>>(bounds, n) = bl;
+          Eigen::Map<Vector<Real>>(bounds + n, n) = bu;
+          Eigen::Map<Vector<Real>>(bounds + 2*n, m) = cl;
+          Eigen::Map<Vector<Real>>(bounds + 2*n + m, m) = cu;
+          return true;
+        }
+        default: return false;
+      }
+    }
+
+    /**
+     * \brief Main loop of the worker process (it never returns).
+     * \param[in] parent Process identifier of the parent, taken before the fork.
+     */
+    [[noreturn]] void work(pid_t const parent) const
+    {
+      // Die with the parent (exit if it already died before the signal was set), and build the model
+      ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+      if (::getppid() != parent) {::_exit(EXIT_FAILURE);}
+      RemoteHeader & h{this->header()};
+      std::unique_ptr<Problem<Real>> model;
+      PIPAL_TRY {model = this->m_factory();} PIPAL_CATCH_ALL {}
+      if (!model) {::_exit(EXIT_FAILURE);}
+
+      // Serve the requests (the sequence is reset before the fork)
+      std::uint32_t seen{0};
+      while (true) {
+        std::uint32_t req;
+        while ((req = h.request.load(std::memory_order_acquire)) == seen) {futex_wait(h.request, seen, nullptr);}
+        seen = req;
+        if (h.op == RemoteOp::STOP) {::_exit(EXIT_SUCCESS);}
+        bool ok{false};
+        PIPAL_TRY {ok = this->serve(*model, h.op);} PIPAL_CATCH_ALL {ok = false;}
+        h.status = ok ? 1 : 0;
+        h.response.store(req, std::memory_order_release);
+        futex_wake(h.response);
+      }
+    }
+
+    /**
+     * \brief Fork a new worker process.
+     * \return True if the worker was started, false otherwise.
+     */
+    bool start() const
+    {
+      RemoteHeader & h{this->header()};
+      h.request.store(0, std::memory_order_relaxed);
+      h.response.store(0, std::memory_order_relaxed);
+      pid_t const parent{::getpid()};
+      pid_t const pid{::fork()};
+      if (pid == 0) {this->work(parent);}
+      if (pid < 0) {return false;}
+      this->m_pid = pid;
+      return true;
+    }
+
+    /**
+     * \brief Reap a dead or stuck worker, so that a fresh one is forked at the next request.
+     * \param[in] kill Kill the worker before reaping it.
+     */
+    void reap(bool const kill) const
+    {
+      if (kill) {::kill(this->m_pid, SIGKILL);}
+      int status;
+      while (::waitpid(this->m_pid, &status, 0) < 0 && errno == EINTR) {}
+      this->m_pid = -1;
+      ++this->m_restarts;
+    }
+
+    /**
+     * \brief Send a request to the worker and wait for its reply.
+     * \param[in] op Requested operation.
+     * \return True if the worker replied with success, false if the operation failed or the worker
+     * crashed or timed out.
+     */
+    bool call(RemoteOp const op) const
+    {
+      // Create alias for easier access
+      RemoteHeader & h{this->header()};
+
+      if (this->m_pid < 0 && !this->start()) {return false;}
+
+      // Publish the request
+      h.op = op;
+      std::uint32_t const seq{h.request.load(std::memory_order_relaxed) + 1};
+      h.request.store(seq, std::memory_order_release);
+      futex_wake(h.request);
+      if (op == RemoteOp::STOP) {return true;}
+
+      // Wait for the reply, polling the worker for liveness
+      struct timespec const poll{0, 10000000};
+      std::chrono::steady_clock::time_point const t_start{std::chrono::steady_clock::now()};
+      std::uint32_t cur;
+      while ((cur = h.response.load(std::memory_order_acquire)) != seq) {
+        futex_wait(h.response, cur, &poll);
+        if (h.response.load(std::memory_order_acquire) == seq) {break;}
+        int status;
+        if (::waitpid(this->m_pid, &status, WNOHANG) == this->m_pid) {
+          this->m_pid = -1;
+          ++this->m_restarts;
+          return false;
+        }
+        std::chrono::duration<Real> const t_wait{std::chrono::steady_clock::now() - t_start};
+        if (t_wait.count() > this->m_timeout) {this->reap(true); return false;}
+      }
+      return h.status == 1;
+    }
+
+  public:
+    /**
+     * \brief RemoteProblem constructor (it forks the worker process).
+     * \param[in] t_factory Factory building the model in the worker process.
+     * \param[in] t_n Number of primal variables.
+     * \param[in] t_m Number of constraints.
+     * \param[in] t_J_cap Maximum number of non-zeros of the constraints Jacobian.
+     * \param[in] t_H_cap Maximum number of non-zeros of the Lagrangian Hessian.
+     * \param[in] t_name Name of the optimization problem.
+     */
+    RemoteProblem(Factory t_factory, Integer const t_n, Integer const t_m, Integer const t_J_cap,
+      Integer const t_H_cap, std::string t_name = "remote")
+      : Problem<Real>(std::move(t_name)), m_factory(std::move(t_factory)), m_n(t_n), m_m(t_m),
+        m_J_cap(t_J_cap), m_H_cap(t_H_cap)
+    {
+      #define CMD "Pipal::RemoteProblem::RemoteProblem(...): "
+
+      PIPAL_ASSERT(this->m_factory, CMD "model factory must be set");
+      PIPAL_ASSERT(t_n >= 0 && t_m >= 0 && t_J_cap >= 0 && t_H_cap >= 0, CMD "sizes must be non-negative");
+
+      // Lay out the shared segment
+      Layout & s{this->m_layout};
+      std::size_t const nR{sizeof(Real)}, nI{sizeof(StorageIndex)};
+      s.x       = align(sizeof(RemoteHeader));
+      s.l       = align(s.x + t_n*nR);
+      s.g       = align(s.l + t_m*nR);
+      s.c       = align(s.g + t_n*nR);
+      s.J_value = align(s.c + t_m*nR);
+      s.H_value = align(s.J_value + t_J_cap*nR);
+      s.bounds  = align(s.H_value + t_H_cap*nR);
+      s.J_outer = align(s.bounds + 2*(t_n + t_m)*nR);
+      s.J_inner = align(s.J_outer + (t_n+1)*nI);
+      s.H_outer = align(s.J_inner + t_J_cap*nI);
+      s.H_inner = align(s.H_outer + (t_n+1)*nI);
+      s.f       = align(s.H_inner + t_H_cap*nI);
+      s.size    = align(s.f + nR);
+
+      // Map the segment and start the worker
+      this->m_data = ::mmap(nullptr, s.size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+      PIPAL_ASSERT(this->m_data != MAP_FAILED, CMD "unable to map the shared segment (" << std::strerror(errno) << ").");
+      new (this->m_data) RemoteHeader{};
+      if (!this->start()) {
+        ::munmap(this->m_data, s.size);
+        PIPAL_ERROR(CMD "unable to fork the worker (" << std::strerror(errno) << ").");
+      }
+
+      #undef CMD
+    }
+
+    /**
+     * \brief RemoteProblem destructor (it stops the worker and unmaps the shared segment).
+     */
+    ~RemoteProblem() override
+    {
+      if (this->m_pid > 0) {
+        this->call(RemoteOp::STOP);
+        for (Integer k{0}; k < 100; ++k) {
+          int status;
+          if (::waitpid(this->m_pid, &status, WNOHANG) != 0) {this->m_pid = -1; break;}
+          ::usleep(1000);
+        }
+        if (this->m_pid > 0) {this->reap(true);}
+      }
+      ::munmap(this->m_data, this->m_layout.size);
+    }
+
+    /**
+     * \brief Get the evaluation timeout.
+     * \return The evaluation timeout (seconds).
+     */
+    Real timeout() const {return this->m_timeout;}
+
+    /**
+     * \brief Set the evaluation timeout, after which a stuck worker is killed and restarted.
+     * \param[in] t_timeout The evaluation timeout (seconds, infinite by default).
+     */
+    void timeout(Real const t_timeout)
+    {
+      PIPAL_ASSERT(t_timeout > 0.0,
+        "Pipal::RemoteProblem::timeout(...): input value must be positive");
+      this->m_timeout = t_timeout;
+    }
+
+    /**
+     * \brief Get the number of worker restarts (crashes and timeouts).
+     * \return The number of worker restarts.
+     */
+    Integer restarts() const {return this->m_restarts;}
+
+    /**
+     * \brief Get the worker process identifier.
+     * \return The worker process identifier (-1 if it is not running).
+     */
+    pid_t worker() const {return this->m_pid;}
+
+    bool objective(Vector<Real> const & x, Real & out) const override
+    {
+      if (x.size() != this->m_n) {return false;}
+      Eigen::Map<Vector<Real>>(this->section<Real>(this->m_layout.x), this->m_n) = x;
+      if (!this->call(RemoteOp::OBJECTIVE)) {return false;}
+      out = *this->section<Real>(this->m_layout.f);
+      return true;
+    }
+
+    bool objective_gradient(Vector<Real> const & x, Vector<Real> & out) const override
+    {
+      if (x.size() != this->m_n) {return false;}
+      Eigen::Map<Vector<Real>>(this->section<Real>(this->m_layout.x), this->m_n) = x;
+      if (!this->call(RemoteOp::OBJECTIVE_GRADIENT)) {return false;}
+      out = Eigen::Map<Vector<Real> const>(this->section<Real>(this->m_layout.g), this->m_n);
+      return true;
+    }
+
+    bool constraints(Vector<Real> const & x, Vector<Real> & out) const override
+    {
+      if (x.size() != this->m_n) {return false;}
+      Eigen::Map<Vector<Real>>(this->section<Real>(this->m_layout.x), this->m_n) = x;
+      if (!this->call(RemoteOp::CONSTRAINTS)) {return false;}
+      out = Eigen::Map<Vector<Real> const>(this->section<Real>(this->m_layout.c), this->m_m);
+      return true;
+    }
+
+    bool constraints_jacobian(Vector<Real> const & x, SparseMatrix<Real> & out) const override
+    {
+      // Create alias for easier access
+      Layout const & s{this->m_layout};
+
+      if (x.size() != this->m_n) {return false;}
+      Eigen::Map<Vector<Real>>(this->section<Real>(s.x), this->m_n) = x;
+      if (!this->call(RemoteOp::JACOBIAN)) {return false;}
+      return this->get(out, this->m_m, this->m_J_cap, this->header().J_nnz, s.J_outer, s.J_inner, s.J_value);
+    }
+
+    bool lagrangian_hessian(Vector<Real> const & x, Vector<Real> const & l, SparseMatrix<Real> & out) const override
+    {
+      // Create alias for easier access
+      Layout const & s{this->m_layout};
+
+      if (x.size() != this->m_n || l.size() != this->m_m) {return false;}
+      Eigen::Map<Vector<Real>>(this->section<Real>(s.x), this->m_n) = x;
+      Eigen::Map<Vector<Real>>(this->section<Real>(s.l), this->m_m) = l;
+      if (!this->call(RemoteOp::HESSIAN)) {return false;}
+      return this->get(out, this->m_n, this->m_H_cap, this->header().H_nnz, s.H_outer, s.H_inner, s.H_value);
+    }
+
+    bool primal_lower_bounds(Vector<Real> & out) const override
+    {
+      if (!this->call(RemoteOp::BOUNDS)) {return false;}
+      out = Eigen::Map<Vector<Real> const>(this->section<Real>(this->m_layout.bounds), this->m_n);
+      return true;
+    }
+
+    bool primal_upper_bounds(Vector<Real> & out) const override
+    {
+      if (!this->call(RemoteOp::BOUNDS)) {return false;}
+      out = Eigen::Map<Vector<Real> const>(this->section<Real>(this->m_layout.bounds) + this->m_n, this->m_n);
+      return true;
+    }
+
+    bool constraints_lower_bounds(Vector<Real> & out) const override
+    {
+      if (!this->call(RemoteOp::BOUNDS)) {return false;}
+      out = Eigen::Map<Vector<Real> const>(this->section<Real>(this->m_layout.bounds) + 2*this->m_n, this->m_m);
+      return true;
+    }
+
+    bool constraints_upper_bounds(Vector<Real> & out) const override
+    {
+      if (!this->call(RemoteOp::BOUNDS)) {return false;}
+      out = Eigen::Map<Vector<Real> const>(this->section<Real>(this->m_layout.bounds) + 2*this->m_n + this->m_m,
+        this->m_m);
+      return true;
+    }
+
+  }; // class RemoteProblem
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_REMOTE_HXX
@@ -0,0 +1,188 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_SEPARATION_HXX
+#define INCLUDE_PIPAL_SEPARATION_HXX
+
+namespace Pipal
+{
+
+  /**
+   * \brief Query the separation oracle at an optimal point of the current working set.
+   *
+   * If the problem implements the separation oracle and the current iterate is optimal, the oracle
+   * is queried at the current point. If it appends violated constraints, the problem input and the
+   * iterate are extended in place, so that the iterations can continue from the current point.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \return True if constraints were appended and the iterations must continue, false otherwise.
+   */
+  template <typename Real, typename ProblemT>
+  bool Solver<Real, ProblemT>::evalSeparation()
+  {
+    // Check for problems with a separation oracle
+    if constexpr (!HasSeparation<Real, ProblemT>::value) {
+      return false;
+    } else {
+      // Create alias for easier access
+      Parameter<Real> & p{this->m_parameter};
+      Counter         & c{this->m_counter};
+      Input<Real>     & i{this->m_input};
+
+      // Query the oracle only at optimal points
+      if (this->checkTermination() != 1 || c.S >= p.sep_rounds_max) {return false;}
+
+      // Query the oracle at the current point
+      Vector<Real> x_orig;
+      this->evalXOriginal(x_orig);
+      Integer const added{this->m_problem->separate(x_orig)};
+      if (added <= 0) {return false;}
+      ++c.S;
+
+      // Extend the problem input and the iterate
+      this->extendConstraints();
+      if (this->m_verbose) {this->m_output.printSeparation(c, i, added);}
+      return true;
+    }
+  }
+
+  /**
+   * \brief Extend the problem input and the iterate with the constraints appended by the oracle.
+   *
+   * The variables and constraints are classified again, the appended constraints must follow the
+   * existing ones in each class. The primal point, the multipliers and the scaling factors of the
+   * existing constraints are kept, the appended constraints are scaled as in the initial iterate and
+   * their multipliers are initialized to the default value. The interior-point parameter is raised
+   * to a moderate value, so that the slacks of the (violated) appended constraints can be centered.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::extendConstraints()
+  {
+    #define CMD "Pipal::Solver::extendConstraints(...): "
+
+    // Create alias for easier access
+    Parameter<Real> & p{this->m_parameter};
+    Input<Real>     & i{this->m_input};
+    Iterate<Real>   & z{this->m_iterate};
+
+    // Store current classification
+    Indices const I6{i.I6}, I7{i.I7}, I8{i.I8}, I9{i.I9};
+    Integer const nV{i.nV}, nE{i.nE}, nI{i.nI}, n7{i.n7}, n8{i.n8}, n9{i.n9};
+
+    // Get variable and constraint bounds
+    Vector<Real> bl, bu, cl, cu;
+    PIPAL_ASSERT(this->m_problem->primal_lower_bounds(bl),
+      CMD "error in evaluating lower bounds on primal variables");
+    PIPAL_ASSERT(this->m_problem->primal_upper_bounds(bu),
+      CMD "error in evaluating upper bounds on primal variables");
+    PIPAL_ASSERT(this->m_problem->constraints_lower_bounds(cl),
+      CMD "error in evaluating lower bounds on constraints");
+    PIPAL_ASSERT(this->m_problem->constraints_upper_bounds(cu),
+      CMD "error in evaluating upper bounds on constraints");
+
+    // Classify variables and constraints
+    Vector<Real> x_orig;
+    this->evalXOriginal(x_orig);
+    this->buildInput(i.name, x_orig, bl, bu, cl, cu);
+    this->applyVariableScalings();
+
+    // Check that the existing constraints keep their classification
+    PIPAL_ASSERT(i.nV == nV && i.n6 >= nE && i.n7 >= n7 && i.n8 >= n8 && i.n9 >= n9 &&
+      (i.I6.head(nE) == I6).all() && (i.I7.head(n7) == I7).all() && (i.I8.head(n8) == I8).all() &&
+      (i.I9.head(n9) == I9).all(),
+      CMD "appended constraints must follow the existing ones");
+
+    // Map existing inequality constraints into the extended ordering
+    Integer const o{i.n3+i.n4+2*i.n5};
+    Indices mapE(Indices::LinSpaced(nE, 0, nE-1)), mapI(nI);
+    for (Integer k{0}; k < o;  ++k) {mapI(k) = k;}
+    for (Integer k{0}; k < n7; ++k) {mapI(o+k) = o+k;}
+    for (Integer k{0}; k < n8; ++k) {mapI(o+n7+k) = o+i.n7+k;}
+    for (Integer k{0}; k < n9; ++k) {
+      mapI(o+n7+n8+k)    = o+i.n7+i.n8+k;
+      mapI(o+n7+n8+n9+k) = o+i.n7+i.n8+i.n9+k;
+    }
+
+    // Extend constraint scalings and multipliers
+    auto extend = [] (Array<Real> const & a, Indices const & map, Integer const n, Real const value) {
+      Array<Real> out(Array<Real>::Constant(n, value));
+      out(map) = a;
+      return out;
+    };
+    Mask const newE(extend(Array<Real>::Zero(nE), mapE, i.nE, 1.0) > 0.0);
+    Mask const newI(extend(Array<Real>::Zero(nI), mapI, i.nI, 1.0) > 0.0);
+    z.cEs = extend(z.cEs, mapE, i.nE, 1.0);
+    z.cIs = extend(z.cIs, mapI, i.nI, 1.0);
+    z.lE  = extend(z.lE,  mapE, i.nE, 0.0);
+    z.lI  = extend(z.lI,  mapI, i.nI, 0.5);
+
+    // Evaluate functions and gradients on the extended constraints
+    z.JE.resize(i.nE, i.nV);
+    z.JI.resize(i.nI, i.nV);
+    this->evalFunctions();
+    this->evalGradients();
+
+    // Scale down appended constraints if norm of gradient is too large
+    Array<Real> rE(Array<Real>::Zero(i.nE)), rI(Array<Real>::Zero(i.nI));
+    for (Integer k{0}; k < z.JE.outerSize(); ++k) {
+      for (typename SparseMatrix<Real>::InnerIterator it(z.JE, k); it; ++it) {
+        rE(it.row()) = std::max(rE(it.row()), std::abs(it.value()));
+      }
+    }
+    for (Integer k{0}; k < z.JI.outerSize(); ++k) {
+      for (typename SparseMatrix<Real>::InnerIterator it(z.JI, k); it; ++it) {
+        rI(it.row()) = std::max(rI(it.row()), std::abs(it.value()));
+      }
+    }
+    rE = newE.select(p.grad_max / rE.max(p.grad_max), 1.0);
+    rI = newI.select(p.grad_max / rI.max(p.grad_max), 1.0);
+    z.cEs *= rE; z.cE *= rE;
+    z.cIs *= rI; z.cI *= rI;
+    for (Integer k{0}; k < z.JE.outerSize(); ++k) {
+      for (typename SparseMatrix<Real>::InnerIterator it(z.JE, k); it; ++it) {it.valueRef() *= rE(it.row());}
+    }
+    for (Integer k{0}; k < z.JI.outerSize(); ++k) {
+      for (typename SparseMatrix<Real>::InnerIterator it(z.JI, k); it; ++it) {it.valueRef() *= rI(it.row());}
+    }
+    this->evalRowMajorCopies();
+
+    // Raise interior-point parameter and evaluate dependent quantities
+    z.mu = std::max(z.mu, p.sep_mu);
+    this->evalInfeasibility(z);
+    z.v_ = z.v;
+    this->evalDependent();
+
+    // Reset quantities depending on the constraints set
+    z.b.resize(i.nA);
+    z.Ad.setOnes(i.nA);
+    z.kkt_.setConstant(p.opt_err_mem, std::numeric_limits<Real>::infinity());
+    z.Ikept.resize(0);
+    z.active.resize(0);
+    z.active_k = 0;
+    z.shift22 = 0;
+    z.cut_ = false;
+    this->resetDirection(this->m_direction);
+
+    // Evaluate Hessian and Newton matrix
+    if (!this->m_bfgs) {this->evalHessian();}
+    z.Hnnz  = static_cast<Integer>(z.H.nonZeros());
+    z.JEnnz = static_cast<Integer>(z.JE.nonZeros());
+    z.JInnz = static_cast<Integer>(z.JI.nonZeros());
+    this->initNewtonMatrix();
+    this->evalNewtonMatrix();
+
+    #undef CMD
+  }
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_SEPARATION_HXX
@@ -0,0 +1,279 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_SERIALIZATION_HXX
+#define INCLUDE_PIPAL_SERIALIZATION_HXX
+
+// STL
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace Pipal
+{
+
+  static constexpr std::uint64_t SYMBOLIC_MAGIC{0x4d59534c41504950ull}; /*!< Symbolic analysis file tag ("PIPALSYM"). */
+  static constexpr std::uint32_t SYMBOLIC_VERSION{2};                   /*!< Symbolic analysis file version. */
+
+  /**
+   * \brief 64-bit FNV-1a hash of binary data.
+   */
+  class Fnv1a
+  {
+    std::uint64_t m_hash{14695981039346656037ull}; /*!< Current hash value. */
+
+  public:
+    /**
+     * \brief Update the hash with raw bytes.
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data in bytes.
+     */
+    void update(void const * data, std::size_t const size)
+    {
+      unsigned char const * bytes{static_cast<unsigned char const *>(data)};
+      for (std::size_t k{0}; k < size; ++k) {
+        this->m_hash ^= bytes[k];
+        this->m_hash *= 1099511628211ull;
+      }
+    }
+
+    /**
+     * \brief Update the hash with a trivially copyable value.
+     * \param[in] value Value.
+     */
+    template <typename T, std::enable_if_t<std::is_trivially_copyable_v<T>, int> = 0>
+    void update(T const & value) {this->update(&value, sizeof(T));}
+
+    /**
+     * \brief Update the hash with the size and the coefficients of an Eigen dense object.
+     * \param[in] value Eigen dense object.
+     */
+    template <typename Derived>
+    void update(Eigen::PlainObjectBase<Derived> const & value)
+    {
+      this->update(static_cast<std::uint64_t>(value.size()));
+      this->update(value.data(), value.size()*sizeof(typename Derived::Scalar));
+    }
+
+    /**
+     * \brief Get the hash value.
+     * \return The hash value.
+     */
+    std::uint64_t value() const {return this->m_hash;}
+
+    /**
+     * \brief Get the hash value as a hexadecimal string.
+     * \return The hash value as a 16-digit hexadecimal string.
+     */
+    std::string hex() const
+    {
+      char buffer[17];
+      std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(this->m_hash));
+      return std::string(buffer);
+    }
+
+  }; // class Fnv1a
+
+  /**
+   * \brief Write a trivially copyable value to a binary stream.
+   * \param[in] os Output stream.
+   * \param[in] value Value.
+   */
+  template <typename T, std::enable_if_t<std::is_trivially_copyable_v<T>, int> = 0>
+  static void write_binary(std::ostream & os, T const & value)
+  {
+    os.write(reinterpret_cast<char const *>(&value), sizeof(T));
+  }
+
+  /**
+   * \brief Write a vector (size and elements) to a binary stream.
+   * \param[in] os Output stream.
+   * \param[in] value Vector.
+   */
+  template <typename T>
+  static void write_binary(std::ostream & os, std::vector<T> const & value)
+  {
+    write_binary(os, static_cast<std::uint64_t>(value.size()));
+    os.write(reinterpret_cast<char const *>(value.data()), value.size()*sizeof(T));
+  }
+
+  /**
+   * \brief Write an Eigen dense vector (size and coefficients) to a binary stream.
+   * \param[in] os Output stream.
+   * \param[in] value Eigen dense vector.
+   */
+  template <typename Derived>
+  static void write_binary(std::ostream & os, Eigen::PlainObjectBase<Derived> const & value)
+  {
+    write_binary(os, static_cast<std::uint64_t>(value.size()));
+    os.write(reinterpret_cast<char const *>(value.data()), value.size()*sizeof(typename Derived::Scalar));
+  }
+
+  /**
+   * \brief Write a string (size and characters) to a binary stream.
+   * \param[in] os Output stream.
+   * \param[in] value String.
+   */
+  static inline void write_binary(std::ostream & os, std::string const & value)
+  {
+    write_binary(os, static_cast<std::uint64_t>(value.size()));
+    os.write(value.data(), value.size());
+  }
+
+  /**
+   * \brief Write an Eigen sparse matrix (sizes and compressed storage) to a binary stream.
+   * \param[in] os Output stream.
+   * \param[in] value Eigen sparse matrix.
+   */
+  template <typename Scalar, int Options, typename StorageIndex>
+  static void write_binary(std::ostream & os, Eigen::SparseMatrix<Scalar, Options, StorageIndex> const & value)
+  {
+    if (!value.isCompressed()) {
+      Eigen::SparseMatrix<Scalar, Options, StorageIndex> compressed(value);
+      compressed.makeCompressed();
+      write_binary(os, compressed);
+      return;
+    }
+    write_binary(os, static_cast<std::int64_t>(value.rows()));
+    write_binary(os, static_cast<std::int64_t>(value.cols()));
+    write_binary(os, static_cast<std::uint64_t>(value.nonZeros()));
+    os.write(reinterpret_cast<char const *>(value.outerIndexPtr()), (value.outerSize()+1)*sizeof(StorageIndex));
+    os.write(reinterpret_cast<char const *>(value.innerIndexPtr()), value.nonZeros()*sizeof(StorageIndex));
+    os.write(reinterpret_cast<char const *>(value.valuePtr()), value.nonZeros()*sizeof(Scalar));
+  }
+
+  /**
+   * \brief Read a trivially copyable value from a binary stream.
+   * \param[in] is Input stream.
+   * \param[out] value Value.
+   * \return True if the value was read successfully, false otherwise.
+   */
+  template <typename T, std::enable_if_t<std::is_trivially_copyable_v<T>, int> = 0>
+  static bool read_binary(std::istream & is, T & value)
+  {
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+  }
+
+  /**
+   * \brief Read a vector (size and elements) from a binary stream.
+   * \param[in] is Input stream.
+   * \param[out] value Vector.
+   * \param[in] max_size Maximum accepted number of elements (guards against corrupted files).
+   * \return True if the vector was read successfully, false otherwise.
+   */
+  template <typename T>
+  static bool read_binary(std::istream & is, std::vector<T> & value,
+    std::uint64_t const max_size = std::numeric_limits<std::uint32_t>::max())
+  {
+    std::uint64_t size;
+    if (!read_binary(is, size) || size > max_size) {return false;}
+    value.resize(size);
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(value.data()), size*sizeof(T)));
+  }
+
+  /**
+   * \brief Read an Eigen dense vector (size and coefficients) from a binary stream.
+   * \param[in] is Input stream.
+   * \param[out] value Eigen dense vector.
+   * \param[in] max_size Maximum accepted number of coefficients (guards against corrupted files).
+   * \return True if the vector was read successfully, false otherwise.
+   */
+  template <typename Derived>
+  static bool read_binary(std::istream & is, Eigen::PlainObjectBase<Derived> & value,
+    std::uint64_t const max_size = std::numeric_limits<std::uint32_t>::max())
+  {
+    std::uint64_t size;
+    if (!read_binary(is, size) || size > max_size) {return false;}
+    value.resize(static_cast<Eigen::Index>(size));
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(value.data()),
+      size*sizeof(typename Derived::Scalar)));
+  }
+
+  /**
+   * \brief Read a string (size and characters) from a binary stream.
+   * \param[in] is Input stream.
+   * \param[out] value String.
+   * \param[in] max_size Maximum accepted number of characters (guards against corrupted files).
+   * \return True if the string was read successfully, false otherwise.
+   */
+  static inline bool read_binary(std::istream & is, std::string & value,
+    std::uint64_t const max_size = std::numeric_limits<std::uint16_t>::max())
+  {
+    std::uint64_t size;
+    if (!read_binary(is, size) || size > max_size) {return false;}
+    value.resize(size);
+    return static_cast<bool>(is.read(value.data(), size));
+  }
+
+  /**
+   * \brief Read an Eigen sparse matrix (sizes and compressed storage) from a binary stream.
+   *
+   * The outer indices must be non-decreasing and the inner indices within the inner size, so that a
+   * corrupted file can not produce a matrix that is indexed out of bounds.
+   * \param[in] is Input stream.
+   * \param[out] value Eigen sparse matrix.
+   * \param[in] max_size Maximum accepted number of nonzeros (guards against corrupted files).
+   * \return True if the matrix was read successfully, false otherwise.
+   */
+  template <typename Scalar, int Options, typename StorageIndex>
+  static bool read_binary(std::istream & is, Eigen::SparseMatrix<Scalar, Options, StorageIndex> & value,
+    std::uint64_t const max_size = std::numeric_limits<std::uint32_t>::max())
+  {
+    std::int64_t rows, cols;
+    std::uint64_t nnz;
+    if (!read_binary(is, rows) || !read_binary(is, cols) || !read_binary(is, nnz) || rows < 0 || cols < 0 ||
+        nnz > max_size) {return false;}
+    value.resize(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(cols));
+    value.resizeNonZeros(static_cast<Eigen::Index>(nnz));
+    if (!is.read(reinterpret_cast<char *>(value.outerIndexPtr()), (value.outerSize()+1)*sizeof(StorageIndex)) ||
+        !is.read(reinterpret_cast<char *>(value.innerIndexPtr()), nnz*sizeof(StorageIndex)) ||
+        !is.read(reinterpret_cast<char *>(value.valuePtr()), nnz*sizeof(Scalar))) {return false;}
+    StorageIndex const * outer{value.outerIndexPtr()};
+    StorageIndex const * inner{value.innerIndexPtr()};
+    if (outer[0] != 0 || static_cast<std::uint64_t>(outer[value.outerSize()]) != nnz) {return false;}
+    for (Eigen::Index k{0}; k < value.outerSize(); ++k) {
+      if (outer[k] > outer[k+1]) {return false;}
+    }
+    for (std::uint64_t k{0}; k < nnz; ++k) {
+      if (inner[k] < 0 || inner[k] >= value.innerSize()) {return false;}
+    }
+    return true;
+  }
+
+  /**
+   * \brief Atomically write a binary file.
+   *
+   * The content is written to a temporary file first and then renamed, so that concurrent readers
+   * never see a partially written file.
+   * \param[in] path File path.
+   * \param[in] writer Function writing the content to the given stream.
+   * \return True if the file was written successfully, false otherwise.
+   */
+  template <typename Writer>
+  static bool write_binary_file(std::string const & path, Writer && writer)
+  {
+    std::string const tmp{path + "." + std::to_string(
+      std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp"};
+    {
+      std::ofstream file(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!file) {return false;}
+      writer(static_cast<std::ostream &>(file));
+      if (!file) {std::remove(tmp.c_str()); return false;}
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {std::remove(tmp.c_str()); return false;}
+    return true;
+  }
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_SERIALIZATION_HXX
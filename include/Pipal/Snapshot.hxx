@@ -0,0 +1,224 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#ifndef INCLUDE_PIPAL_SNAPSHOT_HXX
+#define INCLUDE_PIPAL_SNAPSHOT_HXX
+
+namespace Pipal
+{
+
+  static constexpr std::uint64_t SNAPSHOT_MAGIC{0x504e534c41504950ull}; /*!< Snapshot file tag ("PIPALSNP"). */
+  static constexpr std::uint32_t SNAPSHOT_VERSION{1};                   /*!< Snapshot file version. */
+
+  /**
+   * \brief Visit all the fields of the solver state stored in a snapshot.
+   *
+   * The same list of fields is used to save and to load the snapshots, so that the two can not go
+   * out of sync. Quantities rebuilt from the stored ones (row-major Jacobians, Newton matrix and its
+   * factorization) are not visited.
+   * \tparam Self Solver type (possibly const-qualified).
+   * \tparam Visitor Function called on each field.
+   * \param[in] self Solver.
+   * \param[in] visit Function called on each field.
+   */
+  template <typename Real, typename ProblemT>
+  template <typename Self, typename Visitor>
+  void Solver<Real, ProblemT>::visitSnapshot(Self & self, Visitor && visit)
+  {
+    // Create alias for easier access
+    auto & p{self.m_parameter};
+    auto & c{self.m_counter};
+    auto & i{self.m_input};
+    auto & z{self.m_iterate};
+    auto & d{self.m_direction};
+    auto & a{self.m_acceptance};
+
+    // Options and parameters
+    visit(self.m_bfgs); visit(self.m_equilibration); visit(self.m_screening); visit(self.m_threads);
+    visit(p.opt_err_tol); visit(p.iter_max); visit(p.algorithm); visit(p.mu_max_exp); visit(p.bfgs_update_freq);
+    visit(c.f); visit(c.g); visit(c.H); visit(c.k); visit(c.M); visit(c.S); visit(c.T); visit(c.C);
+
+    // Input
+    visit(i.name);
+    visit(i.I1); visit(i.I2); visit(i.I3); visit(i.I4); visit(i.I5); visit(i.I6); visit(i.I7); visit(i.I8);
+    visit(i.I9);
+    visit(i.x0); visit(i.b2); visit(i.l3); visit(i.u4); visit(i.l5); visit(i.u5); visit(i.b6); visit(i.l7);
+    visit(i.u8); visit(i.l9); visit(i.u9);
+    visit(i.n0); visit(i.n1); visit(i.n2); visit(i.n3); visit(i.n4); visit(i.n5); visit(i.n6); visit(i.n7);
+    visit(i.n8); visit(i.n9); visit(i.nV); visit(i.nI); visit(i.nE); visit(i.nA); visit(i.vi);
+
+    // Iterate
+    visit(z.x); visit(z.rho); visit(z.rho_); visit(z.mu); visit(z.f); visit(z.fu); visit(z.g);
+    visit(z.r1); visit(z.r2); visit(z.cE); visit(z.JE); visit(z.JEnnz); visit(z.lE);
+    visit(z.s1); visit(z.s2); visit(z.cI); visit(z.JI); visit(z.JInnz); visit(z.lI);
+    visit(z.H); visit(z.Hnnz); visit(z.v); visit(z.vu); visit(z.v0); visit(z.phi); visit(z.Annz);
+    visit(z.shift); visit(z.b); visit(z.kkt); visit(z.kkt_); visit(z.err);
+    visit(z.fs); visit(z.xs); visit(z.cEs); visit(z.cEu); visit(z.cIs); visit(z.cIu); visit(z.Ad); visit(z.Ait);
+    visit(z.shift22); visit(z.Ikept); visit(z.Ipos); visit(z.v_); visit(z.cut_); visit(z.active);
+    visit(z.active_k); visit(z.trials); visit(z.trial_k); visit(z.trial_j); visit(z.trial_n);
+    visit(z.infeas_k); visit(z.t_factor);
+
+    // Direction and acceptance
+    visit(d.x); visit(d.x_norm); visit(d.x_norm_); visit(d.r1); visit(d.r2); visit(d.lE); visit(d.s1);
+    visit(d.s2); visit(d.lI); visit(d.l_norm); visit(d.lred0); visit(d.ltred0); visit(d.ltred);
+    visit(d.qtred); visit(d.m);
+    visit(a.p0); visit(a.p); visit(a.d); visit(a.s);
+  }
+
+  /**
+   * \brief Save the complete solver state to a binary file.
+   *
+   * The snapshot holds the options, the problem input, the current iterate, the current direction
+   * and the acceptance criteria. It can be loaded by a solver without a problem, to run the solver
+   * kernels in isolation on real data (see \c load_snapshot and \c run_kernel).
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] path Snapshot file path.
+   * \return True if the snapshot was saved successfully, false otherwise.
+   */
+  template <typename Real, typename ProblemT>
+  bool Solver<Real, ProblemT>::save_snapshot(std::string const & path) const
+  {
+    return write_binary_file(path, [this] (std::ostream & os) {
+      write_binary(os, SNAPSHOT_MAGIC);
+      write_binary(os, SNAPSHOT_VERSION);
+      write_binary(os, static_cast<std::uint32_t>(sizeof(Real)));
+      visitSnapshot(*this, [&os] (auto const & value) {write_binary(os, value);});
+    });
+  }
+
+  /**
+   * \brief Load the complete solver state from a binary file.
+   *
+   * The Newton matrix is allocated, but it is neither assembled nor factorized, so that the kernel
+   * \c Kernel::NEWTON_MATRIX must be run before \c Kernel::NEWTON_STEP.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] path Snapshot file path.
+   * \return True if the snapshot was loaded successfully, false otherwise.
+   */
+  template <typename Real, typename ProblemT>
+  bool Solver<Real, ProblemT>::load_snapshot(std::string const & path)
+  {
+    // Create alias for easier access
+    Parameter<Real> const & p{this->m_parameter};
+    Input<Real>           & i{this->m_input};
+    Iterate<Real>   const & z{this->m_iterate};
+    Direction<Real> const & d{this->m_direction};
+
+    // Open snapshot file and check header
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file) {return false;}
+    std::uint64_t magic;
+    std::uint32_t version, size;
+    if (!read_binary(file, magic) || magic != SNAPSHOT_MAGIC || !read_binary(file, version) ||
+        version != SNAPSHOT_VERSION || !read_binary(file, size) || size != sizeof(Real)) {return false;}
+
+    // Read solver state
+    bool ok{true};
+    visitSnapshot(*this, [&file, &ok] (auto & value) {ok = ok && read_binary(file, value);});
+    if (!ok) {return false;}
+
+    // Check the restored state against the problem sizes, so that a corrupted or mismatched snapshot
+    // is rejected before any of its fields is used to index another one
+    using Index = Eigen::Index;
+    auto const is{[] (auto const & v, Index const n) {return v.size() == n;}};
+    auto const is_or_empty{[] (auto const & v, Index const n) {return v.size() == n || v.size() == 0;}};
+    auto const in{[] (Indices const & v, Index const lo, Index const hi) {
+      return v.size() == 0 || (v.minCoeff() >= lo && v.maxCoeff() < hi);}};
+    auto const dims{[] (SparseMatrix<Real> const & m, Index const rows, Index const cols) {
+      return m.rows() == rows && m.cols() == cols;}};
+    Index const n0{Index(i.n1)+i.n2+i.n3+i.n4+i.n5}, nV{Index(i.n1)+i.n3+i.n4+i.n5};
+    Index const nI{Index(i.n3)+i.n4+2*Index(i.n5)+i.n7+i.n8+2*Index(i.n9)}, nE{i.n6};
+    Index const nA{nV+3*nE+3*nI}, inf{std::numeric_limits<Integer>::max()};
+    if (!is(i.I1, i.n1) || !is(i.I2, i.n2) || !is(i.I3, i.n3) || !is(i.I4, i.n4) || !is(i.I5, i.n5) ||
+        !is(i.I6, i.n6) || !is(i.I7, i.n7) || !is(i.I8, i.n8) || !is(i.I9, i.n9) || i.n0 != n0 ||
+        i.nV != nV || i.nI != nI || i.nE != nE || i.nA != nA ||
+        !in(i.I1, 0, n0) || !in(i.I2, 0, n0) || !in(i.I3, 0, n0) || !in(i.I4, 0, n0) || !in(i.I5, 0, n0) ||
+        !in(i.I6, 0, inf) || !in(i.I7, 0, inf) || !in(i.I8, 0, inf) || !in(i.I9, 0, inf) ||
+        !is(i.x0, nV) || !is(i.b2, i.n2) || !is(i.l3, i.n3) || !is(i.u4, i.n4) || !is(i.l5, i.n5) ||
+        !is(i.u5, i.n5) || !is(i.b6, i.n6) || !is(i.l7, i.n7) || !is(i.u8, i.n8) || !is(i.l9, i.n9) ||
+        !is(i.u9, i.n9)) {return false;}
+    if (!is(z.x, nV) || !is(z.g, nV) || !is_or_empty(z.xs, nV) || !dims(z.H, nV, nV) ||
+        !is(z.r1, nE) || !is(z.r2, nE) || !is(z.cE, nE) || !is(z.lE, nE) || !is(z.cEs, nE) ||
+        !is(z.cEu, nE) || !dims(z.JE, nE, nV) ||
+        !is(z.s1, nI) || !is(z.s2, nI) || !is(z.cI, nI) || !is(z.lI, nI) || !is(z.cIs, nI) ||
+        !is(z.cIu, nI) || !dims(z.JI, nI, nV) ||
+        z.b.size() > nA || z.Ad.size() > nA || !is(z.kkt, 3) || !is(z.kkt_, p.opt_err_mem) ||
+        z.Ikept.size() > nI || !in(z.Ikept, 0, nI) || !is_or_empty(z.Ipos, nI) ||
+        !in(z.Ipos, -1, z.Ikept.size()) || !is_or_empty(z.active, nI) ||
+        z.JEnnz < 0 || z.JInnz < 0 || z.Hnnz < 0 || z.Annz < 0) {return false;}
+    if (!is_or_empty(d.x, nV) || !is_or_empty(d.r1, nE) || !is_or_empty(d.r2, nE) ||
+        !is_or_empty(d.lE, nE) || !is_or_empty(d.s1, nI) || !is_or_empty(d.s2, nI) ||
+        !is_or_empty(d.lI, nI)) {return false;}
+
+    // Rebuild derived quantities
+    this->threads(std::max<Integer>(this->m_threads, 1));
+    this->evalRowMajorCopies();
+    this->initNewtonMatrix();
+    return true;
+  }
+
+  /**
+   * \brief Run a solver kernel on the current state.
+   *
+   * The kernels are meant to be timed in isolation on a loaded snapshot. Each run recomputes the
+   * quantities of the kernel from the current state, so that it can be repeated.
+   * \tparam Real Floating-point type used by the algorithm.
+   * \param[in] kernel Kernel to be run.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::run_kernel(Kernel const kernel)
+  {
+    #define CMD "Pipal::Solver::run_kernel(...): "
+
+    // Create alias for easier access
+    Iterate<Real> & z{this->m_iterate};
+
+    switch (kernel) {
+      case Kernel::NEWTON_MATRIX: {
+        // The Hessian shift is added to the Hessian and feeds the next minimum shift, hence the
+        // Hessian and the shifts are restored so that the kernel starts from the same state
+        SparseMatrix<Real> const H(z.H);
+        Real const shift{z.shift}, shift22{z.shift22};
+        this->evalNewtonMatrix();
+        z.H = H; z.shift = shift; z.shift22 = shift22;
+        break;
+      }
+      case Kernel::NEWTON_STEP:
+        PIPAL_ASSERT(this->m_iterate.ldlt.vectorD().size() > 0 && this->m_iterate.ldlt.info() == Eigen::Success,
+          CMD "Newton matrix not factorized, run 'Kernel::NEWTON_MATRIX' first");
+        this->evalNewtonStep();
+        break;
+      case Kernel::MODELS:               this->evalModels();         break;
+      case Kernel::FRACTION_TO_BOUNDARY: this->fractionToBoundary(); break;
+      case Kernel::KKT_ERRORS:           this->evalKKTErrors();      break;
+      case Kernel::SLACKS:               this->evalSlacks();         break;
+      default: PIPAL_ERROR(CMD "unknown kernel");
+    }
+
+    #undef CMD
+  }
+
+  /**
+   * \brief Save the snapshot of the current iteration to the snapshots directory.
+   *
+   * Failures in writing the snapshot file are silently ignored.
+   * \tparam Real Floating-point type used by the algorithm.
+   */
+  template <typename Real, typename ProblemT>
+  void Solver<Real, ProblemT>::saveIterationSnapshot() const
+  {
+    this->save_snapshot(this->m_snapshot + "/pipal_snapshot_" + std::to_string(this->m_counter.k) + ".bin");
+  }
+
+} // namespace Pipal
+
+#endif // INCLUDE_PIPAL_SNAPSHOT_HXX
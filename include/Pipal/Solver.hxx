@@ -22,15 +22,21 @@ namespace Pipal {
    * Curtis Pipal algorithm. It utilizes the Problem class to define the optimization problem and
    * implements various methods for solving it.
    * \tparam Real The floating-point type used for computations (e.g., float, double).
+   * \tparam ProblemT The problem type, either the (dynamic) Problem class, or a concrete problem
+   * class (e.g., derived from StaticProblem) whose methods are called without virtual dispatch.
    */
-  template <typename Real>
+  template <typename Real, typename ProblemT = Problem<Real>>
   class Solver
   {
     static_assert(std::is_floating_point_v<Real>,
-      "Pipal::Solver<Real>: Real must be a floating-point type.");
+      "Pipal::Solver<Real, ProblemT>: Real must be a floating-point type.");
+
+    static_assert(IsProblem<Real, ProblemT>::value,
+      "Pipal::Solver<Real, ProblemT>: ProblemT must implement the Pipal problem interface.");
 
   public:
-    using ProblemPtr              = typename Problem<Real>::UniquePtr;
+    using ProblemType             = ProblemT;
+    using ProblemPtr              = std::unique_ptr<ProblemT>;
     using ObjectiveFunc           = typename ProblemWrapper<Real>::ObjectiveFunc;
     using ObjectiveGradientFunc   = typename ProblemWrapper<Real>::ObjectiveGradientFunc;
     using ConstraintsFunc         = typename ProblemWrapper<Real>::ConstraintsFunc;
@@ -47,13 +53,37 @@ namespace Pipal {
     Output<Real>     m_output;     /*!< Output class for managing solver output. */
     Parameter<Real>  m_parameter;  /*!< Internal parameters for the solver algorithm. */
     ProblemPtr       m_problem;    /*!< Problem object pointer. */
+    std::shared_ptr<Executor> m_pool; /*!< Executor of the parallel kernels (serial if null). */
 
     // Some options for the solver
     bool m_verbose{false}; /*!< Verbosity flag. */
     bool m_bfgs{false};    /*!< BFGS update flag. */
+    bool m_equilibration{false}; /*!< Newton matrix equilibration flag. */
+    bool m_metrics{false}; /*!< Metrics recording flag. */
+    Integer m_threads{1};  /*!< Number of threads for the sparse products. */
+    std::string m_symbolic_cache; /*!< Symbolic analysis cache directory (disabled if empty). */
+    bool m_polish{false};  /*!< Active-set polishing flag. */
+    bool m_screening{false}; /*!< Inequality constraints screening flag. */
+    bool m_pruning{false};   /*!< Trial grid pruning flag. */
+    bool m_infeasibility{false}; /*!< Early infeasibility detection flag. */
+    bool m_predictor_corrector{false}; /*!< Predictor-corrector interior-point parameter flag. */
+    Integer m_correctors{0}; /*!< Maximum number of centrality correctors per iteration. */
+    Scaling m_scaling{Scaling::NONE}; /*!< Primal variable scaling choice. */
+    Vector<Real> m_nominal;  /*!< Primal variable nominal magnitudes (original space). */
+    std::shared_ptr<SolutionCache<Real>> m_cache; /*!< Solution cache (disabled if null). */
+    WarmStart<Real> m_warm;     /*!< Warm start (or cached solution) of the current solve. */
+    bool m_warm_start{false};   /*!< Warm start flag of the current solve. */
+    bool m_warm_user{false};    /*!< User warm start flag of the next solve. */
+    bool m_cache_hit{false};    /*!< Cached solution flag of the current solve. */
+    SeqLock<Progress<Real>> m_progress; /*!< Progress snapshot (readable from any thread). */
+    std::string m_snapshot;     /*!< Iterate snapshots directory (disabled if empty). */
+    Integer m_snapshot_every{1}; /*!< Iterate snapshots frequency (in iterations). */
 
     void buildIterate();
     void evalStep();
+    bool evalPredictorCorrector();
+    void evalComplementarity(Real const ap, Real const ad, Array<Real> & w) const;
+    void evalCentralityCorrectors(Real const t_solve);
     void updateParameters();
     void lineSearch();
     void bfgsUpdate(Vector<Real> const & s, Vector<Real> const & y);
@@ -64,7 +94,30 @@ namespace Pipal {
     void evalGradients();
     void evalHessian();
     void evalNewtonMatrix();
+    void evalNewtonAssembly();
+    void evalScreening();
+    std::string symbolicAnalysisPath() const;
+    bool loadSymbolicAnalysis();
+    void saveSymbolicAnalysis() const;
+    bool lookupCache(Vector<Real> const & x_guess, Vector<Real> const & bl, Vector<Real> const & bu,
+      Vector<Real> const & cl, Vector<Real> const & cu, Vector<Real> & key);
+    void storeCache(Vector<Real> const & key);
+    void evalEquilibration();
+    void evalActiveSet();
+    bool polishSolution();
+    bool evalSeparation();
+    void extendConstraints();
+    template <typename Self, typename Visitor>
+    static void visitSnapshot(Self & self, Visitor && visit);
+    void saveIterationSnapshot() const;
+    void evalRowMajorCopies();
+    void evalJacobianProduct(SparseMatrix<Real> const & J, SparseMatrixRow<Real> const & Jr,
+      Vector<Real> const & x, Vector<Real> & y) const;
+    void evalTransposeProduct(SparseMatrix<Real> const & J, Vector<Real> const & x, Vector<Real> & y) const;
+    void evalNewtonSolve(Vector<Real> const & b, Vector<Real> & x) const;
     void evalScalings();
+    void evalVariableScalings();
+    void applyVariableScalings();
     void evalModels();
     void fractionToBoundary();
     void evalNewtonRhs();
@@ -165,6 +218,35 @@ namespace Pipal {
     void resetCounter()
     {
       this->m_counter.f = this->m_counter.g = this->m_counter.H = this->m_counter.k = this->m_counter.M = 0;
+      this->m_counter.S = 0;
+      this->m_counter.T = 0;
+      this->m_counter.C = 0;
+    }
+
+    /**
+     * \brief Publish the progress snapshot of the current iterate.
+     * \param[in] running Solve in progress flag.
+     */
+    void publishProgress(bool const running)
+    {
+      // Create alias for easier access
+      Counter       const & c{this->m_counter};
+      Iterate<Real> const & z{this->m_iterate};
+
+      Progress<Real> progress;
+      progress.running = running;
+      progress.k       = c.k;
+      progress.f_count = c.f;
+      progress.g_count = c.g;
+      progress.H_count = c.H;
+      progress.M_count = c.M;
+      progress.S_count = c.S;
+      progress.f       = z.f;
+      progress.v       = z.v;
+      for (Integer j{0}; j < 3 && j < z.kkt.size(); ++j) {progress.kkt[j] = z.kkt(j);}
+      progress.rho     = z.rho;
+      progress.mu      = z.mu;
+      this->m_progress.store(progress);
     }
 
     /**
@@ -215,6 +297,7 @@ namespace Pipal {
      * \param[in] primal_upper_bounds Upper bounds on the primal variables handle.
      * \param[in] constraints_lower_bounds Lower bounds on the constraints handle.
      * \param[in] constraints_upper_bounds Upper bounds on the constraints handle.
+     * \note This constructor is only available for the (dynamic) Problem class.
      */
     Solver(
       std::string             const & name,
@@ -238,7 +321,10 @@ namespace Pipal {
       primal_upper_bounds,
       constraints_lower_bounds,
       constraints_upper_bounds
-    )) {}
+    )) {
+      static_assert(std::is_base_of_v<ProblemT, ProblemWrapper<Real>>,
+        "Pipal::Solver<Real, ProblemT>: function handles require ProblemT = Problem<Real>.");
+    }
 
     /**
      * \brief Constructor for the Pipal class (with a unique pointer to a Problem object).
@@ -292,7 +378,29 @@ namespace Pipal {
      * \brief Get the problem being solved.
      * \return A reference to the problem.
      */
-    Problem<Real> const & problem() const {return this->m_problem.get();}
+    ProblemT const & problem() const {return *this->m_problem;}
+
+    /**
+     * \brief Get the counters of the last solve.
+     * \return A reference to the counters.
+     */
+    Counter const & counter() const {return this->m_counter;}
+
+    /**
+     * \brief Get the current iterate (e.g., to inspect the results of \c run_kernel).
+     * \return A reference to the current iterate.
+     */
+    Iterate<Real> const & iterate() const {return this->m_iterate;}
+
+    /**
+     * \brief Get the progress of the current (or last) solve.
+     *
+     * The solver publishes a snapshot of the iteration counters and of the current iterate once per
+     * iteration. This method returns a consistent copy of the last snapshot, and it can be called
+     * from any thread while \c optimize is running.
+     * \return The progress snapshot.
+     */
+    Progress<Real> progress() const {return this->m_progress.load();}
 
     /**
      * \brief Get the verbose mode.
@@ -318,6 +426,400 @@ namespace Pipal {
      */
     void bfgs(bool const t_bfgs) {this->m_bfgs = t_bfgs;}
 
+    /**
+     * \brief Get the Newton matrix equilibration mode.
+     * \return The equilibration mode.
+     */
+    bool equilibration() const {return this->m_equilibration;}
+
+    /**
+     * \brief Set the Newton matrix equilibration mode.
+     *
+     * When enabled, the Newton matrix is symmetrically scaled (Ruiz equilibration) before each
+     * factorization, and the Newton systems are solved through the scaled factorization.
+     * \param[in] t_equilibration The equilibration mode.
+     */
+    void equilibration(bool const t_equilibration) {this->m_equilibration = t_equilibration;}
+
+    /**
+     * \brief Get the metrics recording mode.
+     * \return The metrics recording mode.
+     */
+    bool metrics() const {return this->m_metrics;}
+
+    /**
+     * \brief Set the metrics recording mode.
+     *
+     * When enabled, the statistics of each solve (counters, wall time and termination status) are
+     * recorded in the process-wide registry returned by Metrics::instance().
+     * \param[in] t_metrics The metrics recording mode.
+     */
+    void metrics(bool const t_metrics) {this->m_metrics = t_metrics;}
+
+    /**
+     * \brief Get the number of threads used for the parallel kernels.
+     * \return The number of threads.
+     */
+    Integer threads() const {return this->m_threads;}
+
+    /**
+     * \brief Set the number of threads used for the parallel kernels.
+     *
+     * With more than one thread, the sparse products, the Newton matrix assembly and the numeric
+     * factorization of sufficiently large problems are run by multithreaded kernels. By default,
+     * the kernels run on the process-wide \c WorkStealingPool::shared() pool, split in at most
+     * \p t_threads tasks, so that concurrent solvers do not spawn further threads. A private pool
+     * with \p t_threads threads is created on request only. The results do not depend on the
+     * number of threads.
+     * \param[in] t_threads The number of threads.
+     * \param[in] t_private Run the kernels on a private pool instead of the shared one.
+     * \param[in] t_affinity Pin the private pool threads to the cores (Linux only).
+     */
+    void threads(Integer const t_threads, bool const t_private = false, bool const t_affinity = false)
+    {
+      PIPAL_ASSERT(t_threads > 0,
+        "Pipal::Solver::threads(...): input value must be positive");
+      this->m_threads = t_threads;
+      if (t_threads <= 1) {this->m_pool.reset();}
+      else if (t_private) {this->m_pool = std::make_shared<WorkStealingPool>(t_threads, t_affinity);}
+      else {this->m_pool = std::make_shared<LimitedExecutor>(WorkStealingPool::shared(), t_threads);}
+    }
+
+    /**
+     * \brief Get the executor of the parallel kernels.
+     * \return The executor (null if the kernels are serial).
+     */
+    std::shared_ptr<Executor> executor() const {return this->m_pool;}
+
+    /**
+     * \brief Set the executor of the parallel kernels.
+     *
+     * The executor can be shared by several solvers running concurrently, e.g., the process-wide
+     * \c WorkStealingPool::shared() pool, or an adapter to the thread pool of the application. The
+     * number of threads is set to the size of the executor.
+     * \param[in] t_executor The executor (serial kernels if null).
+     */
+    void executor(std::shared_ptr<Executor> t_executor)
+    {
+      this->m_threads = t_executor ? t_executor->size() : 1;
+      this->m_pool = this->m_threads > 1 ? std::move(t_executor) : nullptr;
+    }
+
+    /**
+     * \brief Get the inequality constraints screening flag.
+     * \return The inequality constraints screening flag.
+     */
+    bool screening() const {return this->m_screening;}
+
+    /**
+     * \brief Enable or disable the inequality constraints screening.
+     *
+     * When enabled, the inequality constraints with large slack and negligible multiplier are
+     * eliminated from the factorized Newton matrix. Their slacks and multiplier directions are
+     * recovered by back-substitution after each solve, and they are restored in the matrix as soon
+     * as they approach their boundary.
+     * \param[in] t_screening The inequality constraints screening flag.
+     */
+    void screening(bool const t_screening) {this->m_screening = t_screening;}
+
+    /**
+     * \brief Get the primal variable scaling choice.
+     * \return The primal variable scaling choice.
+     */
+    Scaling scaling() const {return this->m_scaling;}
+
+    /**
+     * \brief Set the primal variable scaling choice.
+     *
+     * When enabled, the solver works on the primal variables divided by their scaling factors, which
+     * are either the nominal magnitudes (see \c nominal) or the inverse of the constraint Jacobian
+     * column norms at the initial guess. The scaling is applied transparently to the problem
+     * evaluations, and the solution is returned in the original variables.
+     * \param[in] t_scaling The primal variable scaling choice.
+     */
+    void scaling(Scaling const t_scaling) {this->m_scaling = t_scaling;}
+
+    /**
+     * \brief Get the primal variable nominal magnitudes.
+     * \return The primal variable nominal magnitudes (original space).
+     */
+    Vector<Real> const & nominal() const {return this->m_nominal;}
+
+    /**
+     * \brief Set the primal variable nominal magnitudes and enable the nominal scaling.
+     * \param[in] t_nominal The primal variable nominal magnitudes (original space, positive).
+     */
+    void nominal(Vector<Real> const & t_nominal)
+    {
+      PIPAL_ASSERT(t_nominal.allFinite() && (t_nominal.array() > 0.0).all(),
+        "Pipal::Solver::nominal(...): nominal magnitudes must be positive and finite");
+      this->m_nominal = t_nominal;
+      this->m_scaling = Scaling::NOMINAL;
+    }
+
+    /**
+     * \brief Get the trial grid pruning flag.
+     * \return The trial grid pruning flag.
+     */
+    bool pruning() const {return this->m_pruning;}
+
+    /**
+     * \brief Enable or disable the pruning of the penalty and interior-point parameters trial grid.
+     *
+     * When enabled, the adaptive step computation evaluates the interior-point parameter trials
+     * starting from the last choice and stops at the first trial that satisfies the steering
+     * conditions. The models for zero penalty parameter are evaluated only when needed, and the last
+     * choice is tried alone once it has been unchanged for a few iterations. The number of trials
+     * evaluated in each iteration is printed in verbose mode.
+     * \param[in] t_pruning The trial grid pruning flag.
+     */
+    void pruning(bool const t_pruning) {this->m_pruning = t_pruning;}
+
+    /**
+     * \brief Get the predictor-corrector interior-point parameter flag.
+     * \return The predictor-corrector interior-point parameter flag.
+     */
+    bool predictor_corrector() const {return this->m_predictor_corrector;}
+
+    /**
+     * \brief Enable or disable the predictor-corrector choice of the interior-point parameter.
+     *
+     * When enabled with the \c CONSERVATIVE algorithm, the interior-point parameter of each step is
+     * set from the complementarity reduction predicted by an affine-scaling step, and the search
+     * direction is a corrector step. Both are solved with the factorization of the Newton matrix of
+     * the iteration. The option has no effect with the \c ADAPTIVE algorithm, which selects the
+     * interior-point parameter from its trial grid.
+     * \param[in] t_predictor_corrector The predictor-corrector interior-point parameter flag.
+     */
+    void predictor_corrector(bool const t_predictor_corrector)
+    {
+      this->m_predictor_corrector = t_predictor_corrector;
+    }
+
+    /**
+     * \brief Get the maximum number of centrality correctors per iteration.
+     * \return The maximum number of centrality correctors per iteration.
+     */
+    Integer correctors() const {return this->m_correctors;}
+
+    /**
+     * \brief Set the maximum number of centrality correctors per iteration.
+     *
+     * The centrality correctors refine the predictor-corrector direction (see \c predictor_corrector)
+     * with further solves against the factorization of the iteration. Each one pushes the outlying
+     * complementarity products toward the interior-point parameter so as to lengthen the step, and
+     * it is kept only if it does. The number of correctors tried grows with the cost ratio of the
+     * last factorization to a solve, up to this maximum (zero disables them).
+     * \param[in] t_correctors The maximum number of centrality correctors per iteration.
+     */
+    void correctors(Integer const t_correctors)
+    {
+      PIPAL_ASSERT(t_correctors >= 0,
+        "Pipal::Solver::correctors(...): input value must be non-negative");
+      this->m_correctors = t_correctors;
+    }
+
+    /**
+     * \brief Get the early infeasibility detection flag.
+     * \return The early infeasibility detection flag.
+     */
+    bool infeasibility() const {return this->m_infeasibility;}
+
+    /**
+     * \brief Enable or disable the early infeasibility detection.
+     *
+     * When enabled, the solver stops as soon as the optimality error of the feasibility problem is
+     * below a loose tolerance (see \c infeasibility_tolerance()) while the violation stagnates for a
+     * few iterations, instead of waiting for the error to reach the optimality tolerance while the
+     * penalty parameter is driven down. The solution is then a stationary point of the violation
+     * measure, that certifies the (local) infeasibility of the problem (see \c infeasible()).
+     * \param[in] t_infeasibility The early infeasibility detection flag.
+     */
+    void infeasibility(bool const t_infeasibility) {this->m_infeasibility = t_infeasibility;}
+
+    /**
+     * \brief Get the optimality error of the feasibility problem for early infeasibility detection.
+     * \return The early infeasibility detection tolerance.
+     */
+    Real infeasibility_tolerance() const {return this->m_parameter.infeas_tol;}
+
+    /**
+     * \brief Set the optimality error of the feasibility problem for early infeasibility detection.
+     *
+     * The tolerance is meant to be looser than the optimality one (see \c tolerance()), which
+     * terminates the solver on infeasible stationary points anyway.
+     * \param[in] t_infeas_tol The early infeasibility detection tolerance.
+     */
+    void infeasibility_tolerance(Real const t_infeas_tol)
+    {
+      PIPAL_ASSERT(t_infeas_tol > 0.0,
+        "Pipal::Solver::infeasibility_tolerance(...): input value must be positive");
+      this->m_parameter.infeas_tol = t_infeas_tol;
+    }
+
+    /**
+     * \brief Get the active-set polishing flag.
+     * \return The active-set polishing flag.
+     */
+    bool polish() const {return this->m_polish;}
+
+    /**
+     * \brief Enable or disable the active-set polishing.
+     *
+     * When enabled, once the active set is unchanged for a few iterations, the solver attempts a few
+     * Newton iterations on the equality-constrained problem defined by the active constraints. The
+     * polished point is accepted only if the optimality and feasibility errors improve, so that a
+     * high-accuracy solution is usually found without driving the interior-point parameter down.
+     * \param[in] t_polish The active-set polishing flag.
+     */
+    void polish(bool const t_polish) {this->m_polish = t_polish;}
+
+    /**
+     * \brief Get the symbolic analysis cache directory.
+     * \return The symbolic analysis cache directory (empty if disabled).
+     */
+    std::string const & symbolic_cache() const {return this->m_symbolic_cache;}
+
+    /**
+     * \brief Set the symbolic analysis cache directory.
+     *
+     * When set, the symbolic analysis of the Newton matrix (ordering, elimination tree and column
+     * counts) and the variables/constraints classification are stored in the directory, in a binary
+     * file named after a hash of the sparsity pattern. Later solves of problems with the same
+     * structure (also from other processes) load the analysis instead of recomputing it.
+     * \param[in] t_directory The cache directory (empty to disable the cache).
+     */
+    void symbolic_cache(std::string const & t_directory) {this->m_symbolic_cache = t_directory;}
+
+    /**
+     * \brief Get the iterate snapshots directory.
+     * \return The iterate snapshots directory (empty if disabled).
+     */
+    std::string const & snapshot() const {return this->m_snapshot;}
+
+    /**
+     * \brief Set the iterate snapshots directory and frequency.
+     *
+     * When set, the complete solver state is saved (see \c save_snapshot) at the beginning of every
+     * \p t_every iterations, to the file \c pipal_snapshot_<iteration>.bin in the directory.
+     * \param[in] t_directory Iterate snapshots directory (empty to disable).
+     * \param[in] t_every Iterate snapshots frequency (in iterations).
+     */
+    void snapshot(std::string const & t_directory, Integer const t_every = 1)
+    {
+      PIPAL_ASSERT(t_every > 0,
+        "Pipal::Solver::snapshot(...): input frequency must be positive");
+      this->m_snapshot = t_directory;
+      this->m_snapshot_every = t_every;
+    }
+
+    /**
+     * \brief Save the complete solver state to a binary file.
+     *
+     * The snapshot can be loaded by a solver without a problem, to run the solver kernels in isolation
+     * on real data (see \c load_snapshot and \c run_kernel).
+     * \param[in] path Snapshot file path.
+     * \return True if the snapshot was saved successfully, false otherwise.
+     */
+    bool save_snapshot(std::string const & path) const;
+
+    /**
+     * \brief Load the complete solver state from a binary file.
+     *
+     * The Newton matrix is neither assembled nor factorized, so that \c Kernel::NEWTON_MATRIX must be
+     * run before \c Kernel::NEWTON_STEP.
+     * \param[in] path Snapshot file path (see \c save_snapshot).
+     * \return True if the snapshot was loaded successfully, false otherwise.
+     */
+    bool load_snapshot(std::string const & path);
+
+    /**
+     * \brief Run a solver kernel on the current state (e.g., to time it on a loaded snapshot).
+     *
+     * Each run starts from the same state, so that the kernel can be repeated.
+     * \param[in] kernel Kernel to be run.
+     */
+    void run_kernel(Kernel const kernel);
+
+    /**
+     * \brief Get the solution cache.
+     * \return The solution cache (null if disabled).
+     */
+    std::shared_ptr<SolutionCache<Real>> const & cache() const {return this->m_cache;}
+
+    /**
+     * \brief Set the solution cache.
+     *
+     * When set, the solutions of the converged solves are stored in the cache, with a key made of the
+     * problem parameters and bounds. A solve whose key is cached returns the cached solution without
+     * iterating, while a solve whose key is close to a cached one starts from the cached primal and
+     * dual variables and penalty and interior-point parameters. The cache may be shared by several
+     * solvers of problems with the same structure. Exact hits are served only for the problems
+     * exposing parameters, since otherwise the key is made of the bounds alone and cannot tell two
+     * problem instances apart: for such problems the cache is only used as a warm start.
+     * \param[in] t_cache The solution cache (null to disable it).
+     */
+    void cache(std::shared_ptr<SolutionCache<Real>> t_cache) {this->m_cache = std::move(t_cache);}
+
+    /**
+     * \brief Get the primal-dual solution of the last solve, to be used as a warm start.
+     * \return The solution of the last solve (multipliers also in the internal scaling).
+     */
+    WarmStart<Real> warm_start()
+    {
+      // Create alias for easier access
+      Iterate<Real> const & z{this->m_iterate};
+
+      if (this->m_cache_hit) {return this->m_warm;}
+      WarmStart<Real> out;
+      this->evalXOriginal(out.x);
+      this->evalLambdaOriginal(out.l);
+      out.lE  = z.lE;
+      out.lI  = z.lI;
+      out.rho = z.rho;
+      out.mu  = z.mu;
+      return out;
+    }
+
+    /**
+     * \brief Set the warm start of the next solve.
+     *
+     * The next solve starts from the given primal and dual variables and penalty and interior-point
+     * parameters, in place of the initial guess. The multipliers are used only if the classification
+     * of the variables and constraints is unchanged. Exact hits of the solution cache take precedence.
+     * \param[in] t_warm The warm start (see \c warm_start()).
+     */
+    void warm_start(WarmStart<Real> const & t_warm) {this->m_warm = t_warm; this->m_warm_user = true;}
+
+    /**
+     * \brief Check whether the last solve converged to an optimal point.
+     * \return True if the last solve converged, false otherwise.
+     */
+    bool converged() const {return this->m_cache_hit || this->checkTermination() == 1;}
+
+    /**
+     * \brief Check whether the last solve stopped at an infeasible stationary point.
+     *
+     * The solution (see \c getSolution) is then the infeasibility certificate, that is a point where
+     * the violation is positive and stationary, with the multipliers of the feasibility problem.
+     * \return True if the last solve stopped at an infeasible stationary point, false otherwise.
+     */
+    bool infeasible() const {return !this->m_cache_hit && this->checkTermination() == 2;}
+
+    /**
+     * \brief Evaluate the tangent of the solution path with respect to a problem perturbation.
+     *
+     * The first-order change of the last solution is obtained by a finite difference of the Newton
+     * right-hand side and a solve with the Newton matrix at the last iterate. The problem is left
+     * perturbed, and changes of the bounds are not accounted for.
+     * \param[in] perturb Function perturbing the problem by \p h (it returns false on failure).
+     * \param[in] h Size of the perturbation (non-zero).
+     * \param[out] dz Tangent of the primal variables (original space) and of the multipliers (internal
+     * scaling).
+     * \return True if the tangent was evaluated successfully, false otherwise.
+     */
+    bool tangent(std::function<bool()> const & perturb, Real const h, WarmStart<Real> & dz);
+
     /**
      * \brief Get the algorithm mode.
      * \return The algorithm mode.
@@ -399,6 +901,9 @@ namespace Pipal {
       PIPAL_ASSERT(this->m_problem.get() != nullptr,
         CMD "problem not set, use 'problem(...)' method to set it");
 
+      // Start the wall clock
+      std::chrono::steady_clock::time_point const t_start{std::chrono::steady_clock::now()};
+
       // Get variable bounds
       Vector<Real> bl, bu;
       PIPAL_ASSERT(this->m_problem->primal_lower_bounds(bl),
@@ -416,42 +921,87 @@ namespace Pipal {
       // Reset counters
       resetCounter();
 
+      // Look up the solution cache (exact hits are returned without iterating)
+      Vector<Real> key;
+      if (this->lookupCache(x_guess, bl, bu, cl, cu, key)) {
+        if (this->m_metrics) {
+          std::chrono::duration<double> const t_solve{std::chrono::steady_clock::now() - t_start};
+          Metrics::instance().record(c, t_solve.count(), 1);
+        }
+        this->m_progress.store(Progress<Real>{});
+        x_sol = this->m_warm.x;
+        return x_sol.allFinite();
+      }
+
       // Fill input structure
-      buildInput(this->m_problem->name(), x_guess, bl, bu, cl, cu);
+      buildInput(this->m_problem->name(), this->m_warm_start ? this->m_warm.x : x_guess, bl, bu, cl, cu);
       buildIterate();
       resetDirection(d);
 
       // Print header and break line
+      this->m_output.equilibration(this->m_equilibration);
+      this->m_output.pruning(this->m_pruning);
       if (this->m_verbose) {this->m_output.printHeader(i, z); this->m_output.printBreak(c);}
+      this->publishProgress(true);
 
-      // Iterations loop
-      while (!this->checkTermination()) {
+      // Iterations loop (restarted while the separation oracle appends constraints)
+      do {
+        while (!this->checkTermination()) {
 
-        // Print iterate
-        if (this->m_verbose) {this->m_output.printIterate(c, z);}
+          // Save the iterate snapshot
+          if (!this->m_snapshot.empty() && c.k % this->m_snapshot_every == 0) {this->saveIterationSnapshot();}
 
-        // Evaluate the step
-        this->evalStep();
+          // Print iterate
+          if (this->m_verbose) {this->m_output.printIterate(c, z);}
 
-        // Print direction
-        if (this->m_verbose) {this->m_output.printDirection(z, d);}
+          // Evaluate the step
+          this->evalStep();
 
-        this->lineSearch();
+          // Print direction
+          if (this->m_verbose) {
+            this->m_output.printDirection(z, d);
+            if (this->m_equilibration) {this->m_output.printEquilibration(z);}
+            if (this->m_pruning) {this->m_output.printTrials(z);}
+          }
 
-        // Print accepted
-        if (this->m_verbose) {this->m_output.printAcceptance(a);}
+          this->lineSearch();
 
-        this->updateIterate();
+          // Print accepted
+          if (this->m_verbose) {this->m_output.printAcceptance(a);}
 
-        // Increment iteration counter
-        this->incrementIterationCount();
+          this->updateIterate();
+
+          // Increment iteration counter
+          this->incrementIterationCount();
+
+          // Polish the iterate on a stable active set
+          if (this->m_polish && !this->checkTermination()) {
+            this->evalActiveSet();
+            if (z.active_k >= this->m_parameter.polish_stable) {
+              bool const polished{this->polishSolution()};
+              if (this->m_verbose) {this->m_output.printPolish(z, polished);}
+            }
+          }
+
+          // Print break and publish progress
+          if (this->m_verbose) {this->m_output.printBreak(c);}
+          this->publishProgress(true);
+        }
+      } while (this->evalSeparation());
 
-        // Print break
-        if (this->m_verbose) {this->m_output.printBreak(c);}
-      }
       // Print footer and terminate
       if (this->m_verbose) {this->m_output.printFooter(c, z, this->checkTermination());}
 
+      // Record the solve statistics
+      if (this->m_metrics) {
+        std::chrono::duration<double> const t_solve{std::chrono::steady_clock::now() - t_start};
+        Metrics::instance().record(c, t_solve.count(), this->checkTermination());
+      }
+
+      // Store the solution in the cache
+      if (this->m_cache && this->checkTermination() == 1) {this->storeCache(key);}
+      this->publishProgress(false);
+
       // Get solution in original variables
       this->evalXOriginal(x_sol);
 
@@ -469,6 +1019,7 @@ namespace Pipal {
      */
     void getSolution(Vector<Real> & x, Vector<Real> & l)
     {
+      if (this->m_cache_hit) {x = this->m_warm.x; l = this->m_warm.l; return;}
       this->evalXOriginal(x);
       this->evalLambdaOriginal(l);
     }
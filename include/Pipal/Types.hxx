@@ -27,6 +27,10 @@
 #include <type_traits>
 #include <numeric>
 #include <memory>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <cstdlib>
 
 // Eigen library
 #ifndef PIPAL_EIGEN_EXTERNAL
@@ -35,8 +39,17 @@
 #include <Eigen/SparseCholesky>
 #endif
 
-// Print Pipal errors
+// Print Pipal errors (abort instead of throwing if exceptions are disabled)
 #ifndef PIPAL_ERROR
+#ifdef PIPAL_NO_EXCEPTIONS
+#define PIPAL_ERROR(MSG)                \
+  {                                     \
+    std::ostringstream os;              \
+    os << MSG;                          \
+    std::cerr << os.str() << std::endl; \
+    std::abort();                       \
+  }
+#else
 #define PIPAL_ERROR(MSG)                \
   {                                     \
     std::ostringstream os;              \
@@ -44,6 +57,16 @@
     throw std::runtime_error(os.str()); \
   }
 #endif
+#endif
+
+// Guard user code against exceptions (the handler is never run if exceptions are disabled)
+#ifdef PIPAL_NO_EXCEPTIONS
+#define PIPAL_TRY       if (true)
+#define PIPAL_CATCH_ALL else
+#else
+#define PIPAL_TRY       try
+#define PIPAL_CATCH_ALL catch (...)
+#endif
 
 // Assert for Pipal
 #ifndef PIPAL_ASSERT
@@ -112,6 +135,8 @@ namespace Pipal
   template<typename Real> using Vector       = Eigen::Vector<Real, Eigen::Dynamic>;
   template<typename Real> using Matrix       = Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>;
   template<typename Real> using SparseMatrix = Eigen::SparseMatrix<Real>;
+  template<typename Real> using SparseMatrixRow = Eigen::SparseMatrix<Real, Eigen::RowMajor>;
+  template<typename Real> using SparseMap = Eigen::Map<SparseMatrix<Real> const>;
   template<typename Real> using Array        = Eigen::Array<Real, Eigen::Dynamic, 1>;
 
   using Indices = Eigen::Array<Integer, Eigen::Dynamic, 1>;
@@ -125,6 +150,26 @@ namespace Pipal
    */
   using Algorithm = enum class Algorithm : Integer {CONSERVATIVE = 0, ADAPTIVE = 1};
 
+  /**
+   * \brief Enumeration for the primal variable scaling choice.
+   *
+   * The Scaling enumeration defines the possible primal variable scaling choices. The options are
+   * \c NONE (no scaling), \c NOMINAL (user-provided nominal magnitudes) and \c AUTOMATIC (estimation
+   * from the constraint Jacobian column norms at the initial guess).
+   */
+  using Scaling = enum class Scaling : Integer {NONE = 0, NOMINAL = 1, AUTOMATIC = 2};
+
+  /**
+   * \brief Enumeration for the solver kernels that can be run in isolation on a snapshot.
+   *
+   * The Kernel enumeration defines the kernels timed by the micro-benchmarks: the Newton matrix
+   * assembly and factorization, the Newton step, the models, the fraction-to-the-boundary rule, the
+   * KKT errors and the slacks evaluation.
+   */
+  using Kernel = enum class Kernel : Integer {
+    NEWTON_MATRIX = 0, NEWTON_STEP = 1, MODELS = 2, FRACTION_TO_BOUNDARY = 3, KKT_ERRORS = 4, SLACKS = 5
+  };
+
   /**
    * \brief Select elements from a vector based on a boolean mask.
    * \param[in] mask The boolean mask.
@@ -178,21 +223,29 @@ namespace Pipal
 
   /**
    * \brief Insert a sparse block into a sparse matrix at the specified offsets.
+   *
+   * Only the non-zero entries of the selected columns are visited, so that the cost is linear in
+   * the number of non-zeros rather than in the size of the block. The block may be a sparse matrix
+   * or a read-only view of externally owned compressed column storage.
    * \tparam Real Floating-point type used by the algorithm.
-   * \tparam CheckZero Whether to skip zero entries when inserting.
+   * \tparam Block Column-major compressed sparse matrix type of the block.
    * \param[in, out] mat Sparse matrix where to insert the block.
    * \param[in] blk Sparse matrix block to insert.
    * \param[in] row_index Row indices in the block matrix.
    * \param[in] col_index Column indices in the block matrix.
    * \param[in] row_offset Row offset in the sparse matrix.
    * \param[in] col_offset Column offset in the sparse matrix.
+   * \param[in] scale Factor multiplying the inserted entries.
    */
-  template <typename Real>
-  static void insert_block(SparseMatrix<Real> & mat, SparseMatrix<Real> const & blk,
-    Indices const row_index, Indices const col_index, Integer const row_offset, Integer const col_offset)
+  template <typename Real, typename Block>
+  static void insert_block(SparseMatrix<Real> & mat, Eigen::SparseCompressedBase<Block> const & blk,
+    Indices const & row_index, Indices const & col_index, Integer const row_offset, Integer const col_offset,
+    Real const scale = 1.0)
   {
     #define CMD "Pipal::Solver::insert_block(...): "
 
+    static_assert(!Block::IsRowMajor, CMD "block must be stored in column-major order");
+
     // Get sizes
     const Integer mat_cols{static_cast<Integer>(mat.cols())}, mat_rows{static_cast<Integer>(mat.rows())};
     const Integer idx_rows{static_cast<Integer>(row_index.size())};
@@ -207,13 +260,17 @@ namespace Pipal
       CMD "inserting block exceeds matrix row dimensions.");
     PIPAL_ASSERT(col_offset + idx_cols <= mat_cols,
       CMD "inserting block exceeds matrix column dimensions.");
+    if (idx_rows == 0 || idx_cols == 0) {return;}
+
+    // Map block rows to inserted rows (-1 if not selected)
+    Indices row_map(Indices::Constant(blk.rows(), -1));
+    for (Integer r{0}; r < idx_rows; ++r) {row_map(row_index(r)) = r;}
 
     // Insert block
-    for (Integer r{0}; r < idx_rows; ++r) {
-      for (Integer c{0}; c < idx_cols; ++c) {
-        if (blk.coeff(row_index(r), col_index(c)) != 0) {
-          mat.coeffRef(r + row_offset, c + col_offset) = blk.coeff(row_index(r), col_index(c));
-        }
+    for (Integer c{0}; c < idx_cols; ++c) {
+      for (typename Block::InnerIterator it(blk.derived(), col_index(c)); it; ++it) {
+        Integer const r{row_map(it.row())};
+        if (r >= 0 && it.value() != 0) {mat.coeffRef(r + row_offset, c + col_offset) = scale*it.value();}
       }
     }
 
@@ -230,7 +287,7 @@ namespace Pipal
     static constexpr Real    rhs_bnd{1.0e+18};       /*!< Maximum absolute value allowed for constraint right-hand side. */
     static constexpr Real    grad_max{1.0e+02};      /*!< Gradient norm limit for scaling. */
     static constexpr Real    infeas_max{1.0e+02};    /*!< Infeasibility limit for penalty parameter update. */
-    static constexpr Real    nnz_max{2.0e+04};       /*!< Maximum non-zeros in (upper triangle of) Newton matrix. */
+    static constexpr Real    nnz_max{2.0e+04};       /*!< Maximum non-zeros in (lower triangle of) Newton matrix. */
     static constexpr Integer opt_err_mem{6};         /*!< Optimality error history length. */
     static constexpr Real    ls_factor{5.0e-01};     /*!< Line search reduction factor. */
     static constexpr Real    ls_thresh{1.0e-08};     /*!< Line search threshold value. */
@@ -254,8 +311,26 @@ namespace Pipal
     static constexpr Real    update_con_1{1.0e-02};  /*!< Steering rule constant 1. */
     static constexpr Real    update_con_2{1.0e-02};  /*!< Steering rule constant 2. */
     static constexpr Real    update_con_3{1.01};     /*!< Adaptive interior-point rule constant. */
+    static constexpr Integer equil_iter_max{10};     /*!< Newton matrix equilibration maximum number of iterations. */
+    static constexpr Real    equil_tol{1.0e-02};     /*!< Newton matrix equilibration tolerance on row norms. */
+    static constexpr Integer par_nnz_min{10000};     /*!< Minimum non-zeros for multithreaded sparse products. */
+    static constexpr Real    screen_tol{1.0e-08};    /*!< Screening threshold on the curvature of eliminated inequality constraints. */
+    static constexpr Integer polish_stable{3};       /*!< Active set unchanged iterations before polishing. */
+    static constexpr Integer polish_iter_max{3};     /*!< Polishing maximum number of Newton iterations. */
+    static constexpr Integer sep_rounds_max{100};    /*!< Maximum number of separation rounds. */
+    static constexpr Real    sep_mu{1.0e-04};        /*!< Interior-point parameter minimum value after a separation round. */
+    static constexpr Integer prune_stable{3};        /*!< Unchanged parameter choices before the trial grid is shrunk. */
+    static constexpr Real    var_scale_max{1.0e+06}; /*!< Primal variable scaling factor maximum (and inverse minimum) value. */
+    static constexpr Real    infeas_dec{1.0e-02};    /*!< Relative violation decrease below which the violation is stagnant. */
+    static constexpr Integer infeas_stable{3};       /*!< Stagnant violation iterations before early infeasibility detection. */
+    static constexpr Real    corr_step{1.0e-01};     /*!< Step length increase sought by a centrality corrector. */
+    static constexpr Real    corr_gain{1.0e-01};     /*!< Fraction of the step length increase for corrector acceptance. */
+    static constexpr Real    corr_beta_min{1.0e-01}; /*!< Lower complementarity target factor of the correctors. */
+    static constexpr Real    corr_beta_max{1.0e+01}; /*!< Upper complementarity target factor of the correctors. */
+    static constexpr Real    corr_ratio{2.0e+01};    /*!< Factorization to solve cost ratio for each additional corrector. */
 
     Real      opt_err_tol{1.0e-6};            /*!< Default optimality tolerance. */
+    Real      infeas_tol{1.0e-2};             /*!< Feasibility problem optimality error for early infeasibility detection. */
     Integer   iter_max{1000};                 /*!< Default iteration limit. */
     Algorithm algorithm{Algorithm::ADAPTIVE}; /*!< Algorithm choice. */
     Real      mu_max_exp{0.0};                /*!< Interior-point parameter maximum exponent in increases. */
@@ -289,6 +364,9 @@ namespace Pipal
     Integer H{0}; /*!< Hessian evaluation counter. */
     Integer k{0}; /*!< Iteration counter. */
     Integer M{0}; /*!< Matrix factorization counter. */
+    Integer S{0}; /*!< Separation rounds counter. */
+    Integer T{0}; /*!< Trial steps counter. */
+    Integer C{0}; /*!< Centrality correctors counter. */
 
     /**
      * \brief Default constructor.
@@ -307,6 +385,27 @@ namespace Pipal
 
   }; // struct Counter
 
+  /**
+   * \brief Snapshot of the solver progress, published once per iteration.
+   * \tparam Real The real number type.
+   */
+  template<typename Real>
+  struct Progress
+  {
+    bool    running{false}; /*!< Solve in progress flag. */
+    Integer k{0};           /*!< Iteration counter. */
+    Integer f_count{0};     /*!< Function evaluation counter. */
+    Integer g_count{0};     /*!< Gradient evaluation counter. */
+    Integer H_count{0};     /*!< Hessian evaluation counter. */
+    Integer M_count{0};     /*!< Matrix factorization counter. */
+    Integer S_count{0};     /*!< Separation rounds counter. */
+    Real    f{0.0};         /*!< Objective function value (scaled). */
+    Real    v{0.0};         /*!< Feasibility violation measure (scaled). */
+    Real    kkt[3]{};       /*!< KKT errors (feasibility, penalty, penalty-interior-point). */
+    Real    rho{0.0};       /*!< Penalty parameter. */
+    Real    mu{0.0};        /*!< Interior-point parameter. */
+  }; // struct Progress
+
   /**
    * \brief Input structure holding all the data defining the optimization problem.
    * \tparam Real The real number type.
@@ -368,6 +467,9 @@ namespace Pipal
 
   }; // struct Input
 
+  // Sparse LDLT factorization (defined in LDLT.hxx)
+  template<typename Real> class SparseLDLT;
+
   /**
    * \brief Class for managing the current iterate of the solver.
    * \tparam Real The real number type.
@@ -375,7 +477,7 @@ namespace Pipal
   template<typename Real>
   struct Iterate
   {
-    using LDLT = Eigen::SimplicialLDLT<SparseMatrix<Real>, Eigen::Lower>;
+    using LDLT = SparseLDLT<Real>;
 
     Vector<Real>       x;     /*!< Primal point. */
     Real               rho;   /*!< Penalty parameter value. */
@@ -388,12 +490,18 @@ namespace Pipal
     Array<Real>        r2;    /*!< Equality constraint slack value. */
     Array<Real>        cE;    /*!< Equality constraint value (scaled). */
     SparseMatrix<Real> JE;    /*!< Equality constraint Jacobian value. */
+    SparseMatrixRow<Real> JEr; /*!< Equality constraint Jacobian value (row-major copy). */
+    Indices            JEp;   /*!< Equality constraint Jacobian entry positions in the row-major copy. */
+    Indices            JEi;   /*!< Equality constraint Jacobian entry rows in the row-major copy. */
     Integer            JEnnz; /*!< Equality constraint Jacobian nonzeros. */
     Array<Real>        lE;    /*!< Equality constraint multipliers. */
     Array<Real>        s1;    /*!< Inequality constraint slack value. */
     Array<Real>        s2;    /*!< Inequality constraint slack value. */
     Array<Real>        cI;    /*!< Inequality constraint value (scaled). */
     SparseMatrix<Real> JI;    /*!< Inequality constraint Jacobian value. */
+    SparseMatrixRow<Real> JIr; /*!< Inequality constraint Jacobian value (row-major copy). */
+    Indices            JIp;   /*!< Inequality constraint Jacobian entry positions in the row-major copy. */
+    Indices            JIi;   /*!< Inequality constraint Jacobian entry rows in the row-major copy. */
     Integer            JInnz; /*!< Inequality constraint Jacobian nonzeros. */
     Array<Real>        lI;    /*!< Inequality constraint multipliers. */
     SparseMatrix<Real> H;     /*!< Hessian of Lagrangian. */
@@ -403,7 +511,9 @@ namespace Pipal
     Real               v0;    /*!< Feasibility violation measure initial value. */
     Real               phi;   /*!< Merit function value. */
     LDLT               ldlt;  /*!< LDLT factorization of Newton matrix. */
-    Integer            Annz;  /*!< Newton matrix (upper triangle) nonzeros. */
+    Integer            Annz;  /*!< Newton matrix (lower triangle) nonzeros. */
+    Indices            Adiag; /*!< Newton matrix Hessian diagonal entries positions. */
+    Array<Real>        Hdiag; /*!< Hessian of Lagrangian diagonal (unshifted). */
     Real               shift; /*!< Hessian shift value. */
     Vector<Real>       b;     /*!< Newton right-hand side. */
     Vector<Real>       kkt;   /*!< KKT errors. */
@@ -411,14 +521,28 @@ namespace Pipal
     Integer            err;   /*!< Function evaluation error flag. */
 
     Real               fs;      /*!< Objective scaling factor. */
+    Array<Real>        xs;      /*!< Primal variable scaling factors (empty if disabled). */
     Array<Real>        cEs;     /*!< Equality constraint scaling factors. */
     Array<Real>        cEu;     /*!< Equality constraint value (unscaled). */
     Array<Real>        cIs;     /*!< Inequality constraint scaling factors. */
     Array<Real>        cIu;     /*!< Inequality constraint value (unscaled). */
     SparseMatrix<Real> A;       /*!< Newton matrix. */
+    SparseMatrix<Real> Ae;      /*!< Equilibrated Newton matrix. */
+    Array<Real>        Ad;      /*!< Newton matrix equilibration factors. */
+    Integer            Ait;     /*!< Newton matrix equilibration iterations. */
     Real               shift22; /*!< Newton matrix (2,2)-block shift value. */
+    Indices            Ikept;   /*!< Inequality constraints kept in the Newton matrix. */
+    Indices            Ipos;    /*!< Inequality constraints positions in the Newton matrix (-1 if screened). */
     Real               v_;      /*!< Feasibility violation measure last value. */
     bool               cut_;    /*!< Boolean value for last backtracking line search. */
+    Mask               active;  /*!< Active inequality constraints. */
+    Integer            active_k; /*!< Active set unchanged iterations. */
+    Integer            trials;  /*!< Trial steps evaluated in the last step computation. */
+    Integer            trial_k; /*!< Penalty parameter trial index of the last choice (-1 if none). */
+    Integer            trial_j; /*!< Interior-point parameter trial index of the last choice (-1 if none). */
+    Integer            trial_n; /*!< Trial choice unchanged iterations. */
+    Integer            infeas_k; /*!< Stagnant violation iterations at a stationary point of the violation. */
+    Real               t_factor; /*!< Time of the last Newton matrix factorization (in seconds). */
 
     /**
      * \brief Default constructor.
@@ -0,0 +1,222 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef INCLUDE_PIPAL_H
+#define INCLUDE_PIPAL_H
+
+/**
+ * \file pipal.h
+ * \brief C interface to the Pipal solver (double precision).
+ *
+ * The solver is an opaque handle created by pipal_create() and released by pipal_destroy(). The
+ * problem is defined by callbacks that receive raw pointers: the primal variables and multipliers
+ * are read-only views of solver-owned buffers, and the outputs are written straight into
+ * solver-owned buffers of the documented size. The sparsity patterns of the constraints Jacobian
+ * and of the Hessian of the Lagrangian are given once, in compressed sparse column (CSC) format
+ * with zero-based indices, and the callbacks write only the nonzero values in the same order.
+ * Callbacks return a nonzero value on success and zero on failure. All functions of the interface
+ * are exception-free, errors are reported by the return value and by pipal_last_error().
+ */
+
+#include <stddef.h>
+
+#if defined(_WIN32) && defined(PIPAL_C_API_EXPORTS)
+  #define PIPAL_C_API __declspec(dllexport)
+#elif defined(_WIN32) && defined(PIPAL_C_API_SHARED)
+  #define PIPAL_C_API __declspec(dllimport)
+#elif defined(__GNUC__)
+  #define PIPAL_C_API __attribute__((visibility("default")))
+#else
+  #define PIPAL_C_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Opaque solver handle. */
+typedef struct pipal_solver pipal_solver_t;
+
+/** \brief Status codes returned by the interface functions. */
+typedef enum pipal_status {
+  PIPAL_SUCCESS          =  0, /*!< Success (for pipal_solve(), the solver converged). */
+  PIPAL_FAILURE          =  1, /*!< The solver terminated without convergence. */
+  PIPAL_INVALID_ARGUMENT = -1, /*!< Invalid argument (see pipal_last_error()). */
+  PIPAL_SOLVER_ERROR     = -2  /*!< Error raised by the solver (see pipal_last_error()). */
+} pipal_status_t;
+
+/** \brief Algorithm modes. */
+typedef enum pipal_algorithm {
+  PIPAL_CONSERVATIVE = 0, /*!< Conservative penalty parameter update. */
+  PIPAL_ADAPTIVE     = 1  /*!< Adaptive penalty parameter update. */
+} pipal_algorithm_t;
+
+/**
+ * \brief Objective function callback.
+ * \param[in] user User data pointer.
+ * \param[in] n Number of primal variables.
+ * \param[in] x Primal variables (\c n values).
+ * \param[out] f Objective function value.
+ */
+typedef int (*pipal_objective_t)(void * user, int n, double const * x, double * f);
+
+/**
+ * \brief Objective function gradient callback.
+ * \param[in] user User data pointer.
+ * \param[in] n Number of primal variables.
+ * \param[in] x Primal variables (\c n values).
+ * \param[out] g Gradient of the objective function (\c n values).
+ */
+typedef int (*pipal_gradient_t)(void * user, int n, double const * x, double * g);
+
+/**
+ * \brief Constraints function callback.
+ * \param[in] user User data pointer.
+ * \param[in] n Number of primal variables.
+ * \param[in] x Primal variables (\c n values).
+ * \param[in] m Number of constraints.
+ * \param[out] c Constraints values (\c m values).
+ */
+typedef int (*pipal_constraints_t)(void * user, int n, double const * x, int m, double * c);
+
+/**
+ * \brief Constraints Jacobian callback.
+ * \param[in] user User data pointer.
+ * \param[in] n Number of primal variables.
+ * \param[in] x Primal variables (\c n values).
+ * \param[in] nnz Number of nonzeros of the Jacobian pattern.
+ * \param[out] values Jacobian values in the order of the CSC pattern (\c nnz values).
+ */
+typedef int (*pipal_jacobian_t)(void * user, int n, double const * x, int nnz, double * values);
+
+/**
+ * \brief Hessian of the Lagrangian callback.
+ * \param[in] user User data pointer.
+ * \param[in] n Number of primal variables.
+ * \param[in] x Primal variables (\c n values).
+ * \param[in] m Number of constraints.
+ * \param[in] lambda Constraint multipliers (\c m values).
+ * \param[in] nnz Number of nonzeros of the Hessian pattern.
+ * \param[out] values Hessian values in the order of the CSC pattern (\c nnz values).
+ */
+typedef int (*pipal_hessian_t)(void * user, int n, double const * x, int m, double const * lambda,
+  int nnz, double * values);
+
+/**
+ * \brief Problem definition.
+ *
+ * The Hessian pattern must contain both triangles of the (symmetric) Hessian of the Lagrangian.
+ * Infinite bounds are given as \c +/-INFINITY.
+ */
+typedef struct pipal_problem {
+  char const *        name;        /*!< Problem name (may be NULL). */
+  int                 n;           /*!< Number of primal variables. */
+  int                 m;           /*!< Number of constraints. */
+  double const *      x_lower;     /*!< Lower bounds on the primal variables (\c n values). */
+  double const *      x_upper;     /*!< Upper bounds on the primal variables (\c n values). */
+  double const *      c_lower;     /*!< Lower bounds on the constraints (\c m values). */
+  double const *      c_upper;     /*!< Upper bounds on the constraints (\c m values). */
+  int const *         jac_colptr;  /*!< Jacobian CSC column pointers (\c n+1 values). */
+  int const *         jac_rowind;  /*!< Jacobian CSC row indices (\c jac_colptr[n] values). */
+  int const *         hess_colptr; /*!< Hessian CSC column pointers (\c n+1 values). */
+  int const *         hess_rowind; /*!< Hessian CSC row indices (\c hess_colptr[n] values). */
+  pipal_objective_t   objective;   /*!< Objective function callback. */
+  pipal_gradient_t    gradient;    /*!< Objective function gradient callback. */
+  pipal_constraints_t constraints; /*!< Constraints function callback (may be NULL if \c m = 0). */
+  pipal_jacobian_t    jacobian;    /*!< Constraints Jacobian callback (may be NULL if \c m = 0). */
+  pipal_hessian_t     hessian;     /*!< Hessian of the Lagrangian callback. */
+  void *              user;        /*!< User data pointer passed to the callbacks. */
+} pipal_problem_t;
+
+/**
+ * \brief Create a solver for a problem.
+ *
+ * The problem definition (bounds and patterns included) is copied, so that the caller arrays can be
+ * released after the call. The user data pointer must stay valid while the solver is used.
+ * \param[in] problem Problem definition.
+ * \return The solver handle, or NULL on error (see pipal_last_error()).
+ */
+PIPAL_C_API pipal_solver_t * pipal_create(pipal_problem_t const * problem);
+
+/**
+ * \brief Destroy a solver.
+ * \param[in] solver Solver handle (may be NULL).
+ */
+PIPAL_C_API void pipal_destroy(pipal_solver_t * solver);
+
+/**
+ * \brief Solve the problem.
+ * \param[in] solver Solver handle.
+ * \param[in] x_guess Initial guess for the primal variables (\c n values).
+ * \param[out] x_sol Primal solution (\c n values).
+ * \param[out] lambda_sol Constraint multipliers (\c m values, may be NULL).
+ * \return The solve status.
+ */
+PIPAL_C_API pipal_status_t pipal_solve(pipal_solver_t * solver, double const * x_guess, double * x_sol,
+  double * lambda_sol);
+
+/**
+ * \brief Set the convergence tolerance.
+ * \param[in] solver Solver handle.
+ * \param[in] tolerance Convergence tolerance (positive).
+ * \return The call status.
+ */
+PIPAL_C_API pipal_status_t pipal_set_tolerance(pipal_solver_t * solver, double tolerance);
+
+/**
+ * \brief Set the maximum number of iterations.
+ * \param[in] solver Solver handle.
+ * \param[in] max_iterations Maximum number of iterations (positive).
+ * \return The call status.
+ */
+PIPAL_C_API pipal_status_t pipal_set_max_iterations(pipal_solver_t * solver, int max_iterations);
+
+/**
+ * \brief Set the algorithm mode.
+ * \param[in] solver Solver handle.
+ * \param[in] algorithm Algorithm mode.
+ * \return The call status.
+ */
+PIPAL_C_API pipal_status_t pipal_set_algorithm(pipal_solver_t * solver, pipal_algorithm_t algorithm);
+
+/**
+ * \brief Set the verbose mode.
+ * \param[in] solver Solver handle.
+ * \param[in] verbose Verbose mode (nonzero to enable).
+ * \return The call status.
+ */
+PIPAL_C_API pipal_status_t pipal_set_verbose(pipal_solver_t * solver, int verbose);
+
+/**
+ * \brief Set the number of threads used for the sparse products and factorizations.
+ * \param[in] solver Solver handle.
+ * \param[in] threads Number of threads (positive).
+ * \return The call status.
+ */
+PIPAL_C_API pipal_status_t pipal_set_threads(pipal_solver_t * solver, int threads);
+
+/**
+ * \brief Get the number of iterations of the last solve.
+ * \param[in] solver Solver handle.
+ * \return The number of iterations, or -1 if the handle is NULL.
+ */
+PIPAL_C_API int pipal_iterations(pipal_solver_t const * solver);
+
+/**
+ * \brief Get the message of the last error raised in the calling thread.
+ * \return The error message (empty if no error occurred).
+ */
+PIPAL_C_API char const * pipal_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCLUDE_PIPAL_H */
@@ -0,0 +1,328 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// STL includes
+#include <memory>
+#include <optional>
+#include <string>
+
+// Pipal includes
+#include "Pipal.hh"
+#include "pipal.h"
+
+namespace
+{
+
+  using Real         = double;
+  using Vector       = Pipal::Vector<Real>;
+  using SparseMatrix = Pipal::SparseMatrix<Real>;
+
+  thread_local std::string last_error; /*!< Message of the last error raised in the calling thread. */
+
+  /**
+   * \brief Build a sparsity pattern (with zero values) from CSC arrays.
+   * \param[in] rows Number of rows.
+   * \param[in] cols Number of columns.
+   * \param[in] colptr Column pointers (\c cols+1 values).
+   * \param[in] rowind Row indices (\c colptr[cols] values).
+   * \param[in] what Name of the matrix (for error messages).
+   * \return The sparsity pattern.
+   */
+  SparseMatrix make_pattern(int const rows, int const cols, int const * colptr, int const * rowind,
+    char const * what)
+  {
+    #define CMD "pipal_create(...): "
+
+    PIPAL_ASSERT(colptr != nullptr && colptr[0] == 0, CMD "invalid " << what << " column pointers");
+    std::vector<Eigen::Triplet<Real>> triplets;
+    for (int j{0}; j < cols; ++j) {
+      PIPAL_ASSERT(colptr[j+1] >= colptr[j], CMD "invalid " << what << " column pointers");
+      for (int k{colptr[j]}; k < colptr[j+1]; ++k) {
+        PIPAL_ASSERT(rowind != nullptr && rowind[k] >= 0 && rowind[k] < rows &&
+          (k == colptr[j] || rowind[k] > rowind[k-1]),
+          CMD "invalid " << what << " row indices (must be in range and increasing in each column)");
+        triplets.emplace_back(rowind[k], j, 0.0);
+      }
+    }
+    SparseMatrix pattern(rows, cols);
+    pattern.setFromTriplets(triplets.begin(), triplets.end());
+    pattern.makeCompressed();
+    return pattern;
+
+    #undef CMD
+  }
+
+  /**
+   * \brief Problem defined by the C interface callbacks.
+   *
+   * The callbacks read the primal variables and multipliers directly from the solver buffers, and
+   * write the derivatives in place into the stored CSC matrices, which are exposed to the solver
+   * through views (see \c constraints_jacobian_view_at and \c lagrangian_hessian_view_at).
+   */
+  class CProblem : public Pipal::Problem<Real>
+  {
+    pipal_problem_t m_problem;  /*!< Problem definition (callbacks and user data). */
+    Vector          m_bl;       /*!< Lower bounds on the primal variables. */
+    Vector          m_bu;       /*!< Upper bounds on the primal variables. */
+    Vector          m_cl;       /*!< Lower bounds on the constraints. */
+    Vector          m_cu;       /*!< Upper bounds on the constraints. */
+    mutable SparseMatrix m_J;   /*!< Constraints Jacobian (evaluated in place). */
+    mutable SparseMatrix m_H;   /*!< Hessian of the Lagrangian (evaluated in place). */
+    std::optional<Pipal::SparseMap<Real>> m_J_view; /*!< Constraints Jacobian view. */
+    std::optional<Pipal::SparseMap<Real>> m_H_view; /*!< Hessian of the Lagrangian view. */
+    mutable Vector  m_l;        /*!< Multipliers buffer (used if the solver omits free constraints). */
+
+  public:
+    /**
+     * \brief CProblem constructor (copies and validates the problem definition).
+     * \param[in] problem Problem definition.
+     */
+    explicit CProblem(pipal_problem_t const & problem)
+      : Pipal::Problem<Real>(problem.name != nullptr ? problem.name : "(Unnamed Pipal C Problem)"),
+        m_problem(problem)
+    {
+      #define CMD "pipal_create(...): "
+
+      int const n{problem.n}, m{problem.m};
+      PIPAL_ASSERT(n > 0 && m >= 0, CMD "invalid problem size");
+      PIPAL_ASSERT(problem.objective != nullptr && problem.gradient != nullptr && problem.hessian != nullptr,
+        CMD "objective, gradient and Hessian callbacks must be set");
+      PIPAL_ASSERT(m == 0 || (problem.constraints != nullptr && problem.jacobian != nullptr),
+        CMD "constraints and Jacobian callbacks must be set");
+      PIPAL_ASSERT(problem.x_lower != nullptr && problem.x_upper != nullptr,
+        CMD "bounds on the primal variables must be set");
+      PIPAL_ASSERT(m == 0 || (problem.c_lower != nullptr && problem.c_upper != nullptr),
+        CMD "bounds on the constraints must be set");
+
+      this->m_bl = Eigen::Map<Vector const>(problem.x_lower, n);
+      this->m_bu = Eigen::Map<Vector const>(problem.x_upper, n);
+      this->m_cl.resize(m);
+      this->m_cu.resize(m);
+      if (m > 0) {
+        this->m_cl = Eigen::Map<Vector const>(problem.c_lower, m);
+        this->m_cu = Eigen::Map<Vector const>(problem.c_upper, m);
+        this->m_J = make_pattern(m, n, problem.jac_colptr, problem.jac_rowind, "Jacobian");
+      } else {
+        this->m_J.resize(0, n);
+      }
+      this->m_H = make_pattern(n, n, problem.hess_colptr, problem.hess_rowind, "Hessian");
+      this->m_J_view.emplace(this->m_J.rows(), this->m_J.cols(), this->m_J.nonZeros(), this->m_J.outerIndexPtr(),
+        this->m_J.innerIndexPtr(), this->m_J.valuePtr());
+      this->m_H_view.emplace(this->m_H.rows(), this->m_H.cols(), this->m_H.nonZeros(), this->m_H.outerIndexPtr(),
+        this->m_H.innerIndexPtr(), this->m_H.valuePtr());
+
+      #undef CMD
+    }
+
+    bool objective(Vector const & x, Real & out) const override {
+      return this->m_problem.objective(this->m_problem.user, this->m_problem.n, x.data(), &out) != 0 &&
+        std::isfinite(out);
+    }
+
+    bool objective_gradient(Vector const & x, Vector & out) const override {
+      out.resize(this->m_problem.n);
+      return this->m_problem.gradient(this->m_problem.user, this->m_problem.n, x.data(), out.data()) != 0 &&
+        out.allFinite();
+    }
+
+    bool constraints(Vector const & x, Vector & out) const override {
+      out.resize(this->m_problem.m);
+      if (this->m_problem.m == 0) {return true;}
+      return this->m_problem.constraints(this->m_problem.user, this->m_problem.n, x.data(),
+        this->m_problem.m, out.data()) != 0 && out.allFinite();
+    }
+
+    bool constraints_jacobian(Vector const & x, SparseMatrix & out) const override {
+      Pipal::SparseMap<Real> const * view{nullptr};
+      if (!this->constraints_jacobian_view_at(x, view)) {return false;}
+      out = *view;
+      return true;
+    }
+
+    bool lagrangian_hessian(Vector const & x, Vector const & l, SparseMatrix & out) const override {
+      Pipal::SparseMap<Real> const * view{nullptr};
+      if (!this->lagrangian_hessian_view_at(x, l, view)) {return false;}
+      out = *view;
+      return true;
+    }
+
+    bool constraints_jacobian_view_at(Vector const & x, Pipal::SparseMap<Real> const * & out) const override {
+      out = &*this->m_J_view;
+      if (this->m_problem.m == 0) {return true;}
+      int const nnz{static_cast<int>(this->m_J.nonZeros())};
+      return this->m_problem.jacobian(this->m_problem.user, this->m_problem.n, x.data(), nnz,
+        this->m_J.valuePtr()) != 0 && Eigen::Map<Vector const>(this->m_J.valuePtr(), nnz).allFinite();
+    }
+
+    bool lagrangian_hessian_view_at(Vector const & x, Vector const & l, Pipal::SparseMap<Real> const * & out)
+      const override {
+      out = &*this->m_H_view;
+      Real const * lambda{l.data()};
+      if (l.size() != this->m_problem.m) {
+        this->m_l.setZero(this->m_problem.m);
+        this->m_l.head(std::min<Eigen::Index>(l.size(), this->m_problem.m)) =
+          l.head(std::min<Eigen::Index>(l.size(), this->m_problem.m));
+        lambda = this->m_l.data();
+      }
+      int const nnz{static_cast<int>(this->m_H.nonZeros())};
+      return this->m_problem.hessian(this->m_problem.user, this->m_problem.n, x.data(), this->m_problem.m,
+        lambda, nnz, this->m_H.valuePtr()) != 0 && Eigen::Map<Vector const>(this->m_H.valuePtr(), nnz).allFinite();
+    }
+
+    bool primal_lower_bounds(Vector & out) const override {out = this->m_bl; return true;}
+    bool primal_upper_bounds(Vector & out) const override {out = this->m_bu; return true;}
+    bool constraints_lower_bounds(Vector & out) const override {out = this->m_cl; return true;}
+    bool constraints_upper_bounds(Vector & out) const override {out = this->m_cu; return true;}
+
+  }; // class CProblem
+
+  /**
+   * \brief Run a function, converting the exceptions into error status codes.
+   * \param[in] func Function returning a status code.
+   * \return The function status code, or PIPAL_SOLVER_ERROR if an exception was raised.
+   */
+  template <typename Function>
+  pipal_status_t guard(Function && func)
+  {
+#ifdef PIPAL_NO_EXCEPTIONS
+    last_error.clear();
+    return func();
+#else
+    try {
+      last_error.clear();
+      return func();
+    } catch (std::exception const & e) {
+      last_error = e.what();
+    } catch (...) {
+      last_error = "unknown error";
+    }
+    return PIPAL_SOLVER_ERROR;
+#endif
+  }
+
+  /**
+   * \brief Report an invalid argument.
+   * \param[in] message Error message.
+   * \return PIPAL_INVALID_ARGUMENT.
+   */
+  pipal_status_t invalid(char const * message)
+  {
+    last_error = message;
+    return PIPAL_INVALID_ARGUMENT;
+  }
+
+} // namespace
+
+/**
+ * \brief Solver handle of the C interface.
+ */
+struct pipal_solver
+{
+  std::unique_ptr<Pipal::Solver<Real>> solver; /*!< Solver instance (owning the problem). */
+  int n{0};                                    /*!< Number of primal variables. */
+  int m{0};                                    /*!< Number of constraints. */
+  Vector x_guess;                              /*!< Initial guess buffer. */
+  Vector x_sol;                                /*!< Primal solution buffer. */
+  Vector l_sol;                                /*!< Multipliers buffer. */
+};
+
+extern "C" {
+
+pipal_solver_t * pipal_create(pipal_problem_t const * problem)
+{
+  if (problem == nullptr) {invalid("pipal_create(...): null problem"); return nullptr;}
+  std::unique_ptr<pipal_solver_t> handle;
+  pipal_status_t const status{guard([&] () {
+    handle = std::make_unique<pipal_solver_t>();
+    handle->solver = std::make_unique<Pipal::Solver<Real>>(std::make_unique<CProblem>(*problem));
+    handle->n = problem->n;
+    handle->m = problem->m;
+    return PIPAL_SUCCESS;
+  })};
+  return status == PIPAL_SUCCESS ? handle.release() : nullptr;
+}
+
+void pipal_destroy(pipal_solver_t * solver)
+{
+  delete solver;
+}
+
+pipal_status_t pipal_solve(pipal_solver_t * solver, double const * x_guess, double * x_sol,
+  double * lambda_sol)
+{
+  if (solver == nullptr || x_guess == nullptr || x_sol == nullptr) {
+    return invalid("pipal_solve(...): null argument");
+  }
+  return guard([&] () {
+    solver->x_guess = Eigen::Map<Vector const>(x_guess, solver->n);
+    bool const success{solver->solver->optimize(solver->x_guess, solver->x_sol)};
+    Eigen::Map<Vector>(x_sol, solver->n) = solver->x_sol;
+    if (lambda_sol != nullptr) {
+      solver->solver->getSolution(solver->x_sol, solver->l_sol);
+      Eigen::Index const nL{std::min<Eigen::Index>(solver->l_sol.size(), solver->m)};
+      Eigen::Map<Vector> l(lambda_sol, solver->m);
+      l.setZero();
+      l.head(nL) = solver->l_sol.head(nL);
+    }
+    return success ? PIPAL_SUCCESS : PIPAL_FAILURE;
+  });
+}
+
+pipal_status_t pipal_set_tolerance(pipal_solver_t * solver, double tolerance)
+{
+  if (solver == nullptr) {return invalid("pipal_set_tolerance(...): null solver");}
+  if (!(tolerance > 0.0)) {return invalid("pipal_set_tolerance(...): tolerance must be positive");}
+  return guard([&] () {solver->solver->tolerance(tolerance); return PIPAL_SUCCESS;});
+}
+
+pipal_status_t pipal_set_max_iterations(pipal_solver_t * solver, int max_iterations)
+{
+  if (solver == nullptr) {return invalid("pipal_set_max_iterations(...): null solver");}
+  if (max_iterations <= 0) {return invalid("pipal_set_max_iterations(...): maximum iterations must be positive");}
+  return guard([&] () {solver->solver->max_iterations(max_iterations); return PIPAL_SUCCESS;});
+}
+
+pipal_status_t pipal_set_algorithm(pipal_solver_t * solver, pipal_algorithm_t algorithm)
+{
+  if (solver == nullptr) {return invalid("pipal_set_algorithm(...): null solver");}
+  if (algorithm != PIPAL_CONSERVATIVE && algorithm != PIPAL_ADAPTIVE) {
+    return invalid("pipal_set_algorithm(...): invalid algorithm");
+  }
+  return guard([&] () {
+    solver->solver->algorithm(algorithm == PIPAL_CONSERVATIVE ? Pipal::Algorithm::CONSERVATIVE :
+      Pipal::Algorithm::ADAPTIVE);
+    return PIPAL_SUCCESS;
+  });
+}
+
+pipal_status_t pipal_set_verbose(pipal_solver_t * solver, int verbose)
+{
+  if (solver == nullptr) {return invalid("pipal_set_verbose(...): null solver");}
+  return guard([&] () {solver->solver->verbose_mode(verbose != 0); return PIPAL_SUCCESS;});
+}
+
+pipal_status_t pipal_set_threads(pipal_solver_t * solver, int threads)
+{
+  if (solver == nullptr) {return invalid("pipal_set_threads(...): null solver");}
+  if (threads <= 0) {return invalid("pipal_set_threads(...): number of threads must be positive");}
+  return guard([&] () {solver->solver->threads(threads); return PIPAL_SUCCESS;});
+}
+
+int pipal_iterations(pipal_solver_t const * solver)
+{
+  return solver != nullptr ? solver->solver->counter().k : -1;
+}
+
+char const * pipal_last_error(void)
+{
+  return last_error.c_str();
+}
+
+} // extern "C"
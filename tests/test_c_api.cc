@@ -0,0 +1,100 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// STL includes
+#include <cmath>
+#include <string>
+
+// GTest library
+#include <gtest/gtest.h>
+
+// Pipal C interface
+#include "pipal.h"
+
+constexpr double SOLVER_TOLERANCE{1.0e-10};
+constexpr double APPROX_TOLERANCE{1.0e-3};
+
+// Rosenbrock function with the constraint x0^2 + x1^2 <= 1
+static int objective(void *, int, double const * x, double * f) {
+  *f = 100.0*std::pow(x[1] - x[0]*x[0], 2.0) + std::pow(1.0 - x[0], 2.0);
+  return 1;
+}
+
+static int gradient(void *, int, double const * x, double * g) {
+  g[0] = -400.0*x[0]*(x[1] - x[0]*x[0]) - 2.0*(1.0 - x[0]);
+  g[1] = 200.0*(x[1] - x[0]*x[0]);
+  return 1;
+}
+
+static int constraints(void *, int, double const * x, int, double * c) {
+  c[0] = x[0]*x[0] + x[1]*x[1];
+  return 1;
+}
+
+static int jacobian(void * user, int, double const * x, int nnz, double * values) {
+  ++*static_cast<int *>(user);
+  if (nnz != 2) {return 0;}
+  values[0] = 2.0*x[0];
+  values[1] = 2.0*x[1];
+  return 1;
+}
+
+static int hessian(void *, int, double const * x, int, double const * lambda, int nnz, double * values) {
+  if (nnz != 4) {return 0;}
+  values[0] = 1200.0*x[0]*x[0] - 400.0*x[1] + 2.0 + 2.0*lambda[0];
+  values[1] = -400.0*x[0];
+  values[2] = -400.0*x[0];
+  values[3] = 200.0 + 2.0*lambda[0];
+  return 1;
+}
+
+TEST(Test1, Solve) {
+  int jacobian_calls{0};
+  double const x_lower[2]{-INFINITY, -INFINITY}, x_upper[2]{INFINITY, INFINITY};
+  double const c_lower[1]{-INFINITY}, c_upper[1]{1.0};
+  int const jac_colptr[3]{0, 1, 2}, jac_rowind[2]{0, 0};
+  int const hess_colptr[3]{0, 2, 4}, hess_rowind[4]{0, 1, 0, 1};
+  pipal_problem_t problem{"test_c_api", 2, 1, x_lower, x_upper, c_lower, c_upper, jac_colptr, jac_rowind,
+    hess_colptr, hess_rowind, objective, gradient, constraints, jacobian, hessian, &jacobian_calls};
+
+  pipal_solver_t * solver{pipal_create(&problem)};
+  ASSERT_NE(solver, nullptr) << pipal_last_error();
+  EXPECT_EQ(pipal_set_tolerance(solver, SOLVER_TOLERANCE), PIPAL_SUCCESS);
+  EXPECT_EQ(pipal_set_max_iterations(solver, 100), PIPAL_SUCCESS);
+  EXPECT_EQ(pipal_set_algorithm(solver, PIPAL_CONSERVATIVE), PIPAL_SUCCESS);
+  EXPECT_EQ(pipal_set_verbose(solver, 1), PIPAL_SUCCESS);
+
+  double const x_guess[2]{0.0, 0.0};
+  double x_sol[2], lambda_sol[1];
+  EXPECT_EQ(pipal_solve(solver, x_guess, x_sol, lambda_sol), PIPAL_SUCCESS) << pipal_last_error();
+  EXPECT_NEAR(x_sol[0], 0.7864, APPROX_TOLERANCE);
+  EXPECT_NEAR(x_sol[1], 0.6177, APPROX_TOLERANCE);
+  EXPECT_GT(lambda_sol[0], 0.0);
+  EXPECT_GT(pipal_iterations(solver), 0);
+  EXPECT_GT(jacobian_calls, 0);
+
+  // Errors are reported by status codes
+  EXPECT_EQ(pipal_set_tolerance(solver, -1.0), PIPAL_INVALID_ARGUMENT);
+  EXPECT_FALSE(std::string(pipal_last_error()).empty());
+  EXPECT_EQ(pipal_set_tolerance(solver, std::nan("")), PIPAL_INVALID_ARGUMENT);
+  EXPECT_EQ(pipal_set_max_iterations(solver, 0), PIPAL_INVALID_ARGUMENT);
+  EXPECT_EQ(pipal_set_threads(solver, -2), PIPAL_INVALID_ARGUMENT);
+  EXPECT_EQ(pipal_solve(nullptr, x_guess, x_sol, nullptr), PIPAL_INVALID_ARGUMENT);
+  pipal_destroy(solver);
+}
+
+TEST(Test2, InvalidPattern) {
+  double const x_lower[2]{-1.0, -1.0}, x_upper[2]{1.0, 1.0};
+  int const hess_colptr[3]{0, 2, 4}, hess_rowind[4]{1, 0, 0, 1}; // Unsorted row indices
+  pipal_problem_t problem{nullptr, 2, 0, x_lower, x_upper, nullptr, nullptr, nullptr, nullptr,
+    hess_colptr, hess_rowind, objective, gradient, nullptr, nullptr, hessian, nullptr};
+  EXPECT_EQ(pipal_create(&problem), nullptr);
+  EXPECT_NE(std::string(pipal_last_error()).find("Hessian"), std::string::npos);
+}
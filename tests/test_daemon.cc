@@ -0,0 +1,197 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// STL includes
+#include <cstring>
+#include <limits>
+#include <memory>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// GTest library
+#include <gtest/gtest.h>
+
+// Pipal includes
+#include "PipalDaemon.hh"
+
+using Pipal::Integer;
+using Real         = double;
+using Vector       = Pipal::Vector<Real>;
+using SparseMatrix = Pipal::SparseMatrix<Real>;
+
+constexpr Real SOLVER_TOLERANCE{1.0e-10};
+constexpr Real APPROX_TOLERANCE{1.0e-3};
+
+// Rosenbrock function (a - x0)^2 + b (x1 - x0^2)^2, with data (a, b) and constraint x0 + x1 <= c
+class Rosenbrock : public Pipal::DaemonProblem<Real>
+{
+public:
+  Rosenbrock() : Pipal::DaemonProblem<Real>("test_daemon_rosenbrock") {}
+
+  bool update() override {return this->data().size() == 2 && this->data()(1) > 0.0;}
+
+  Integer data_size() const override {return 2;}
+
+  Integer primal_size() const override {return 2;}
+
+  Integer constraints_size() const override {return 1;}
+
+  bool objective(Vector const & x, Real & out) const override {
+    Real const a{this->data()(0)}, b{this->data()(1)};
+    out = b*std::pow(x(1) - x(0)*x(0), 2.0) + std::pow(a - x(0), 2.0);
+    return std::isfinite(out);
+  }
+
+  bool objective_gradient(Vector const & x, Vector & out) const override {
+    Real const a{this->data()(0)}, b{this->data()(1)};
+    out.resize(2);
+    out << -4.0*b*x(0)*(x(1)-x(0)*x(0)) - 2.0*(a - x(0)), 2.0*b*(x(1) - x(0)*x(0));
+    return out.allFinite();
+  }
+
+  bool constraints(Vector const & x, Vector & out) const override {
+    out.resize(1);
+    out << x(0) + x(1);
+    return out.allFinite();
+  }
+
+  bool constraints_jacobian(Vector const &, SparseMatrix & out) const override {
+    out.resize(1, 2);
+    out.insert(0, 0) = 1.0;
+    out.insert(0, 1) = 1.0;
+    return true;
+  }
+
+  bool lagrangian_hessian(Vector const & x, Vector const &, SparseMatrix & out) const override {
+    Real const b{this->data()(1)};
+    out.resize(2,2);
+    std::vector<Eigen::Triplet<Real>> triplets{
+      {0, 0, 12.0*b*x(0)*x(0) - 4.0*b*x(1) + 2},
+      {0, 1, -4.0*b*x(0)},
+      {1, 0, -4.0*b*x(0)},
+      {1, 1, 2.0*b}
+    };
+    out.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::Map<Vector> vec( out.valuePtr(), out.nonZeros() );
+    return vec.allFinite();
+  }
+};
+
+TEST(Test1, DaemonSolve) {
+  std::string const path{"/tmp/pipal_test_daemon_" + std::to_string(::getpid()) + ".sock"};
+  Pipal::Daemon<Real> daemon(path);
+  daemon.add_model("rosenbrock", [] () {return std::make_unique<Rosenbrock>();}, 2,
+    [] (Pipal::Solver<Real> & solver) {
+      solver.algorithm(Pipal::Algorithm::CONSERVATIVE);
+      solver.tolerance(SOLVER_TOLERANCE);
+    });
+  daemon.start();
+  EXPECT_TRUE(daemon.running());
+
+  // Solve a sequence of problems with the same structure on a warmed solver
+  Pipal::DaemonClient<Real> client(path);
+  Real const inf{std::numeric_limits<Real>::infinity()};
+  Vector data(2), bl(2), bu(2), cl(1), cu(1), x_guess(2), x_sol, l_sol, x_opt(2);
+  bl.setConstant(-inf); bu.setConstant(inf); cl << -inf; cu << 10.0;
+  x_guess.setZero();
+  for (Real const a : {1.0, 1.5, 2.0}) {
+    data << a, 100.0;
+    x_opt << a, a*a;
+    Pipal::DaemonReply const reply{client.solve("rosenbrock", data, bl, bu, cl, cu, x_guess, x_sol, l_sol)};
+    EXPECT_EQ(reply.status, Pipal::DaemonStatus::SUCCESS);
+    EXPECT_GT(reply.iterations, 0);
+    EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+    EXPECT_EQ(l_sol.size(), 1);
+    x_guess = x_sol;
+  }
+
+  // Active constraint x0 + x1 <= 1 changes the solution
+  cu << 1.0;
+  data << 1.0, 100.0;
+  Pipal::DaemonReply reply{client.solve("rosenbrock", data, bl, bu, cl, cu, x_guess, x_sol, l_sol)};
+  EXPECT_EQ(reply.status, Pipal::DaemonStatus::SUCCESS);
+  EXPECT_NEAR(x_sol.sum(), 1.0, APPROX_TOLERANCE);
+
+  // Errors are reported in the reply
+  reply = client.solve("unknown", data, bl, bu, cl, cu, x_guess, x_sol, l_sol);
+  EXPECT_EQ(reply.status, Pipal::DaemonStatus::UNKNOWN_MODEL);
+  data << 1.0, -1.0;
+  reply = client.solve("rosenbrock", data, bl, bu, cl, cu, x_guess, x_sol, l_sol);
+  EXPECT_EQ(reply.status, Pipal::DaemonStatus::BAD_PAYLOAD);
+
+  daemon.stop();
+  EXPECT_FALSE(daemon.running());
+}
+
+TEST(Test2, DaemonMalformedHeader) {
+  std::string const path{"/tmp/pipal_test_daemon_" + std::to_string(::getpid()) + "_bad.sock"};
+  Pipal::Daemon<Real> daemon(path);
+  daemon.add_model("rosenbrock", [] () {return std::make_unique<Rosenbrock>();});
+  daemon.start();
+
+  // Sizes not matching the model structure are rejected by the client interface too
+  Pipal::DaemonClient<Real> client(path);
+  Vector data(2), b3(3), cl(1), cu(1), x_guess(3), x_sol, l_sol;
+  data << 1.0, 100.0; b3.setZero(); cl << 0.0; cu << 1.0; x_guess.setZero();
+  Pipal::DaemonReply reply{client.solve("rosenbrock", data, b3, b3, cl, cu, x_guess, x_sol, l_sol)};
+  EXPECT_EQ(reply.status, Pipal::DaemonStatus::BAD_REQUEST);
+
+  // Raw header whose payload size wraps around to a few bytes
+  std::string const shm{"/pipal_test_daemon_" + std::to_string(::getpid())};
+  int const shm_fd{::shm_open(shm.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)};
+  ASSERT_GE(shm_fd, 0);
+  ASSERT_EQ(::ftruncate(shm_fd, 64), 0);
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+  int const fd{::socket(AF_UNIX, SOCK_STREAM, 0)};
+  ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)), 0);
+  Pipal::DaemonRequest request;
+  std::strncpy(request.model, "rosenbrock", Pipal::DAEMON_NAME_SIZE-1);
+  std::strncpy(request.shm, shm.c_str(), Pipal::DAEMON_NAME_SIZE-1);
+  for (std::uint64_t const nP : {std::numeric_limits<std::uint64_t>::max() - 4, std::uint64_t(1) << 40}) {
+    request.nP = nP; request.nV = 1; request.nC = 1;
+    ASSERT_TRUE(Pipal::daemon_send(fd, &request, sizeof(request)));
+    ASSERT_TRUE(Pipal::daemon_recv(fd, &reply, sizeof(reply)));
+    EXPECT_EQ(reply.status, Pipal::DaemonStatus::BAD_REQUEST);
+    request.nV = 2;
+    ASSERT_TRUE(Pipal::daemon_send(fd, &request, sizeof(request)));
+    ASSERT_TRUE(Pipal::daemon_recv(fd, &reply, sizeof(reply)));
+    EXPECT_EQ(reply.status, Pipal::DaemonStatus::BAD_REQUEST);
+  }
+
+  // Number of problem data not matching the model structure
+  request.nP = 3; request.nV = 2; request.nC = 1;
+  ASSERT_TRUE(Pipal::daemon_send(fd, &request, sizeof(request)));
+  ASSERT_TRUE(Pipal::daemon_recv(fd, &reply, sizeof(reply)));
+  EXPECT_EQ(reply.status, Pipal::DaemonStatus::BAD_REQUEST);
+
+  // Valid header with a segment too short for the payload (e.g., shrunk by the client)
+  request.nP = 2;
+  ASSERT_TRUE(Pipal::daemon_send(fd, &request, sizeof(request)));
+  ASSERT_TRUE(Pipal::daemon_recv(fd, &reply, sizeof(reply)));
+  EXPECT_EQ(reply.status, Pipal::DaemonStatus::BAD_PAYLOAD);
+
+  // The daemon keeps serving valid requests
+  Vector bl(2), bu(2), x_guess2(2);
+  bl.setConstant(-10.0); bu.setConstant(10.0); cu << 10.0; x_guess2.setZero();
+  reply = client.solve("rosenbrock", data, bl, bu, cl, cu, x_guess2, x_sol, l_sol);
+  EXPECT_EQ(reply.status, Pipal::DaemonStatus::SUCCESS);
+
+  ::close(fd);
+  ::close(shm_fd);
+  ::shm_unlink(shm.c_str());
+  daemon.stop();
+}
@@ -0,0 +1,99 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// STL includes
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+
+// GTest library
+#include <gtest/gtest.h>
+
+// Pipal includes
+#include "PipalMapped.hh"
+
+using Pipal::Integer;
+using Real         = double;
+using Vector       = Pipal::Vector<Real>;
+using SparseMatrix = Pipal::SparseMatrix<Real>;
+
+constexpr Real SOLVER_TOLERANCE{1.0e-10};
+constexpr Real APPROX_TOLERANCE{1.0e-6};
+constexpr Integer MAX_ITERATIONS{100};
+constexpr bool VERBOSE{true};
+
+// Quadratic program (x0 - 1)^2 + (x1 - 2)^2 + x2^2, subject to x0 - x1 = -1, x0 + x1 + x2 <= 2 and x >= 0
+static std::string write_problem()
+{
+  Real const inf{std::numeric_limits<Real>::infinity()};
+  std::string const path{::testing::TempDir() + "/pipal_mapped_qp.bin"};
+  SparseMatrix Q(3, 3), A(2, 3);
+  Q.insert(0, 0) = 2.0; Q.insert(1, 1) = 2.0; Q.insert(2, 2) = 2.0;
+  A.insert(0, 0) = 1.0; A.insert(0, 1) = -1.0;
+  A.insert(1, 0) = 1.0; A.insert(1, 1) = 1.0; A.insert(1, 2) = 1.0;
+  Vector c(3), bl(3), bu(3), cl(2), cu(2);
+  c << -2.0, -4.0, 0.0;
+  bl.setZero(); bu.setConstant(inf);
+  cl << -1.0, -inf;
+  cu << -1.0, 2.0;
+  EXPECT_TRUE(Pipal::write_mapped_problem<Real>(path, Q, c, A, bl, bu, cl, cu));
+  return path;
+}
+
+TEST(Test1, MappedSolve) {
+  std::string const path{write_problem()};
+  std::unique_ptr<Pipal::MappedProblem<Real>> problem(std::make_unique<Pipal::MappedProblem<Real>>(path));
+  EXPECT_EQ(problem->primal_size(), 3);
+  EXPECT_EQ(problem->constraints_size(), 2);
+
+  // The constant derivatives are views of the mapped file
+  Pipal::SparseMap<Real> const * A{problem->constraints_jacobian_view()};
+  Pipal::SparseMap<Real> const * Q{problem->lagrangian_hessian_view()};
+  ASSERT_NE(A, nullptr);
+  ASSERT_NE(Q, nullptr);
+  EXPECT_EQ(A->nonZeros(), 5);
+  EXPECT_EQ(Q->nonZeros(), 3);
+  EXPECT_EQ(A->coeff(0, 1), -1.0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(A->valuePtr()) % Pipal::MAPPED_ALIGN, 0u);
+
+  Pipal::Solver<Real> solver(std::move(problem));
+  solver.verbose_mode(VERBOSE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(3), x_guess(3), x_opt(3);
+  x_guess << 1.0, 1.0, 1.0;
+  x_opt << 0.5, 1.5, 0.0;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_LE((x_sol - x_opt).cwiseAbs().maxCoeff(), APPROX_TOLERANCE);
+  std::remove(path.c_str());
+}
+
+TEST(Test2, MappedInvalid) {
+  std::string const path{::testing::TempDir() + "/pipal_mapped_invalid.bin"};
+  EXPECT_THROW(Pipal::MappedProblem<Real>(path + ".missing"), std::runtime_error);
+  {
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    file << std::string(256, 'x');
+  }
+  EXPECT_THROW(Pipal::MappedProblem<Real>{path}, std::runtime_error);
+
+  // Truncated file
+  std::string const valid{write_problem()};
+  {
+    std::ifstream in(valid, std::ios::in | std::ios::binary);
+    std::string const data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()/2));
+  }
+  EXPECT_THROW(Pipal::MappedProblem<Real>{path}, std::runtime_error);
+  std::remove(path.c_str());
+  std::remove(valid.c_str());
+}
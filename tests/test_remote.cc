@@ -0,0 +1,182 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\
+ * Copyright (c) 2025, Davide Stocco and Enrico Bertolazzi.                                      *
+ *                                                                                               *
+ * The Pipal project is distributed under the MIT License.                                       *
+ *                                                                                               *
+ * Davide Stocco                                                               Enrico Bertolazzi *
+ * University of Trento                                                     University of Trento *
+ * e-mail: davide.stocco@unitn.it                             e-mail: enrico.bertolazzi@unitn.it *
+\* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// STL includes
+#include <cmath>
+#include <csignal>
+#include <memory>
+#include <thread>
+
+// GTest library
+#include <gtest/gtest.h>
+
+// Pipal includes
+#include "PipalRemote.hh"
+
+using Pipal::Integer;
+using Real         = double;
+using Vector       = Pipal::Vector<Real>;
+using SparseMatrix = Pipal::SparseMatrix<Real>;
+
+constexpr Real SOLVER_TOLERANCE{1.0e-10};
+constexpr Real APPROX_TOLERANCE{1.0e-6};
+constexpr Integer MAX_ITERATIONS{100};
+constexpr bool VERBOSE{true};
+
+// Problem -log(x0) + 5 x0 + (x1 - 1)^2, subject to x0 + x1 <= 3, with a faulty evaluation for x0 <= 0
+class RemoteDomain : public Pipal::Problem<Real>
+{
+public:
+  using Fault = enum class Fault : Integer {ERROR = 0, CRASH = 1, HANG = 2, CORRUPT = 3};
+
+private:
+  Fault m_fault;
+
+  bool fault() const {
+    if (this->m_fault == Fault::CRASH) {std::raise(SIGKILL);}
+    if (this->m_fault == Fault::HANG) {while (true) {std::this_thread::sleep_for(std::chrono::seconds(1));}}
+    return false;
+  }
+
+public:
+  explicit RemoteDomain(Fault t_fault) : Pipal::Problem<Real>("test_remote_domain"), m_fault(t_fault) {}
+
+  bool objective(Vector const & x, Real & out) const override {
+    if (x(0) <= 0.0) {return this->fault();}
+    out = -std::log(x(0)) + 5.0*x(0) + std::pow(x(1) - 1.0, 2.0);
+    return true;
+  }
+
+  bool objective_gradient(Vector const & x, Vector & out) const override {
+    out.resize(2);
+    out << -1.0/x(0) + 5.0, 2.0*(x(1) - 1.0);
+    return out.allFinite();
+  }
+
+  bool constraints(Vector const & x, Vector & out) const override {
+    out.resize(1);
+    out << x(0) + x(1);
+    return out.allFinite();
+  }
+
+  bool constraints_jacobian(Vector const & x, SparseMatrix & out) const override {
+    out.resize(1, 2);
+    out.insert(0, 0) = 1.0; out.insert(0, 1) = 1.0;
+    out.makeCompressed();
+    if (x(0) <= 0.0 && this->m_fault == Fault::CORRUPT) {out.outerIndexPtr()[1] = 7; out.innerIndexPtr()[0] = 5;}
+    return true;
+  }
+
+  bool lagrangian_hessian(Vector const & x, Vector const &, SparseMatrix & out) const override {
+    out.resize(2, 2);
+    out.insert(0, 0) = 1.0/(x(0)*x(0)); out.insert(1, 1) = 2.0;
+    return std::isfinite(out.coeff(0, 0));
+  }
+
+  bool primal_lower_bounds(Vector & out) const override {out.setConstant(2, -1.0e20); return true;}
+  bool primal_upper_bounds(Vector & out) const override {out.setConstant(2, +1.0e20); return true;}
+  bool constraints_lower_bounds(Vector & out) const override {out.setConstant(1, -1.0e20); return true;}
+  bool constraints_upper_bounds(Vector & out) const override {out.setConstant(1, 3.0); return true;}
+};
+
+static std::unique_ptr<Pipal::RemoteProblem<Real>> make_problem(RemoteDomain::Fault const fault)
+{
+  return std::make_unique<Pipal::RemoteProblem<Real>>(
+    [fault] () {return std::make_unique<RemoteDomain>(fault);}, 2, 1, 2, 2);
+}
+
+static Integer solve(std::unique_ptr<Pipal::RemoteProblem<Real>> problem)
+{
+  Pipal::RemoteProblem<Real> const & remote{*problem};
+  Integer const restarts{remote.restarts()};
+  Pipal::Solver<Real> solver(std::move(problem));
+  solver.verbose_mode(VERBOSE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(2), x_guess(2);
+  x_guess << 1.0, 0.0;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(solver.converged());
+  EXPECT_NEAR(x_sol(0), 0.2, APPROX_TOLERANCE);
+  EXPECT_NEAR(x_sol(1), 1.0, APPROX_TOLERANCE);
+  return remote.restarts() - restarts;
+}
+
+TEST(Test1, RemoteError) {
+  auto problem{make_problem(RemoteDomain::Fault::ERROR)};
+  Pipal::RemoteProblem<Real> const & remote{*problem};
+  pid_t const worker{remote.worker()};
+  EXPECT_GT(worker, 0);
+  EXPECT_NE(worker, ::getpid());
+
+  // The evaluation errors are reported by the worker, that keeps running
+  Vector x(2), g;
+  x << 0.5, 2.0;
+  Real f;
+  EXPECT_TRUE(remote.objective(x, f));
+  EXPECT_NEAR(f, -std::log(0.5) + 2.5 + 1.0, 1.0e-14);
+  EXPECT_TRUE(remote.objective_gradient(x, g));
+  EXPECT_NEAR(g(0), 3.0, 1.0e-14);
+  x(0) = -1.0;
+  EXPECT_FALSE(remote.objective(x, f));
+  EXPECT_EQ(remote.worker(), worker);
+  EXPECT_EQ(remote.restarts(), 0);
+  EXPECT_EQ(solve(std::move(problem)), 0);
+}
+
+TEST(Test2, RemoteCrash) {
+  auto problem{make_problem(RemoteDomain::Fault::CRASH)};
+  Pipal::RemoteProblem<Real> const & remote{*problem};
+  pid_t const worker{remote.worker()};
+
+  // The crashed worker is restarted at the next request
+  Vector x(2);
+  Real f;
+  x << -1.0, 0.0;
+  EXPECT_FALSE(remote.objective(x, f));
+  EXPECT_EQ(remote.restarts(), 1);
+  x(0) = 1.0;
+  EXPECT_TRUE(remote.objective(x, f));
+  EXPECT_NE(remote.worker(), worker);
+
+  // The crashes are rejected by the line search
+  EXPECT_GT(solve(std::move(problem)), 0);
+}
+
+TEST(Test3, RemoteCorrupt) {
+  auto problem{make_problem(RemoteDomain::Fault::CORRUPT)};
+  Pipal::RemoteProblem<Real> const & remote{*problem};
+  pid_t const worker{remote.worker()};
+
+  // Corrupted index arrays reported by the worker are rejected
+  Vector x(2);
+  SparseMatrix J;
+  x << -1.0, 0.0;
+  EXPECT_FALSE(remote.constraints_jacobian(x, J));
+  x(0) = 1.0;
+  EXPECT_TRUE(remote.constraints_jacobian(x, J));
+  EXPECT_EQ(J.nonZeros(), 2);
+  EXPECT_EQ(J.coeff(0, 1), 1.0);
+  EXPECT_EQ(remote.worker(), worker);
+  EXPECT_EQ(remote.restarts(), 0);
+}
+
+TEST(Test4, RemoteTimeout) {
+  auto problem{make_problem(RemoteDomain::Fault::HANG)};
+  problem->timeout(0.05);
+  Pipal::RemoteProblem<Real> const & remote{*problem};
+  Vector x(2);
+  Real f;
+  x << -1.0, 0.0;
+  EXPECT_FALSE(remote.objective(x, f));
+  EXPECT_EQ(remote.restarts(), 1);
+  EXPECT_EQ(remote.worker(), -1);
+  EXPECT_GT(solve(std::move(problem)), 0);
+}
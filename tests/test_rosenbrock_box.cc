@@ -11,6 +11,8 @@
 // STL includes
 #include <memory>
 #include <limits>
+#include <algorithm>
+#include <functional>
 
 // GTest library
 #include <gtest/gtest.h>
@@ -75,3 +77,474 @@ TEST(Test1, ProblemWrapper) {
   EXPECT_TRUE(solver.optimize(x_guess, x_sol));
   EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
 }
+
+class RosenbrockBox : public Pipal::StaticProblem<Real, RosenbrockBox>
+{
+public:
+  RosenbrockBox() : Pipal::StaticProblem<Real, RosenbrockBox>("test_rosenbrock_box") {}
+
+  bool objective(Vector const & x, Real & out) const {
+    out = 100.0*std::pow(x(1) - x(0)*x(0), 2.0) + std::pow(1 - x(0), 2.0);
+    return std::isfinite(out);
+  }
+
+  bool objective_gradient(Vector const & x, Vector & out) const {
+    out.resize(2);
+    out << -400.0*x(0)*(x(1)-x(0)*x(0)) - 2.0*(1 - x(0)), 200.0*(x(1) - x(0)*x(0));
+    return out.allFinite();
+  }
+
+  bool constraints(Vector const &, Vector & out) const {out.resize(0); return true;}
+
+  bool constraints_jacobian(Vector const &, SparseMatrix & out) const {out.resize(0,0); return true;}
+
+  bool lagrangian_hessian(Vector const & x, Vector const &, SparseMatrix & out) const {
+    out.resize(2,2);
+    std::vector<Eigen::Triplet<Real>> triplets{
+      {0, 0, 1200.0*x(0)*x(0) - 400.0*x(1) + 2},
+      {0, 1, -400.0*x(0)},
+      {1, 0, -400.0*x(0)},
+      {1, 1, 200}
+    };
+    out.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::Map<Vector> vec( out.valuePtr(), out.nonZeros() );
+    return vec.allFinite();
+  }
+
+  bool primal_lower_bounds(Vector & out) const {out.setConstant(2, -1.0); return true;}
+  bool primal_upper_bounds(Vector & out) const {out.setConstant(2, +1.0); return true;}
+  bool constraints_lower_bounds(Vector & out) const {out.resize(0); return true;}
+  bool constraints_upper_bounds(Vector & out) const {out.resize(0); return true;}
+};
+
+TEST(Test2, StaticProblem) {
+  static_assert(Pipal::IsProblem<Real, RosenbrockBox>::value);
+  Pipal::Solver<Real, RosenbrockBox> solver(std::make_unique<RosenbrockBox>());
+  solver.algorithm(Pipal::Algorithm::CONSERVATIVE);
+  solver.verbose_mode(VERBOSE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(2), x_guess(2), x_opt(2);
+  x_guess.setZero();
+  x_opt << 1.0, 1.0;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_EQ(solver.problem().name(), "test_rosenbrock_box");
+}
+
+TEST(Test3, Screening) {
+  Pipal::Solver<Real, RosenbrockBox> solver(std::make_unique<RosenbrockBox>());
+  solver.algorithm(Pipal::Algorithm::CONSERVATIVE);
+  solver.screening(true);
+  solver.verbose_mode(VERBOSE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(2), x_guess(2), x_opt(2);
+  x_guess.setZero();
+  x_opt << 1.0, 1.0;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+}
+
+class RosenbrockLazy : public Pipal::Problem<Real>
+{
+  Integer              m_n{10000};  // Number of candidate constraints
+  std::vector<Integer> m_working;  // Working set of candidate constraints
+
+  Real a(Integer k) const {return std::cos(2.0*M_PI*k/this->m_n);}
+  Real b(Integer k) const {return std::sin(2.0*M_PI*k/this->m_n);}
+
+public:
+  RosenbrockLazy() : Pipal::Problem<Real>("test_rosenbrock_lazy") {}
+
+  Integer working_set_size() const {return static_cast<Integer>(this->m_working.size());}
+
+  Real max_violation(Vector const & x) const {
+    Real out{0.0};
+    for (Integer k{0}; k < this->m_n; ++k) {out = std::max(out, this->a(k)*x(0) + this->b(k)*x(1) - 1.0);}
+    return out;
+  }
+
+  bool objective(Vector const & x, Real & out) const override {
+    out = 100.0*std::pow(x(1) - x(0)*x(0), 2.0) + std::pow(1 - x(0), 2.0);
+    return std::isfinite(out);
+  }
+
+  bool objective_gradient(Vector const & x, Vector & out) const override {
+    out.resize(2);
+    out << -400.0*x(0)*(x(1)-x(0)*x(0)) - 2.0*(1 - x(0)), 200.0*(x(1) - x(0)*x(0));
+    return out.allFinite();
+  }
+
+  bool constraints(Vector const & x, Vector & out) const override {
+    out.resize(this->working_set_size());
+    for (Integer k{0}; k < out.size(); ++k) {
+      out(k) = this->a(this->m_working[k])*x(0) + this->b(this->m_working[k])*x(1);
+    }
+    return out.allFinite();
+  }
+
+  bool constraints_jacobian(Vector const &, SparseMatrix & out) const override {
+    out.resize(this->working_set_size(), 2);
+    std::vector<Eigen::Triplet<Real>> triplets;
+    for (Integer k{0}; k < this->working_set_size(); ++k) {
+      triplets.emplace_back(k, 0, this->a(this->m_working[k]));
+      triplets.emplace_back(k, 1, this->b(this->m_working[k]));
+    }
+    out.setFromTriplets(triplets.begin(), triplets.end());
+    return true;
+  }
+
+  bool lagrangian_hessian(Vector const & x, Vector const &, SparseMatrix & out) const override {
+    out.resize(2,2);
+    std::vector<Eigen::Triplet<Real>> triplets{
+      {0, 0, 1200.0*x(0)*x(0) - 400.0*x(1) + 2},
+      {0, 1, -400.0*x(0)},
+      {1, 0, -400.0*x(0)},
+      {1, 1, 200}
+    };
+    out.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::Map<Vector> vec( out.valuePtr(), out.nonZeros() );
+    return vec.allFinite();
+  }
+
+  bool primal_lower_bounds(Vector & out) const override {
+    out.setConstant(2, -std::numeric_limits<Real>::infinity()); return true;
+  }
+  bool primal_upper_bounds(Vector & out) const override {
+    out.setConstant(2, +std::numeric_limits<Real>::infinity()); return true;
+  }
+  bool constraints_lower_bounds(Vector & out) const override {
+    out.setConstant(this->working_set_size(), -std::numeric_limits<Real>::infinity()); return true;
+  }
+  bool constraints_upper_bounds(Vector & out) const override {
+    out.setConstant(this->working_set_size(), 1.0); return true;
+  }
+
+  Integer separate(Vector const & x) override {
+    // Append the most violated candidate constraints
+    std::vector<std::pair<Real, Integer>> violated;
+    for (Integer k{0}; k < this->m_n; ++k) {
+      Real const viol{this->a(k)*x(0) + this->b(k)*x(1) - 1.0};
+      if (viol > SOLVER_TOLERANCE) {violated.emplace_back(viol, k);}
+    }
+    std::sort(violated.begin(), violated.end(), std::greater<>());
+    Integer const added{std::min<Integer>(5, static_cast<Integer>(violated.size()))};
+    for (Integer k{0}; k < added; ++k) {this->m_working.push_back(violated[k].second);}
+    return added;
+  }
+};
+
+TEST(Test4, LazyConstraints) {
+  static_assert(Pipal::HasSeparation<Real, Pipal::Problem<Real>>::value);
+  std::unique_ptr<RosenbrockLazy> problem(std::make_unique<RosenbrockLazy>());
+  RosenbrockLazy const & lazy{*problem};
+  Pipal::Solver<Real> solver(std::move(problem));
+  solver.algorithm(Pipal::Algorithm::CONSERVATIVE);
+  solver.verbose_mode(VERBOSE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(2), x_guess(2), x_opt(2);
+  x_guess.setZero();
+  x_opt << 0.7864, 0.6177;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_LE(lazy.max_violation(x_sol), APPROX_TOLERANCE);
+  EXPECT_LE(lazy.working_set_size(), 100);
+}
+
+class RosenbrockParametric : public Pipal::Problem<Real>
+{
+public:
+  Real a{1.0}; // Parameter of the problem
+
+  RosenbrockParametric() : Pipal::Problem<Real>("test_rosenbrock_parametric") {}
+
+  bool parameters(Vector & out) const override {out.resize(1); out << this->a; return true;}
+
+  bool objective(Vector const & x, Real & out) const override {
+    out = 100.0*std::pow(x(1) - x(0)*x(0), 2.0) + std::pow(this->a - x(0), 2.0);
+    return std::isfinite(out);
+  }
+
+  bool objective_gradient(Vector const & x, Vector & out) const override {
+    out.resize(2);
+    out << -400.0*x(0)*(x(1)-x(0)*x(0)) - 2.0*(this->a - x(0)), 200.0*(x(1) - x(0)*x(0));
+    return out.allFinite();
+  }
+
+  bool constraints(Vector const &, Vector & out) const override {out.resize(0); return true;}
+
+  bool constraints_jacobian(Vector const &, SparseMatrix & out) const override {out.resize(0,0); return true;}
+
+  bool lagrangian_hessian(Vector const & x, Vector const &, SparseMatrix & out) const override {
+    out.resize(2,2);
+    std::vector<Eigen::Triplet<Real>> triplets{
+      {0, 0, 1200.0*x(0)*x(0) - 400.0*x(1) + 2},
+      {0, 1, -400.0*x(0)},
+      {1, 0, -400.0*x(0)},
+      {1, 1, 200}
+    };
+    out.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::Map<Vector> vec( out.valuePtr(), out.nonZeros() );
+    return vec.allFinite();
+  }
+
+  bool primal_lower_bounds(Vector & out) const override {out.setConstant(2, -2.0); return true;}
+  bool primal_upper_bounds(Vector & out) const override {out.setConstant(2, +2.0); return true;}
+  bool constraints_lower_bounds(Vector & out) const override {out.resize(0); return true;}
+  bool constraints_upper_bounds(Vector & out) const override {out.resize(0); return true;}
+};
+
+TEST(Test5, SolutionCache) {
+  std::unique_ptr<RosenbrockParametric> problem(std::make_unique<RosenbrockParametric>());
+  RosenbrockParametric & parametric{*problem};
+  Pipal::Solver<Real> solver(std::move(problem));
+  solver.algorithm(Pipal::Algorithm::CONSERVATIVE);
+  solver.verbose_mode(VERBOSE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  solver.cache(std::make_shared<Pipal::SolutionCache<Real>>(16));
+  Vector x_sol(2), x_guess(2), x_opt(2), l_sol;
+  x_guess.setZero();
+
+  // Cold solve
+  x_opt << 1.0, 1.0;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  Integer const cold{solver.counter().k};
+  EXPECT_GT(cold, 0);
+  EXPECT_EQ(solver.cache()->size(), 1);
+
+  // Exact hit
+  x_sol.setZero();
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_EQ(solver.counter().k, 0);
+  solver.getSolution(x_sol, l_sol);
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+
+  // Near miss (warm started from the nearest cached solution)
+  parametric.a = 1.01;
+  x_opt << 1.01, 1.0201;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_LT(solver.counter().k, cold);
+  EXPECT_EQ(solver.cache()->size(), 2);
+
+  // Problems without parameters are only warm started from the cache
+  Pipal::Solver<Real, RosenbrockBox> plain(std::make_unique<RosenbrockBox>());
+  plain.algorithm(Pipal::Algorithm::CONSERVATIVE);
+  plain.verbose_mode(VERBOSE);
+  plain.tolerance(SOLVER_TOLERANCE);
+  plain.max_iterations(MAX_ITERATIONS);
+  plain.cache(std::make_shared<Pipal::SolutionCache<Real>>(16));
+  x_opt << 1.0, 1.0;
+  EXPECT_TRUE(plain.optimize(x_guess, x_sol));
+  Integer const plain_cold{plain.counter().k};
+  EXPECT_GT(plain_cold, 0);
+  EXPECT_TRUE(plain.optimize(x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_GT(plain.counter().f, 0);
+  EXPECT_LT(plain.counter().k, plain_cold);
+}
+
+TEST(Test6, Continuation) {
+  std::unique_ptr<RosenbrockParametric> problem(std::make_unique<RosenbrockParametric>());
+  RosenbrockParametric & parametric{*problem};
+  Pipal::Solver<Real> solver(std::move(problem));
+  solver.algorithm(Pipal::Algorithm::CONSERVATIVE);
+  solver.verbose_mode(false);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Pipal::Continuation<Real> continuation(solver, [&parametric] (Real const a) {parametric.a = a; return true;});
+  Vector x_sol(2), x_guess(2), x_opt(2);
+  x_guess.setZero();
+
+  // Reference solution, the bound on x1 becomes active at a = sqrt(2)
+  parametric.a = 1.6;
+  EXPECT_TRUE(solver.optimize(x_guess, x_opt));
+  EXPECT_NEAR(x_opt(1), 2.0, APPROX_TOLERANCE);
+
+  // Follow the path
+  std::vector<Real> path;
+  EXPECT_TRUE(continuation.run(1.0, 1.6, x_guess, x_sol,
+    [&path] (Real const a, Vector const &) {path.push_back(a);}));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_EQ(path.back(), 1.6);
+  EXPECT_EQ(continuation.steps() + 1, static_cast<Integer>(path.size()));
+  Integer const predicted{continuation.iterations()};
+
+  // Without the tangent predictor
+  continuation.predictor(false);
+  EXPECT_TRUE(continuation.run(1.0, 1.6, x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  Integer const previous{continuation.iterations()};
+
+  // Cold solves along the same path
+  Integer cold{0};
+  for (Real const a : path) {
+    parametric.a = a;
+    EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+    cold += solver.counter().k;
+  }
+  EXPECT_LE(predicted, previous);
+  EXPECT_LT(predicted, cold);
+}
+
+// Rosenbrock function subject to the infeasible constraints x0^2 + x1^2 <= 1 and x0 + x1 >= 3
+class RosenbrockInfeasible : public Pipal::Problem<Real>
+{
+public:
+  RosenbrockInfeasible() : Pipal::Problem<Real>("test_rosenbrock_infeasible") {}
+
+  bool objective(Vector const & x, Real & out) const override {
+    out = 100.0*std::pow(x(1) - x(0)*x(0), 2.0) + std::pow(1.0 - x(0), 2.0);
+    return std::isfinite(out);
+  }
+
+  bool objective_gradient(Vector const & x, Vector & out) const override {
+    out.resize(2);
+    out << -400.0*x(0)*(x(1)-x(0)*x(0)) - 2.0*(1.0 - x(0)), 200.0*(x(1) - x(0)*x(0));
+    return out.allFinite();
+  }
+
+  bool constraints(Vector const & x, Vector & out) const override {
+    out.resize(2);
+    out << x(0)*x(0) + x(1)*x(1), x(0) + x(1);
+    return out.allFinite();
+  }
+
+  bool constraints_jacobian(Vector const & x, SparseMatrix & out) const override {
+    out.resize(2, 2);
+    out.insert(0, 0) = 2.0*x(0); out.insert(0, 1) = 2.0*x(1);
+    out.insert(1, 0) = 1.0;      out.insert(1, 1) = 1.0;
+    return true;
+  }
+
+  bool lagrangian_hessian(Vector const & x, Vector const & l, SparseMatrix & out) const override {
+    out.resize(2,2);
+    std::vector<Eigen::Triplet<Real>> triplets{
+      {0, 0, 1200.0*x(0)*x(0) - 400.0*x(1) + 2 + 2.0*l(0)},
+      {0, 1, -400.0*x(0)},
+      {1, 0, -400.0*x(0)},
+      {1, 1, 200 + 2.0*l(0)}
+    };
+    out.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::Map<Vector> vec( out.valuePtr(), out.nonZeros() );
+    return vec.allFinite();
+  }
+
+  bool primal_lower_bounds(Vector & out) const override {out.setConstant(2, -1.0e20); return true;}
+  bool primal_upper_bounds(Vector & out) const override {out.setConstant(2, +1.0e20); return true;}
+  bool constraints_lower_bounds(Vector & out) const override {out.resize(2); out << -1.0e20, 3.0; return true;}
+  bool constraints_upper_bounds(Vector & out) const override {out.resize(2); out << 1.0, 1.0e20; return true;}
+};
+
+TEST(Test7, Infeasibility) {
+  Vector x_sol(2), x_guess(2), l_sol;
+  x_guess << 0.5, -0.3;
+
+  // Plain solve (runs until the feasibility problem is solved to the optimality tolerance)
+  Pipal::Solver<Real> plain(std::make_unique<RosenbrockInfeasible>());
+  plain.verbose_mode(VERBOSE);
+  plain.tolerance(SOLVER_TOLERANCE);
+  plain.max_iterations(MAX_ITERATIONS);
+  plain.optimize(x_guess, x_sol);
+  Integer const k_plain{plain.counter().k};
+
+  // Early infeasibility detection
+  Pipal::Solver<Real> early(std::make_unique<RosenbrockInfeasible>());
+  early.verbose_mode(VERBOSE);
+  early.tolerance(SOLVER_TOLERANCE);
+  early.max_iterations(MAX_ITERATIONS);
+  early.infeasibility(true);
+  early.optimize(x_guess, x_sol);
+  EXPECT_TRUE(early.infeasible());
+  EXPECT_FALSE(early.converged());
+  EXPECT_LT(early.counter().k, k_plain);
+
+  // The certificate is the point of the disk closest to the half-plane
+  early.getSolution(x_sol, l_sol);
+  EXPECT_NEAR(x_sol(0), std::sqrt(0.5), APPROX_TOLERANCE);
+  EXPECT_NEAR(x_sol(1), std::sqrt(0.5), APPROX_TOLERANCE);
+
+  // At the default tolerance, the detection still saves iterations and factorizations
+  Pipal::Solver<Real> loose(std::make_unique<RosenbrockInfeasible>());
+  loose.verbose_mode(VERBOSE);
+  loose.max_iterations(MAX_ITERATIONS);
+  loose.optimize(x_guess, x_sol);
+  Pipal::Solver<Real> loose_early(std::make_unique<RosenbrockInfeasible>());
+  loose_early.verbose_mode(VERBOSE);
+  loose_early.max_iterations(MAX_ITERATIONS);
+  loose_early.infeasibility(true);
+  loose_early.optimize(x_guess, x_sol);
+  EXPECT_TRUE(loose.infeasible());
+  EXPECT_TRUE(loose_early.infeasible());
+  EXPECT_LT(loose_early.counter().k, loose.counter().k);
+  EXPECT_LT(loose_early.counter().M, loose.counter().M);
+  EXPECT_NEAR(x_sol(0), std::sqrt(0.5), 1.0e-2);
+  EXPECT_NEAR(x_sol(1), std::sqrt(0.5), 1.0e-2);
+}
+
+// Problem -log(x0) + 5 x0 + (x1 - 1)^2 subject to x0 + x1 <= 3, whose objective is undefined for x0 <= 0
+class RosenbrockDomain : public Pipal::Problem<Real>
+{
+public:
+  mutable Integer rejected{0};
+
+  RosenbrockDomain() : Pipal::Problem<Real>("test_rosenbrock_domain") {}
+
+  bool objective(Vector const & x, Real & out) const override {
+    if (x(0) <= 0.0) {++this->rejected; return false;}
+    out = -std::log(x(0)) + 5.0*x(0) + std::pow(x(1) - 1.0, 2.0);
+    return true;
+  }
+
+  bool objective_gradient(Vector const & x, Vector & out) const override {
+    out.resize(2);
+    out << -1.0/x(0) + 5.0, 2.0*(x(1) - 1.0);
+    return out.allFinite();
+  }
+
+  bool constraints(Vector const & x, Vector & out) const override {
+    out.resize(1);
+    out << x(0) + x(1);
+    return out.allFinite();
+  }
+
+  bool constraints_jacobian(Vector const &, SparseMatrix & out) const override {
+    out.resize(1, 2);
+    out.insert(0, 0) = 1.0; out.insert(0, 1) = 1.0;
+    return true;
+  }
+
+  bool lagrangian_hessian(Vector const & x, Vector const &, SparseMatrix & out) const override {
+    out.resize(2, 2);
+    out.insert(0, 0) = 1.0/(x(0)*x(0)); out.insert(1, 1) = 2.0;
+    return std::isfinite(out.coeff(0, 0));
+  }
+
+  bool primal_lower_bounds(Vector & out) const override {out.setConstant(2, -1.0e20); return true;}
+  bool primal_upper_bounds(Vector & out) const override {out.setConstant(2, +1.0e20); return true;}
+  bool constraints_lower_bounds(Vector & out) const override {out.setConstant(1, -1.0e20); return true;}
+  bool constraints_upper_bounds(Vector & out) const override {out.setConstant(1, 3.0); return true;}
+};
+
+TEST(Test8, DomainError) {
+  auto problem{std::make_unique<RosenbrockDomain>()};
+  RosenbrockDomain const & domain{*problem};
+  Pipal::Solver<Real> solver(std::move(problem));
+  solver.verbose_mode(VERBOSE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(2), x_guess(2);
+  x_guess << 1.0, 0.0;
+
+  // The trial points out of the domain are rejected by the line search without exceptions
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(solver.converged());
+  EXPECT_GT(domain.rejected, 0);
+  EXPECT_NEAR(x_sol(0), 0.2, APPROX_TOLERANCE);
+  EXPECT_NEAR(x_sol(1), 1.0, APPROX_TOLERANCE);
+}
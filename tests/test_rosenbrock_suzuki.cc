@@ -9,8 +9,16 @@
 \* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 // STL includes
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <limits>
+#include <thread>
+#include <vector>
 
 // GTest library
 #include <gtest/gtest.h>
@@ -29,8 +37,8 @@ constexpr Real    SOLVER_TOLERANCE{1.0e-10};
 constexpr Real    APPROX_TOLERANCE{1.0e-3};
 constexpr Integer MAX_ITERATIONS{100};
 
-TEST(Test1, ProblemWrapper) {
-  Pipal::Solver<Real> solver("test_rosenbrock_suzuki",
+static std::unique_ptr<Pipal::Problem<Real>> rosenbrock_suzuki() {
+  return std::make_unique<Pipal::ProblemWrapper<Real>>("test_rosenbrock_suzuki",
     [] (Vector const & x, Real & out) { // Objective function
       out = x(0)*x(0) + x(1)*x(1) + 2.0*x(2)*x(2) + x(3)*x(3) - 5.0*x(0) - 5.0*x(1) - 21.0*x(2) + 7.0*x(3);
       return std::isfinite(out);
@@ -93,7 +101,25 @@ TEST(Test1, ProblemWrapper) {
     [] (Vector & out) {out.setConstant(4, -INFINITY); out(3) = 0.0; return true;}, // Lower bounds on the constraints
     [] (Vector & out) {out.setConstant(4, 0.0); return true;}  // Upper bounds on the constraints
   );
+}
+
+TEST(Test1, ProblemWrapper) {
+  Pipal::Solver<Real> solver(rosenbrock_suzuki());
+  solver.algorithm(Pipal::Algorithm::ADAPTIVE);
+  solver.verbose_mode(VERBOSE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(4), x_guess(4), x_opt(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+  x_opt << 0.287054, 1.44787, 2.16978, 1.09530;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+}
+
+TEST(Test2, Equilibration) {
+  Pipal::Solver<Real> solver(rosenbrock_suzuki());
   solver.algorithm(Pipal::Algorithm::ADAPTIVE);
+  solver.equilibration(true);
   solver.verbose_mode(VERBOSE);
   solver.tolerance(SOLVER_TOLERANCE);
   solver.max_iterations(MAX_ITERATIONS);
@@ -103,3 +129,471 @@ TEST(Test1, ProblemWrapper) {
   EXPECT_TRUE(solver.optimize(x_guess, x_sol));
   EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
 }
+
+TEST(Test3, Metrics) {
+  Pipal::Metrics & metrics{Pipal::Metrics::instance()};
+  metrics.reset();
+  Pipal::Solver<Real> solver(rosenbrock_suzuki());
+  solver.algorithm(Pipal::Algorithm::ADAPTIVE);
+  solver.metrics(true);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(4), x_guess(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+  for (Integer k{0}; k < 3; ++k) {EXPECT_TRUE(solver.optimize(x_guess, x_sol));}
+  EXPECT_EQ(metrics.solves(), 3u);
+  EXPECT_EQ(metrics.status(1), 3u);
+  EXPECT_GT(metrics.iterations().percentile(0.50), 0.0);
+  EXPECT_LE(metrics.iterations().percentile(0.50), metrics.iterations().percentile(0.99));
+  std::ostringstream prometheus, json;
+  metrics.write(prometheus, Pipal::Metrics::Format::PROMETHEUS);
+  metrics.write(json, Pipal::Metrics::Format::JSON);
+  EXPECT_NE(prometheus.str().find("pipal_solves_total 3"), std::string::npos);
+  EXPECT_NE(json.str().find("\"solves\": 3"), std::string::npos);
+  std::filesystem::path const dir{std::filesystem::path(testing::TempDir()) / "pipal_metrics"};
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  std::string const path{(dir / "metrics.json").string()};
+  std::atomic<Integer> exported{0};
+  std::vector<std::thread> threads;
+  for (Integer k{0}; k < 4; ++k) {
+    threads.emplace_back([&metrics, &path, &exported] () {
+      for (Integer n{0}; n < 25; ++n) {
+        if (metrics.exportToFile(path, Pipal::Metrics::Format::JSON)) {++exported;}
+      }
+    });
+  }
+  for (std::thread & t : threads) {t.join();}
+  EXPECT_EQ(exported.load(), 100);
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator()), 1);
+  std::ifstream file(path);
+  std::string const content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  EXPECT_EQ(content, json.str());
+  std::filesystem::remove_all(dir);
+}
+
+TEST(Test4, Threads) {
+  Pipal::ThreadPool pool(4);
+  SparseMatrix J(300, 200);
+  for (Integer k{0}; k < 3000; ++k) {J.coeffRef((37*k) % 300, (11*k + k/7) % 200) += std::sin(Real(k));}
+  J.makeCompressed();
+  Pipal::SparseMatrixRow<Real> Jr(J);
+  Vector x(Vector::LinSpaced(200, -1.0, 1.0)), l(Vector::LinSpaced(300, 1.0, 2.0)), y;
+  Pipal::outer_product<Real>(&pool, Jr, x, y);
+  EXPECT_TRUE(y.isApprox(J*x));
+  Pipal::outer_product<Real>(&pool, J, l, y);
+  EXPECT_TRUE(y.isApprox(J.transpose()*l));
+
+  SparseMatrix A(400, 400);
+  for (Integer k{0}; k < 400; ++k) {
+    A.coeffRef(k, k) = (k % 3 == 0 ? -4.0 : 4.0);
+    if (k+1 < 400) {A.coeffRef(k+1, k) = 1.0;}
+    if (k+20 < 400) {A.coeffRef(k+20, k) = -1.0;}
+  }
+  A.makeCompressed();
+  Pipal::SparseLDLT<Real> serial_ldlt, parallel_ldlt;
+  parallel_ldlt.pool(&pool);
+  serial_ldlt.compute(A);
+  parallel_ldlt.compute(A);
+  Vector b(Vector::Ones(400));
+  EXPECT_EQ(serial_ldlt.vectorD(), parallel_ldlt.vectorD());
+  EXPECT_TRUE((SparseMatrix(A.selfadjointView<Eigen::Lower>())*parallel_ldlt.solve(b)).isApprox(b));
+
+  Vector x_guess(4), x_ser(4), x_par(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+  Pipal::Solver<Real> serial(rosenbrock_suzuki()), parallel(rosenbrock_suzuki());
+  parallel.threads(4, true);
+  for (Pipal::Solver<Real> * solver : {&serial, &parallel}) {
+    solver->algorithm(Pipal::Algorithm::ADAPTIVE);
+    solver->tolerance(SOLVER_TOLERANCE);
+    solver->max_iterations(MAX_ITERATIONS);
+  }
+  EXPECT_TRUE(serial.optimize(x_guess, x_ser));
+  EXPECT_TRUE(parallel.optimize(x_guess, x_par));
+  EXPECT_EQ(x_ser, x_par);
+
+  // Jacobian large enough for the multithreaded products (row-major copy refilled in place), with
+  // a small entry moving between two positions at each evaluation (same non-zeros, other pattern)
+  Integer const nV{200}, nI{60};
+  auto dense = [nV, nI] (bool const swap) {
+    return std::make_unique<Pipal::ProblemWrapper<Real>>("test_dense_jacobian",
+      [] (Vector const & x, Real & out) {out = 0.5*(x.array() - 1.0).square().sum(); return true;},
+      [] (Vector const & x, Vector & out) {out = x.array() - 1.0; return true;},
+      [nV, nI, swap] (Vector const & x, Vector & out) {
+        out.resize(nI);
+        for (Integer j{0}; j < nI; ++j) {
+          out(j) = 0.1*x(j)*x(j);
+          for (Integer k{0}; k < nV; ++k) {out(j) += std::sin(Real(j+k))*x(k);}
+        }
+        if (swap) {out(0) -= 0.1*x(0)*x(0) + std::sin(1.0)*x(1);}
+        return true;
+      },
+      [nV, nI, swap, odd = false] (Vector const & x, SparseMatrix & out) mutable {
+        Matrix J(nI, nV);
+        for (Integer j{0}; j < nI; ++j) {
+          for (Integer k{0}; k < nV; ++k) {J(j, k) = std::sin(Real(j+k));}
+          J(j, j) += 0.2*x(j);
+        }
+        if (swap) {J(0, 0) = J(0, 1) = 0.0;}
+        out = J.sparseView(0.0, 0.0);
+        if (swap) {out.coeffRef(0, odd ? 1 : 0) = 1.0e-3; odd = !odd;}
+        return true;
+      },
+      [nV, nI] (Vector const &, Vector const & z, SparseMatrix & out) {
+        Vector d(Vector::Ones(nV));
+        d.head(nI) += 0.2*z;
+        out = SparseMatrix(d.asDiagonal());
+        return true;
+      },
+      [nV] (Vector & out) {out.setConstant(nV, -INFINITY); return true;},
+      [nV] (Vector & out) {out.setConstant(nV, INFINITY); return true;},
+      [nI] (Vector & out) {out.setConstant(nI, -INFINITY); return true;},
+      [nI] (Vector & out) {out.setConstant(nI, 1.0); return true;}
+    );
+  };
+  Pipal::Solver<Real> dense_serial(dense(false)), dense_parallel(dense(false));
+  Pipal::Solver<Real> swap_serial(dense(true)), swap_parallel(dense(true));
+  dense_parallel.threads(4, true);
+  swap_parallel.threads(4, true);
+  for (Pipal::Solver<Real> * solver : {&dense_serial, &dense_parallel, &swap_serial, &swap_parallel}) {
+    solver->algorithm(Pipal::Algorithm::ADAPTIVE);
+    solver->tolerance(SOLVER_TOLERANCE);
+    solver->max_iterations(MAX_ITERATIONS);
+  }
+  Vector y_guess(Vector::Zero(nV)), y_ser, y_par;
+  EXPECT_TRUE(dense_serial.optimize(y_guess, y_ser));
+  EXPECT_TRUE(dense_parallel.optimize(y_guess, y_par));
+  EXPECT_TRUE(y_ser.isApprox(y_par, APPROX_TOLERANCE));
+  Pipal::Iterate<Real> const & z{dense_parallel.iterate()};
+  EXPECT_GE(z.JI.nonZeros(), Pipal::Parameter<Real>::par_nnz_min);
+  EXPECT_EQ(Matrix(z.JIr), Matrix(z.JI));
+  EXPECT_EQ(dense_serial.iterate().JIr.nonZeros(), 0);
+  for (Integer k{0}; k < 2; ++k) {
+    EXPECT_TRUE(swap_serial.optimize(y_guess, y_ser));
+    EXPECT_TRUE(swap_parallel.optimize(y_guess, y_par));
+    EXPECT_TRUE(y_ser.isApprox(y_par, APPROX_TOLERANCE));
+    EXPECT_EQ(Matrix(swap_parallel.iterate().JIr), Matrix(swap_parallel.iterate().JI));
+  }
+}
+
+TEST(Test5, SymbolicCache) {
+  std::filesystem::path const directory{std::filesystem::path(::testing::TempDir()) / "pipal_symbolic"};
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  Vector x_guess(4), x_first(4), x_second(4), x_third(4), x_plain(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+  Pipal::Solver<Real> first(rosenbrock_suzuki()), second(rosenbrock_suzuki()), third(rosenbrock_suzuki());
+  Pipal::Solver<Real> plain(rosenbrock_suzuki());
+  for (Pipal::Solver<Real> * solver : {&first, &second, &third, &plain}) {
+    if (solver != &plain) {solver->symbolic_cache(directory.string());}
+    solver->algorithm(Pipal::Algorithm::ADAPTIVE);
+    solver->tolerance(SOLVER_TOLERANCE);
+    solver->max_iterations(MAX_ITERATIONS);
+  }
+  EXPECT_TRUE(plain.optimize(x_guess, x_plain));
+
+  // The first solve writes the cache file
+  EXPECT_TRUE(first.optimize(x_guess, x_first));
+  EXPECT_EQ(x_first, x_plain);
+  std::filesystem::directory_iterator files(directory);
+  ASSERT_NE(files, std::filesystem::directory_iterator());
+  std::filesystem::path const file{files->path()};
+  EXPECT_EQ(++files, std::filesystem::directory_iterator());
+  std::uintmax_t const size{std::filesystem::file_size(file)};
+  std::filesystem::file_time_type const stamp{std::filesystem::last_write_time(file) - std::chrono::hours(1)};
+  std::filesystem::last_write_time(file, stamp);
+
+  // The second solve loads it (a failed load would rewrite it)
+  EXPECT_TRUE(second.optimize(x_guess, x_second));
+  EXPECT_EQ(x_second, x_plain);
+  EXPECT_EQ(std::filesystem::last_write_time(file), stamp);
+
+  // A truncated file is rejected and rewritten
+  std::filesystem::resize_file(file, size/2);
+  EXPECT_TRUE(third.optimize(x_guess, x_third));
+  EXPECT_EQ(x_third, x_plain);
+  EXPECT_EQ(std::filesystem::file_size(file), size);
+  std::filesystem::remove_all(directory);
+}
+
+TEST(Test6, Polish) {
+  Pipal::Solver<Real> solver(rosenbrock_suzuki()), plain(rosenbrock_suzuki());
+  for (Pipal::Solver<Real> * s : {&solver, &plain}) {
+    s->algorithm(Pipal::Algorithm::ADAPTIVE);
+    s->tolerance(SOLVER_TOLERANCE);
+    s->max_iterations(MAX_ITERATIONS);
+  }
+  solver.polish(true);
+  solver.verbose_mode(VERBOSE);
+  Vector x_sol(4), x_plain(4), x_guess(4), x_opt(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+  x_opt << 0.287054, 1.44787, 2.16978, 1.09530;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(plain.optimize(x_guess, x_plain));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_TRUE(x_sol.isApprox(x_plain, 1.0e-8));
+  EXPECT_LT(solver.counter().k, plain.counter().k);
+  EXPECT_LE(solver.iterate().kkt(1), SOLVER_TOLERANCE);
+}
+
+TEST(Test7, Progress) {
+  Pipal::Solver<Real> solver(rosenbrock_suzuki());
+  solver.algorithm(Pipal::Algorithm::ADAPTIVE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  Vector x_sol(4), x_guess(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+
+  std::atomic<bool> done{false};
+  bool monotone{true};
+  std::thread monitor([&solver, &done, &monotone] () {
+    Integer last{0};
+    while (!done.load()) {
+      Pipal::Progress<Real> const progress{solver.progress()};
+      if (progress.running && progress.k < last) {monotone = false;}
+      if (progress.running) {last = progress.k;}
+      std::this_thread::yield();
+    }
+  });
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  done.store(true);
+  monitor.join();
+
+  Pipal::Progress<Real> const progress{solver.progress()};
+  EXPECT_TRUE(monotone);
+  EXPECT_FALSE(progress.running);
+  EXPECT_EQ(progress.k, solver.counter().k);
+  EXPECT_EQ(progress.f_count, solver.counter().f);
+  EXPECT_LE(progress.kkt[1], SOLVER_TOLERANCE);
+}
+
+TEST(Test8, Snapshot) {
+  std::string const directory{::testing::TempDir()};
+  Pipal::Solver<Real> solver(rosenbrock_suzuki());
+  solver.algorithm(Pipal::Algorithm::ADAPTIVE);
+  solver.tolerance(SOLVER_TOLERANCE);
+  solver.max_iterations(MAX_ITERATIONS);
+  solver.snapshot(directory, 10);
+  Vector x_sol(4), x_guess(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+
+  auto read = [] (std::string const & path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  };
+  std::string const first{directory + "/pipal_snapshot_10.bin"}, second{directory + "/pipal_snapshot_copy.bin"};
+  EXPECT_FALSE(read(directory + "/pipal_snapshot_0.bin").empty());
+  EXPECT_FALSE(read(first).empty());
+
+  Pipal::Solver<Real> bench;
+  EXPECT_FALSE(bench.load_snapshot(directory + "/pipal_snapshot_missing.bin"));
+  EXPECT_THROW(bench.run_kernel(Pipal::Kernel::NEWTON_STEP), std::runtime_error);
+  ASSERT_TRUE(bench.load_snapshot(first));
+  ASSERT_TRUE(bench.save_snapshot(second));
+  EXPECT_EQ(read(first), read(second));
+  Integer const factorizations{bench.counter().M};
+  for (Pipal::Kernel kernel : {Pipal::Kernel::NEWTON_MATRIX, Pipal::Kernel::NEWTON_STEP, Pipal::Kernel::MODELS,
+    Pipal::Kernel::FRACTION_TO_BOUNDARY, Pipal::Kernel::KKT_ERRORS, Pipal::Kernel::SLACKS}) {
+    EXPECT_NO_THROW(bench.run_kernel(kernel));
+  }
+  EXPECT_GT(bench.counter().M, factorizations);
+
+  // Snapshots with fields inconsistent with the problem sizes are rejected
+  std::string const name{"test_rosenbrock_suzuki"}, corrupted{directory + "/pipal_snapshot_corrupted.bin"};
+  std::size_t const position{read(first).find(name)};
+  ASSERT_NE(position, std::string::npos);
+  std::size_t const I1{position + name.size()};
+  for (Integer value : {99, -1}) {
+    std::string bytes{read(first)};
+    std::memcpy(bytes.data() + I1 + sizeof(std::uint64_t), &value, sizeof(Integer));
+    std::ofstream(corrupted, std::ios::binary) << bytes;
+    EXPECT_FALSE(bench.load_snapshot(corrupted));
+  }
+  std::string truncated{read(first)};
+  truncated.resize(truncated.size()/2);
+  std::ofstream(corrupted, std::ios::binary) << truncated;
+  EXPECT_FALSE(bench.load_snapshot(corrupted));
+  std::remove(corrupted.c_str());
+
+  // Repeated runs of a kernel start from the same state (also with shifted Hessians)
+  for (Integer k{0}; bench.load_snapshot(directory + "/pipal_snapshot_" + std::to_string(k) + ".bin"); k += 10) {
+    SparseMatrix const H(bench.iterate().H);
+    Real const shift{bench.iterate().shift};
+    bench.run_kernel(Pipal::Kernel::NEWTON_MATRIX);
+    Vector const D(bench.iterate().ldlt.vectorD());
+    bench.run_kernel(Pipal::Kernel::NEWTON_MATRIX);
+    EXPECT_EQ(bench.iterate().ldlt.vectorD(), D);
+    EXPECT_EQ(bench.iterate().shift, shift);
+    EXPECT_TRUE(bench.iterate().H.isApprox(H, 0.0));
+  }
+}
+
+TEST(Test9, Pruning) {
+  Pipal::Solver<Real> solver(rosenbrock_suzuki()), plain(rosenbrock_suzuki());
+  for (Pipal::Solver<Real> * s : {&solver, &plain}) {
+    s->algorithm(Pipal::Algorithm::ADAPTIVE);
+    s->tolerance(SOLVER_TOLERANCE);
+    s->max_iterations(MAX_ITERATIONS);
+  }
+  solver.pruning(true);
+  solver.verbose_mode(VERBOSE);
+  Vector x_sol(4), x_plain(4), x_guess(4), x_opt(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+  x_opt << 0.287054, 1.44787, 2.16978, 1.09530;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(plain.optimize(x_guess, x_plain));
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_GT(solver.counter().T, 0);
+  EXPECT_LT(solver.counter().T, plain.counter().T);
+}
+
+// Rosenbrock-Suzuki problem in the variables w = D x, with magnitudes ranging over nine orders
+static std::unique_ptr<Pipal::Problem<Real>> rosenbrock_suzuki_badly_scaled(Vector const & D) {
+  auto problem{std::shared_ptr<Pipal::Problem<Real>>(rosenbrock_suzuki())};
+  return std::make_unique<Pipal::ProblemWrapper<Real>>("test_rosenbrock_suzuki_badly_scaled",
+    [problem, D] (Vector const & w, Real & out) {return problem->objective(w.cwiseQuotient(D), out);},
+    [problem, D] (Vector const & w, Vector & out) {
+      bool const ok{problem->objective_gradient(w.cwiseQuotient(D), out)};
+      out = out.cwiseQuotient(D);
+      return ok;
+    },
+    [problem, D] (Vector const & w, Vector & out) {return problem->constraints(w.cwiseQuotient(D), out);},
+    [problem, D] (Vector const & w, SparseMatrix & out) {
+      bool const ok{problem->constraints_jacobian(w.cwiseQuotient(D), out)};
+      out = out * D.cwiseInverse().asDiagonal();
+      return ok;
+    },
+    [problem, D] (Vector const & w, Vector const & z, SparseMatrix & out) {
+      bool const ok{problem->lagrangian_hessian(w.cwiseQuotient(D), z, out)};
+      out = D.cwiseInverse().asDiagonal() * out * D.cwiseInverse().asDiagonal();
+      return ok;
+    },
+    [problem, D] (Vector & out) {bool const ok{problem->primal_lower_bounds(out)}; out = out.cwiseProduct(D); return ok;},
+    [problem, D] (Vector & out) {bool const ok{problem->primal_upper_bounds(out)}; out = out.cwiseProduct(D); return ok;},
+    [problem] (Vector & out) {return problem->constraints_lower_bounds(out);},
+    [problem] (Vector & out) {return problem->constraints_upper_bounds(out);}
+  );
+}
+
+TEST(Test10, VariableScaling) {
+  Vector D(4), x_far(4), x_near(4), x_opt(4);
+  D << 1.0e+06, 1.0, 1.0e-03, 1.0;
+  x_far << -4000.0, 1.0, 1.0, 1.0;
+  x_near << 1.0, 1.0, 1.0, 1.0;
+  x_opt << 0.287054, 1.44787, 2.16978, 1.09530;
+  Pipal::Solver<Real> nominal(rosenbrock_suzuki_badly_scaled(D)), automatic(rosenbrock_suzuki_badly_scaled(D));
+  for (Pipal::Solver<Real> * s : {&nominal, &automatic}) {
+    s->algorithm(Pipal::Algorithm::ADAPTIVE);
+    s->tolerance(SOLVER_TOLERANCE);
+    s->max_iterations(MAX_ITERATIONS);
+  }
+  nominal.nominal(D);
+  nominal.verbose_mode(VERBOSE);
+  automatic.scaling(Pipal::Scaling::AUTOMATIC);
+  Vector w_nominal(4), w_automatic(4);
+  EXPECT_TRUE(nominal.optimize(x_far.cwiseProduct(D), w_nominal));
+  EXPECT_TRUE(w_nominal.cwiseQuotient(D).isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_TRUE(automatic.optimize(x_near.cwiseProduct(D), w_automatic));
+  EXPECT_TRUE(w_automatic.cwiseQuotient(D).isApprox(x_opt, APPROX_TOLERANCE));
+}
+
+TEST(Test11, PredictorCorrector) {
+  Pipal::Solver<Real> solver(rosenbrock_suzuki()), plain(rosenbrock_suzuki());
+  for (Pipal::Solver<Real> * s : {&solver, &plain}) {
+    s->algorithm(Pipal::Algorithm::CONSERVATIVE);
+    s->tolerance(SOLVER_TOLERANCE);
+    s->max_iterations(MAX_ITERATIONS);
+  }
+  solver.predictor_corrector(true);
+  solver.verbose_mode(VERBOSE);
+  Vector x_sol(4), x_plain(4), x_guess(4), x_opt(4);
+  x_guess << 1.0, 1.0, 1.0, 1.0;
+  x_opt << 0.287054, 1.44787, 2.16978, 1.09530;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(plain.optimize(x_guess, x_plain));
+  EXPECT_TRUE(solver.converged());
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_LT(solver.counter().k, plain.counter().k);
+}
+
+TEST(Test12, CentralityCorrectors) {
+  Pipal::Solver<Real> solver(rosenbrock_suzuki()), plain(rosenbrock_suzuki());
+  for (Pipal::Solver<Real> * s : {&solver, &plain}) {
+    s->algorithm(Pipal::Algorithm::CONSERVATIVE);
+    s->predictor_corrector(true);
+    s->tolerance(SOLVER_TOLERANCE);
+    s->max_iterations(MAX_ITERATIONS);
+  }
+  solver.correctors(4);
+  solver.verbose_mode(VERBOSE);
+  Vector x_sol(4), x_plain(4), x_guess(4), x_opt(4);
+  x_guess << 1.0, 1.0, 1.0, 1.0;
+  x_opt << 0.287054, 1.44787, 2.16978, 1.09530;
+  EXPECT_TRUE(solver.optimize(x_guess, x_sol));
+  EXPECT_TRUE(plain.optimize(x_guess, x_plain));
+  EXPECT_TRUE(solver.converged());
+  EXPECT_TRUE(x_sol.isApprox(x_opt, APPROX_TOLERANCE));
+  EXPECT_GT(solver.counter().C, 0);
+  EXPECT_EQ(plain.counter().C, 0);
+  EXPECT_LE(solver.counter().M, plain.counter().M);
+}
+
+TEST(Test13, Executor) {
+  // Nested and concurrent batches on a shared work-stealing pool
+  auto pool{std::make_shared<Pipal::WorkStealingPool>(4)};
+  EXPECT_EQ(pool->size(), 4);
+  std::atomic<Integer> count{0};
+  std::vector<std::thread> callers;
+  for (Integer t{0}; t < 3; ++t) {
+    callers.emplace_back([&pool, &count] () {
+      for (Integer r{0}; r < 20; ++r) {
+        pool->run(8, [&pool, &count] (Integer) {pool->run(16, [&count] (Integer) {++count;});});
+      }
+    });
+  }
+  for (std::thread & t : callers) {t.join();}
+  EXPECT_EQ(count.load(), 3*20*8*16);
+
+  // Parallel kernels match the serial ones
+  SparseMatrix J(300, 200);
+  for (Integer k{0}; k < 3000; ++k) {J.coeffRef((37*k) % 300, (11*k + k/7) % 200) += std::sin(Real(k));}
+  J.makeCompressed();
+  Vector x(Vector::LinSpaced(200, -1.0, 1.0)), y;
+  Pipal::outer_product<Real>(pool.get(), Pipal::SparseMatrixRow<Real>(J), x, y);
+  EXPECT_TRUE(y.isApprox(J*x));
+
+  // Solvers running concurrently on the same executor
+  Vector x_guess(4), x_ser(4);
+  x_guess << -4000.0, 1.0, 1.0, 1.0;
+  Pipal::Solver<Real> serial(rosenbrock_suzuki());
+  serial.tolerance(SOLVER_TOLERANCE);
+  serial.max_iterations(MAX_ITERATIONS);
+  EXPECT_TRUE(serial.optimize(x_guess, x_ser));
+  std::vector<Vector> x_par(3, Vector(4));
+  std::vector<Integer> ok(3, 0);
+  callers.clear();
+  for (Integer t{0}; t < 3; ++t) {
+    callers.emplace_back([&pool, &x_guess, &x_par, &ok, t] () {
+      Pipal::Solver<Real> solver(rosenbrock_suzuki());
+      solver.executor(pool);
+      solver.tolerance(SOLVER_TOLERANCE);
+      solver.max_iterations(MAX_ITERATIONS);
+      ok[t] = solver.optimize(x_guess, x_par[t]) && solver.threads() == 4;
+    });
+  }
+  for (std::thread & t : callers) {t.join();}
+  for (Integer t{0}; t < 3; ++t) {
+    EXPECT_TRUE(ok[t]);
+    EXPECT_EQ(x_par[t], x_ser);
+  }
+
+  // The number of threads bounds the tasks on the shared pool, private pools are opt-in
+  Pipal::Solver<Real> shared(rosenbrock_suzuki()), owned(rosenbrock_suzuki());
+  shared.threads(4);
+  owned.threads(4, true);
+  EXPECT_NE(dynamic_cast<Pipal::LimitedExecutor *>(shared.executor().get()), nullptr);
+  EXPECT_EQ(shared.executor()->size(), std::min<Integer>(4, Pipal::WorkStealingPool::shared()->size()));
+  EXPECT_NE(dynamic_cast<Pipal::WorkStealingPool *>(owned.executor().get()), nullptr);
+  EXPECT_EQ(owned.executor()->size(), 4);
+}